@@ -1,7 +1,8 @@
 # MIT License
 # Copyright (c) 2024 Szabolcs Dombi
 
-from typing import Any, Dict, Iterable, List, Literal, Protocol, Tuple, TypedDict
+import os
+from typing import Any, Dict, Iterable, List, Literal, Protocol, Sequence, Tuple, TypedDict
 
 # --- Enums and Literals ---
 
@@ -92,8 +93,9 @@ VertexFormat = Literal[
 """Explicit vertex attribute formats."""
 
 ImageFormat = Literal[
-    'r8unorm', 'rg8unorm', 'rgba8unorm',
+    'r8unorm', 'rg8unorm', 'rgba8unorm', 'rgba8unorm-srgb',
     'r8snorm', 'rg8snorm', 'rgba8snorm',
+    'r16snorm', 'rg16snorm', 'rgba16snorm',
     'r8uint', 'rg8uint', 'rgba8uint',
     'r16uint', 'rg16uint', 'rgba16uint',
     'r32uint', 'rg32uint', 'rgba32uint',
@@ -103,8 +105,18 @@ ImageFormat = Literal[
     'r16float', 'rg16float', 'rgba16float',
     'r32float', 'rg32float', 'rgba32float',
     'depth16unorm', 'depth24plus', 'depth24plus-stencil8', 'depth32float',
+    'rgb10a2unorm', 'rg11b10ufloat', 'r11g11b10f', 'rgb9e5ufloat', 'rgb9e5',
+    'bc1-rgba-unorm', 'bc1-rgba-unorm-srgb', 'bc2-rgba-unorm', 'bc2-rgba-unorm-srgb',
+    'bc3-rgba-unorm', 'bc3-rgba-unorm-srgb', 'bc4-r-unorm', 'bc4-r-snorm',
+    'bc5-rg-unorm', 'bc5-rg-snorm', 'bc6h-rgb-ufloat', 'bc6h-rgb-float',
+    'bc7-rgba-unorm', 'bc7-rgba-unorm-srgb',
+    'etc2-rgb8unorm', 'etc2-rgb8unorm-srgb', 'etc2-rgb8a1unorm', 'etc2-rgb8a1unorm-srgb',
+    'etc2-rgba8unorm', 'etc2-rgba8unorm-srgb',
+    'eac-r11unorm', 'eac-r11snorm', 'eac-rg11unorm', 'eac-rg11snorm',
 ]
-"""Pixel formats for Textures and Renderbuffers."""
+"""Pixel formats for Textures and Renderbuffers.
+Block compressed formats (bc*, etc2*, eac*) are sampled-only textures: data is given
+in 4x4 blocks, writes are block aligned and reads return the whole base level."""
 
 BufferAccess = Literal[
     'stream_draw', 'stream_read', 'stream_copy',
@@ -118,14 +130,69 @@ BufferAccess = Literal[
 class BufferView:
     """
     A lightweight view into a subsection of a Buffer.
-    Created via Buffer.view().
+    Created via Buffer.view() or Heap.alloc().
+    Accepted wherever a Buffer is bound (vertex, index, uniform, storage, indirect).
     """
-    pass
+    buffer: Buffer
+    offset: int
+    size: int
+
+    def read(self, size: int | None = None, offset: int = 0, into=None) -> bytes:
+        """Buffer.read() relative to and bounded by the view."""
+        ...
+
+    def write(self, data: Data, offset: int = 0, *, discard: bool = False) -> None:
+        """Buffer.write() relative to and bounded by the view."""
+        ...
+
+    def as_array(self, dtype: ArrayDtype = 'uint8', shape: int | Sequence[int] | None = None, offset: int = 0) -> MappedArray:
+        """Buffer.as_array() relative to and bounded by the view."""
+        ...
+
+UploadConvert = Literal['f32->f16', 'f32->snorm16', 'f32->unorm8']
+
+ArrayDtype = Literal[
+    'uint8', 'int8', 'uint16', 'int16', 'uint32', 'int32',
+    'uint64', 'int64', 'float16', 'float32', 'float64',
+]
+
+class MappedArray:
+    """
+    A typed, shaped window over mapped buffer memory. Created via as_array().
+    Supports the buffer protocol, __array_interface__ and DLPack (CPU), so
+    np.asarray(), np.from_dlpack() and torch.from_dlpack() alias the mapping.
+    """
+    buffer: Buffer
+    shape: Tuple[int, ...]
+    nbytes: int
+    itemsize: int
+    __array_interface__: Dict[str, Any]
+
+    def __dlpack__(self, *, stream: None = None, max_version: Tuple[int, int] | None = None, dl_device: Any = None, copy: bool | None = None) -> Any:
+        """
+        A DLPack 1.0 tensor when max_version >= (1, 0), flagged read only for
+        mapped='read' buffers. Read mappings are not exported to older
+        consumers.
+        """
+        ...
+
+    def __dlpack_device__(self) -> Tuple[int, int]:
+        ...
 
 Vec3 = Tuple[float, float, float]
 Viewport = Tuple[int, int, int, int]
 Data = bytes | bytearray | memoryview | BufferView | Any
 
+class ReadTransform(TypedDict, total=False):
+    """GPU preprocessing for Image.read(transform=...)."""
+    crop: Viewport
+    size: Tuple[int, int]
+    channels: Literal['gray', 'grayscale'] | str
+    flip: bool
+    dtype: Literal['uint8', 'float16', 'float32']
+    scale: float
+    bias: float
+
 class LayoutBinding(TypedDict, total=False):
     """Defines a binding index for a named resource in a shader."""
     name: str
@@ -135,7 +202,7 @@ class BufferResource(TypedDict, total=False):
     """Descriptor for binding a Uniform Buffer."""
     type: Literal['uniform_buffer']
     binding: int
-    buffer: Buffer
+    buffer: Buffer | BufferView
     offset: int
     size: int
 
@@ -143,7 +210,7 @@ class StorageBufferResource(TypedDict, total=False):
     """Descriptor for binding a Shader Storage Buffer."""
     type: Literal['storage_buffer']
     binding: int
-    buffer: Buffer
+    buffer: Buffer | BufferView
     offset: int
     size: int
 
@@ -217,11 +284,37 @@ class Info(TypedDict):
     max_vertex_attribs: int
     max_draw_buffers: int
     max_samples: int
+    leaked_objects: int
+    """GL names dropped because the deletion queue could not allocate"""
 
 class ContextLoader(Protocol):
     """Callback protocol for loading OpenGL function pointers."""
     def load_opengl_function(name: str) -> int: ...
 
+class HeadlessEGL:
+    """Built-in EGL surfaceless loader used by headless contexts on Linux."""
+    version: tuple[int, int]
+    def load_opengl_function(self, name: str) -> int: ...
+    def make_current(self) -> None: ...
+    def release(self) -> None: ...
+
+class OSMesa:
+    """
+    Built-in OSMesa loader (Linux). The default framebuffer (ctx.screen) is the
+    target array itself, so blitting to the screen writes straight into it.
+    """
+    size: tuple[int, int]
+    target: Any
+    def load_opengl_function(self, name: str) -> int: ...
+    def make_current(self) -> None: ...
+    def release(self) -> None: ...
+    def retarget(self, target: Any) -> None:
+        """Render into another (height, width, 4) array of the same dtype."""
+        ...
+    def finish(self) -> None:
+        """Wait for rendering, the target holds the pixels afterwards."""
+        ...
+
 # --- Main Objects ---
 
 class ImageFace:
@@ -278,13 +371,18 @@ class Buffer:
         """
         ...
 
-    def write(self, data: Data, offset: int = 0) -> None:
+    def write(self, data: Data, offset: int = 0, *, discard: bool = False, convert: UploadConvert | None = None) -> None:
         """
         Upload data to the GPU buffer.
         
         Args:
             data: The bytes-like object to upload.
             offset: Byte offset in the GPU buffer to write to.
+            discard: The previous contents of the written range are no longer needed.
+                     The write then does not wait for draws still using them
+                     (orphaning or glInvalidateBufferSubData).
+            convert: Quantize float32 data while uploading. The buffer receives
+                     2 bytes (f16, snorm16) or 1 byte (unorm8) per float.
         """
         ...
 
@@ -298,8 +396,43 @@ class Buffer:
     def map(self) -> memoryview:
         """
         Map the buffer into client memory. 
-        Only supported for Storage Buffers (SSBOs).
-        Returns a writable memoryview backed by the mapped pointer.
+        Supported for Storage Buffers (SSBOs) and buffers created with `mapped=`.
+        Returns a memoryview backed by the mapped pointer.
+        """
+        ...
+
+    def write_strided(self, data: Any, dst_offset: int = 0, dst_stride: int = 0) -> None:
+        """
+        Gather the rows (outer index) of a strided array, e.g. one field of a
+        structured particle array, without a contiguous copy.
+        
+        Args:
+            data: Buffer-protocol object. Each row must be contiguous on its own.
+            dst_offset: Byte offset of the first row in this buffer.
+            dst_stride: Bytes between rows in this buffer, 0 packs them. Bytes
+                        between rows are left untouched.
+        """
+        ...
+
+    def write_many(self, items: Iterable[Tuple[int, Data]]) -> None:
+        """
+        Apply many (offset, data) updates under a single lock and bind.
+        Each item must be a tuple, strided data is copied as in write().
+        """
+        ...
+
+    def as_array(self, dtype: ArrayDtype = 'uint8', shape: int | Sequence[int] | None = None, offset: int = 0) -> MappedArray:
+        """
+        Map the buffer and expose it as a typed C-order array, without a copy.
+        The buffer cannot be unmapped while the array or a tensor made from it lives.
+        """
+        ...
+
+    def flush(self, offset: int = 0, size: int | None = None) -> None:
+        """
+        For non-coherent mappings. Makes CPU writes in the range visible to the GPU
+        (glFlushMappedBufferRange), and GPU writes visible to a read mapping once a
+        fence issued afterwards has signaled.
         """
         ...
 
@@ -356,6 +489,8 @@ class Image:
         offset: Tuple[int, int] | None = None,
         layer: int | None = None,
         level: int = 0,
+        *,
+        convert: UploadConvert | None = None,
     ) -> None:
         """
         Upload pixel data to the image.
@@ -366,6 +501,32 @@ class Image:
             offset: (x, y) offset of the update region.
             layer: Specific layer/face to update (if array/cubemap).
             level: Mipmap level to update.
+            convert: Quantize float32 data while uploading: 'f32->f16' for
+                     *16float, 'f32->snorm16' for *16snorm and 'f32->unorm8'
+                     for linear *8unorm images. Other formats, including
+                     the -srgb ones, raise TypeError.
+        """
+        ...
+
+    def stream_from(
+        self,
+        source: str | os.PathLike | Data,
+        tile: Tuple[int, int] = (512, 512),
+        *,
+        offset: int = 0,
+        layer: int | None = None,
+        level: int = 0,
+        budget: int = 4194304,
+    ) -> ImageStream:
+        """
+        Upload one level (and layer) progressively from tightly packed pixels in the
+        image's format. Paths are memory-mapped, only the pages of uploaded tiles are read.
+        
+        Args:
+            source: File path, mmap or any bytes-like object.
+            tile: Tile size in pixels.
+            offset: Byte offset of the pixels in the source (e.g. to skip a header).
+            budget: Default bytes per ImageStream.step().
         """
         ...
 
@@ -373,7 +534,13 @@ class Image:
         """Generate mipmaps for the image (glGenerateMipmap)."""
         ...
 
-    def read(self, size: Tuple[int, int] | None = None, offset: Tuple[int, int] | None = None, into=None) -> bytes:
+    def read(
+        self,
+        size: Tuple[int, int] | None = None,
+        offset: Tuple[int, int] | None = None,
+        into=None,
+        transform: ReadTransform | None = None,
+    ) -> bytes:
         """
         Read pixel data from the image.
         
@@ -381,6 +548,8 @@ class Image:
             size: (width, height) to read.
             offset: (x, y) offset to read from.
             into: Optional buffer to write pixels into.
+            transform: Preprocess on the GPU before the readback. Only the
+                       transformed pixels are copied back.
             
         Returns:
             bytes object if `into` is None.
@@ -414,6 +583,85 @@ class Image:
         """
         ...
 
+    def copy_to(
+        self,
+        target: Image,
+        src_rect: Viewport | None = None,
+        dst_offset: Tuple[int, int] | None = None,
+        layers: int | Tuple[int, int] | None = None,
+        levels: int | Tuple[int, int] = 1,
+        dst_layer: int | None = None,
+    ) -> None:
+        """
+        Copy texels to another image without framebuffers (glCopyImageSubData).
+        
+        Args:
+            target: The destination Image.
+            src_rect: (x, y, w, h) source region at level 0. Defaults to the whole image.
+            dst_offset: (x, y) destination offset at level 0.
+            layers: Layer count, or (first, count). Defaults to every layer.
+            levels: Mip level count, or (first, count). The region is halved per level.
+            dst_layer: First destination layer. Defaults to the source's first
+                layer for layered targets and to 0 for 2D targets.
+
+        Compressed images copy whole blocks: src_rect and dst_offset must be
+        block aligned, except where the region ends at the image edge.
+        
+        Images with different formats (or sample counts) fall back to a blit
+        per layer and level.
+        """
+        ...
+
+class ImageStream:
+    """
+    A tiled upload in progress. Created via Image.stream_from().
+    """
+    image: Image
+    budget: int
+    """Bytes per step(), must be positive"""
+    done: bool
+    progress: Tuple[int, int]
+    """(uploaded tiles, total tiles)"""
+
+    def step(self, budget: int | None = None) -> bool:
+        """
+        Upload tiles until `budget` bytes were sent (at least one tile).
+        Call once per frame. Returns True once the image is complete.
+        """
+        ...
+
+class FrameStack:
+    """
+    The last `size` frames of an image, one array layer each.
+    Created via Context.frame_stack().
+    """
+    source: Image
+    image: Image
+    """The array image holding the frames, usable as a sampler."""
+    size: int
+    index: int
+    """The layer the next push() writes, which holds the oldest frame."""
+
+    def push(self) -> None:
+        """
+        Copy the current contents of the source into the ring. The first push
+        after creation or reset() fills every layer.
+        """
+        ...
+
+    def reset(self) -> None:
+        """Start a new episode, the next push() fills the whole stack again."""
+        ...
+
+    def read(self, into=None) -> bytes:
+        """
+        Read every frame, oldest first, as one (size, height, width, channels) block.
+        
+        Returns:
+            bytes object if `into` is None.
+        """
+        ...
+
 class Pipeline:
     """
     An immutable object representing the entire graphics pipeline state.
@@ -435,7 +683,7 @@ class Pipeline:
         """
         ...
 
-    def render_indirect(self, buffer: Buffer, count: int, offset: int = 0, stride: int = 0) -> None:
+    def render_indirect(self, buffer: Buffer | BufferView, count: int, offset: int = 0, stride: int = 0) -> None:
         """
         Execute an indirect draw call (glMultiDrawArraysIndirect or glMultiDrawElementsIndirect).
         
@@ -444,6 +692,10 @@ class Pipeline:
             count: The number of draw commands to execute.
             offset: Byte offset into the buffer where commands start.
             stride: Byte stride between commands. 0 means tightly packed.
+
+        firstIndex counts from the start of the index buffer. A pipeline whose
+        index buffer is a view at a nonzero offset (e.g. a Heap allocation) is
+        rejected; add offset // index size to firstIndex and bind the parent.
         """
         ...
 
@@ -462,6 +714,161 @@ class Compute:
         """
         ...
 
+class Heap:
+    """
+    Sub-allocates ranges of a few large buffers (buddy allocator).
+    Created via Context.heap().
+    """
+    kind: Literal['vertex', 'index', 'uniform', 'storage']
+    size: int
+    """Total bytes across all buffers."""
+    used: int
+    """Allocated bytes, rounded up to blocks."""
+    block: int
+    """Smallest allocation; every view offset is a multiple of it."""
+    buffers: Tuple[Buffer, ...]
+
+    def alloc(self, size: int | None = None, data: Data | None = None) -> BufferView:
+        """
+        Allocate a range, a new buffer is added when the heap is full.
+        `size` defaults to the length of `data`, which is written into the range.
+        """
+        ...
+
+    def free(self, view: BufferView) -> None:
+        """
+        Return the range to the heap. Free it only once the GPU no longer reads it.
+        """
+        ...
+
+class Mesh:
+    """
+    A range of a MeshPool. Indices are relative to the mesh's first vertex.
+    Created via MeshPool.add().
+    """
+    first_index: int
+    index_count: int
+    base_vertex: int
+    vertex_count: int
+
+class MeshPool:
+    """
+    Meshes sharing one vertex and one index buffer, drawn by a single
+    render_indirect() through one vertex array.
+    Created via Context.mesh_pool().
+    """
+    vertex_buffer: Buffer
+    index_buffer: Buffer
+    stride: int
+    short_index: bool
+    vertices: int
+    indices: int
+    vertices_used: int
+    indices_used: int
+
+    def add(self, vertices: Data, indices: Data) -> Mesh:
+        """Upload a mesh, raises ValueError when the pool is full."""
+        ...
+
+    def free(self, mesh: Mesh) -> None:
+        """Return the mesh's ranges. Free it only once the GPU no longer draws it."""
+        ...
+
+    def build_commands(self, instances: Sequence[Mesh | Tuple[Mesh, int]], base_instance: int = 0) -> bytes:
+        """
+        Pack one DrawElementsIndirectCommand per entry (count, instanceCount,
+        firstIndex, baseVertex, baseInstance). baseInstance counts up from
+        `base_instance` so instanced attributes can be laid out in draw order.
+        """
+        ...
+
+class Fence:
+    """
+    A marker in the render thread submission stream, or a GL sync object
+    when created on the upload thread.
+    Created via Context.fence().
+    """
+    signaled: bool
+
+    def wait(self, timeout: float = -1.0) -> bool:
+        """
+        Block until everything submitted before the fence has executed.
+        Returns False if `timeout` (seconds) expired first. Negative waits forever.
+        Upload fences need a context of the share group current on the waiting thread.
+        """
+        ...
+
+class Encoder:
+    """
+    Records uploads, copies and draws from any thread without touching OpenGL.
+    Submitted encoders are replayed on the context thread, in submission order,
+    at the next Context.new_frame() or Context.end_frame().
+    Created via Context.encoder().
+    """
+    count: int
+    """Number of recorded commands not yet submitted."""
+
+    def write(self, buffer: Buffer, data: Data, offset: int = 0) -> None:
+        """Record Buffer.write(). Client memory is copied at record time."""
+        ...
+
+    def write_image(
+        self,
+        image: Image,
+        data: Data,
+        size: Tuple[int, int] | None = None,
+        offset: Tuple[int, int] | None = None,
+        layer: int | None = None,
+        level: int = 0,
+    ) -> None:
+        """Record Image.write(). Client memory is copied at record time."""
+        ...
+
+    def blit(
+        self,
+        image: Image,
+        target: Image | None = None,
+        offset: Tuple[int, int] | None = None,
+        size: Tuple[int, int] | None = None,
+        crop: Viewport | None = None,
+        filter: bool = False,
+    ) -> None:
+        """Record Image.blit()."""
+        ...
+
+    def render(self, pipeline: Pipeline) -> None:
+        """Record Pipeline.render(). Uniforms and counts are read at replay time."""
+        ...
+
+    def render_indirect(self, pipeline: Pipeline, buffer: Buffer | BufferView, count: int, offset: int = 0, stride: int = 0) -> None:
+        """Record Pipeline.render_indirect()."""
+        ...
+
+    def run(self, compute: Compute, x: int = 1, y: int = 1, z: int = 1) -> None:
+        """Record Compute.run(). Uniforms are read at replay time."""
+        ...
+
+    def read(
+        self,
+        target: Buffer | Image,
+        size: int | Tuple[int, int] | None = None,
+        offset: int | Tuple[int, int] | None = None,
+        into: Any = ...,
+    ) -> None:
+        """
+        Record Buffer.read() / Image.read() into caller-owned memory.
+        `into` is required; wait on a Context.fence() before touching it.
+        """
+        ...
+
+    def submit(self) -> None:
+        """
+        Queue the recorded commands on the Context and reset the encoder.
+        If a command fails during replay, the rest of the queue is discarded
+        and the error is raised from new_frame() / end_frame().
+        """
+        ...
+
 class Context:
     """
     The main entry point for managing OpenGL state and creating resources.
@@ -472,6 +879,17 @@ class Context:
     loader: ContextLoader
     lost: bool
 
+    def __new__(cls, loader: ContextLoader | None = None, headless: bool = False, target: Any = None) -> Context:
+        """
+        Without arguments, return the process wide default context.
+        With a loader, a target, or headless=True, create an independent context bound
+        to the calling thread, with its own caches and state. Use one per worker thread.
+        When it is collected on that thread, loader.make_current() is called to
+        delete its objects, so make any other context current again afterwards.
+        Without make_current() the objects go away with the GL context.
+        """
+        ...
+
     def buffer(
         self,
         data: Data | None = None,
@@ -481,6 +899,8 @@ class Context:
         uniform: bool = False,
         storage: bool = False,
         external: int = 0,
+        mapped: Literal['read', 'write', 'readwrite'] | None = None,
+        coherent: bool = False,
     ) -> Buffer:
         """
         Create a new Buffer Object.
@@ -493,6 +913,49 @@ class Context:
             uniform: Set True if this is a Uniform Buffer Object (UBO).
             storage: Set True if this is a Shader Storage Buffer Object (SSBO).
             external: Wrap an existing OpenGL buffer ID.
+            mapped: Allocate immutable storage for any target that stays mapped with this
+                    access. buffer.map() returns the memoryview (read-only for 'read').
+            coherent: Coherent mapping. Otherwise call buffer.flush() after CPU writes,
+                      or before the fence that precedes reading GPU results.
+        """
+        ...
+
+    def heap(
+        self,
+        size: int,
+        kind: Literal['vertex', 'index', 'uniform', 'storage'] = 'vertex',
+        *,
+        block: int = 256,
+    ) -> Heap:
+        """
+        Create a sub-allocating Heap over buffers of `size` bytes.
+        
+        Args:
+            size: Bytes per buffer, rounded up to a power of two blocks.
+            kind: Buffer target. Uniform and storage heaps raise `block` to the
+                  offset alignment so every view binds as a range.
+            block: Smallest allocation, a power of two.
+        """
+        ...
+
+    def mesh_pool(self, stride: int, vertices: int, indices: int, *, short_index: bool = False) -> MeshPool:
+        """
+        Create a MeshPool with room for `vertices` vertices of `stride` bytes
+        and `indices` indices. Both buffers are allocated up front.
+        """
+        ...
+
+    def load_texture(self, source: str | os.PathLike | Data) -> Image:
+        """
+        Create a texture from a KTX2 or DDS file. Paths are memory mapped and
+        every stored mip level, layer and cubemap face is uploaded straight
+        from the mapping. Block compressed data is uploaded as is.
+        """
+        ...
+
+    def frame_stack(self, image: Image, size: int = 4) -> FrameStack:
+        """
+        Keep the last `size` renders of a single layer `image` on the GPU.
         """
         ...
 
@@ -536,7 +999,7 @@ class Context:
         blend: BlendSettings | None = None,
         framebuffer: Iterable[Image | ImageFace] | None = ...,
         vertex_buffers: Iterable[VertexBufferBinding] = (),
-        index_buffer: Buffer | None = None,
+        index_buffer: Buffer | BufferView | None = None,
         short_index: bool = False,
         cull_face: CullFace = 'none',
         topology: Topology = 'triangles',
@@ -548,6 +1011,7 @@ class Context:
         viewport_data: memoryview | None = None,
         render_data: memoryview | None = None,
         includes: Dict[str, str] | None = None,
+        vertex_streams: Iterable[Buffer | BufferView] | Dict[int, Buffer | BufferView] | None = None,
         template: Pipeline = ...,
     ) -> Pipeline:
         """
@@ -573,6 +1037,10 @@ class Context:
             first_vertex: Index of the first vertex.
             viewport: (x, y, w, h) override.
             includes: Dict of include strings for the shader preprocessor.
+            vertex_streams: Vertex pulling. Buffers bound as storage buffers (by position,
+                            or binding -> buffer) that the vertex shader indexes with
+                            gl_VertexID / gl_InstanceID. Excludes vertex_buffers, the
+                            vertex array then only holds the index buffer and is shared.
             template: Create a new pipeline inheriting state from an existing one.
         """
         ...
@@ -608,10 +1076,11 @@ class Context:
         """
         ...
 
-    def release(self, obj: Buffer | Image | Pipeline | Compute | Literal['shader_cache'] | Literal['all']) -> None:
+    def release(self, obj: Buffer | Image | Pipeline | Compute | Literal['shader_cache'] | Literal['resolve_pool'] | Literal['all']) -> None:
         """
         Manually release an OpenGL object or clear internal caches.
         This bypasses the garbage collector for immediate resource cleanup.
+        Raises BufferError for a buffer whose arrays or tensors are alive.
         """
         ...
 
@@ -622,6 +1091,55 @@ class Context:
         """
         ...
 
+    def encoder(self) -> Encoder:
+        """
+        Create a deferred command Encoder.
+        Use one per producer thread; recording never issues OpenGL calls.
+        """
+        ...
+
+    def start_render_thread(self, make_current: Any = None, release_current: Any = None) -> None:
+        """
+        Move all OpenGL work to a native render thread.
+        The GL context must not be current on the calling thread. `make_current`
+        is called on the render thread to bind it, `release_current` before it exits.
+        Afterwards new_frame() / end_frame() only enqueue work (submitted encoders
+        included) and return immediately; only the calling thread may submit.
+        Other GL calls from the calling thread are executed on the render thread:
+        render/run/clear/blit/copy_to/mipmaps are queued, everything else waits
+        for its result. Calls from any other thread raise RuntimeError.
+        release('all') stops the render thread.
+        """
+        ...
+
+    def stop_render_thread(self) -> None:
+        """
+        Drain the queue and join the render thread. Raises the first error that
+        occurred on it. The caller must make the GL context current again.
+        """
+        ...
+
+    def fence(self) -> Fence:
+        """
+        Insert a Fence after everything submitted so far.
+        Without a render thread the fence is already signaled.
+        On the upload thread it is signaled once the GPU has finished the uploads.
+        """
+        ...
+
+    def attach_upload_thread(self) -> None:
+        """
+        Register the calling thread as the upload thread.
+        Call it after making an UploadContext current. buffer() and image() issued
+        there upload through the shared context without touching the render state.
+        Image faces (framebuffers) cannot be created on the upload thread.
+        """
+        ...
+
+    def detach_upload_thread(self) -> None:
+        """Flush pending uploads and unregister the calling upload thread."""
+        ...
+
     def gc(self) -> List[Buffer | Image | Pipeline | Compute]:
         """Trigger garbage collection of released GL objects."""
         ...
@@ -644,14 +1162,19 @@ class Context:
 
 # --- Module Level Functions ---
 
-def init(loader: ContextLoader | None = None, headless: bool = False):
+def init(loader: ContextLoader | None = None, headless: bool = False, target: Any = None):
     """
     Initialize the HyperGL module.
     
     Args:
         loader: A custom loader.
         headless: If True, creates a hidden window/context (useful for servers/tests).
+                  On Linux this is a built-in EGL surfaceless context, falling back
+                  to the glcontext helper when libEGL is unavailable.
                   Ignored if loader is provided.
+        target: A writable C contiguous (height, width, 4) uint8 or float32 array.
+                Creates an OSMesa context that renders the screen into it.
+                Row 0 is the bottom row. Ignored if loader is provided.
     """
     ...
 
@@ -660,7 +1183,7 @@ def cleanup() -> None:
     ...
 
 def context() -> Context:
-    """Retrieve the singleton HyperGL Context."""
+    """Retrieve the default HyperGL Context. See Context() for independent ones."""
     ...
 
 def inspect(self, obj: Buffer | Image | Pipeline | Compute):
@@ -716,4 +1239,20 @@ def loader(headless: bool = False) -> ContextLoader:
     """
     Get a default platform-specific loader if available.
     """
+    ...
+
+class UploadContext(Protocol):
+    def make_current(self) -> None:
+        """Bind the shared context on the calling (loader) thread."""
+        ...
+
+    def release(self) -> None:
+        """Unbind and destroy the shared context."""
+        ...
+
+def upload_context() -> UploadContext:
+    """
+    Create a context sharing objects with the one current on the calling thread.
+    Supported with EGL and WGL.
+    """
     ...
\ No newline at end of file
@@ -28,6 +28,7 @@ RESOLVE(void, glDepthMask, int);
 RESOLVE(void, glDisable, int);
 RESOLVE(void, glEnable, int);
 RESOLVE(void, glFlush);
+RESOLVE(void, glFinish);
 RESOLVE(void, glDepthFunc, int);
 RESOLVE(void, glGetIntegerv, int, int *);
 RESOLVE(const char *, glGetString, int);
@@ -48,6 +49,20 @@ RESOLVE(void, glTexImage3D, int, int, int, int, int, int, int, int, int,
         const void *);
 RESOLVE(void, glTexSubImage3D, int, int, int, int, int, int, int, int, int, int,
         const void *);
+RESOLVE(void, glCompressedTexImage2D, int, int, int, int, int, int, int,
+        const void *);
+RESOLVE(void, glCompressedTexImage3D, int, int, int, int, int, int, int, int,
+        const void *);
+RESOLVE(void, glCompressedTexSubImage2D, int, int, int, int, int, int, int,
+        int, const void *);
+RESOLVE(void, glCompressedTexSubImage3D, int, int, int, int, int, int, int,
+        int, int, int, const void *);
+RESOLVE(void, glGetCompressedTexImage, int, int, void *);
+RESOLVE(void, glGetTexImage, int, int, int, int, void *);
+RESOLVE(void, glGetTextureSubImage, int, int, int, int, int, int, int, int, int,
+        int, int, void *);
+RESOLVE(void, glCopyImageSubData, int, int, int, int, int, int, int, int, int,
+        int, int, int, int, int, int);
 RESOLVE(void, glActiveTexture, int);
 RESOLVE(void, glGenerateMipmap, int);
 RESOLVE(void, glGenSamplers, int, int *);
@@ -75,8 +90,11 @@ RESOLVE(void, glClearBufferfi, int, int, float, int);
 RESOLVE(void, glCopyBufferSubData, int, int, intptr, intptr, intptr);
 RESOLVE(void, glBindBufferBase, int, int, int);
 RESOLVE(void *, glMapBufferRange, int, intptr, intptr, int);
+RESOLVE(void, glFlushMappedBufferRange, int, intptr, intptr);
 RESOLVE(int, glUnmapBuffer, int);
 RESOLVE(void, glGetBufferParameteriv, unsigned int, unsigned int, int *);
+RESOLVE(void, glInvalidateBufferData, int);
+RESOLVE(void, glInvalidateBufferSubData, int, intptr, intptr);
 
 // -- Blending & Stencil --
 RESOLVE(void, glBlendFuncSeparate, int, int, int, int);
@@ -175,14 +193,173 @@ RESOLVE(GLuint64, glGetTextureHandleARB, int);
 RESOLVE(void, glMakeTextureHandleResidentARB, GLuint64);
 RESOLVE(void, glMakeTextureHandleNonResidentARB, GLuint64);
 
+// -- Sync Objects --
+RESOLVE(void *, glFenceSync, int, int);
+RESOLVE(int, glClientWaitSync, void *, int, GLuint64);
+RESOLVE(void, glDeleteSync, void *);
+
 // -----------------------------------------------------------------------------
 // OpenGL Loader Logic
 // -----------------------------------------------------------------------------
 
 #ifndef EXTERN_GL
 
+#ifdef HYPERGL_NATIVE_EGL
+// libEGL entry points, resolved once per process like the GL table
+static struct {
+  void *library;
+  void *(*GetProcAddress)(const char *);
+  const char *(*QueryString)(void *, int);
+  int (*GetError)(void);
+  void *(*GetDisplay)(void *);
+  void *(*GetPlatformDisplayEXT)(int, void *, const int *);
+  int (*QueryDevicesEXT)(int, void **, int *);
+  int (*Initialize)(void *, int *, int *);
+  int (*BindAPI)(int);
+  int (*ChooseConfig)(void *, const int *, void **, int, int *);
+  void *(*CreateContext)(void *, void *, void *, const int *);
+  int (*MakeCurrent)(void *, void *, void *, void *);
+  int (*DestroyContext)(void *, void *);
+  void *(*GetCurrentContext)(void);
+} egl;
+
+static PyMutex egl_lock;
+
+static int load_egl(void) {
+  PyMutex_Lock(&egl_lock);
+  if (egl.library) {
+    PyMutex_Unlock(&egl_lock);
+    return 0;
+  }
+
+  void *library = dlopen("libEGL.so.1", RTLD_NOW | RTLD_LOCAL);
+  if (!library) {
+    library = dlopen("libEGL.so", RTLD_NOW | RTLD_LOCAL);
+  }
+  if (!library) {
+    PyMutex_Unlock(&egl_lock);
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] libEGL is not available");
+    return -1;
+  }
+
+#define load_egl_symbol(name)                                                  \
+  do {                                                                         \
+    void *_sym = dlsym(library, "egl" #name);                                  \
+    memcpy((void *)&egl.name, (const void *)&_sym, sizeof(void *));            \
+  } while (0)
+
+  load_egl_symbol(GetProcAddress);
+  load_egl_symbol(QueryString);
+  load_egl_symbol(GetError);
+  load_egl_symbol(GetDisplay);
+  load_egl_symbol(Initialize);
+  load_egl_symbol(BindAPI);
+  load_egl_symbol(ChooseConfig);
+  load_egl_symbol(CreateContext);
+  load_egl_symbol(MakeCurrent);
+  load_egl_symbol(DestroyContext);
+  load_egl_symbol(GetCurrentContext);
+
+#undef load_egl_symbol
+
+  if (!egl.GetProcAddress || !egl.QueryString || !egl.GetError ||
+      !egl.GetDisplay || !egl.Initialize || !egl.BindAPI ||
+      !egl.ChooseConfig || !egl.CreateContext || !egl.MakeCurrent ||
+      !egl.DestroyContext || !egl.GetCurrentContext) {
+    dlclose(library);
+    memset(&egl, 0, sizeof(egl));
+    PyMutex_Unlock(&egl_lock);
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] libEGL is incomplete");
+    return -1;
+  }
+
+  // Extension entry points only come through eglGetProcAddress
+  void *ext = egl.GetProcAddress("eglGetPlatformDisplayEXT");
+  memcpy((void *)&egl.GetPlatformDisplayEXT, (const void *)&ext, sizeof(void *));
+  ext = egl.GetProcAddress("eglQueryDevicesEXT");
+  memcpy((void *)&egl.QueryDevicesEXT, (const void *)&ext, sizeof(void *));
+
+  egl.library = library;
+  PyMutex_Unlock(&egl_lock);
+  return 0;
+}
+#endif
+
+#ifdef HYPERGL_NATIVE_OSMESA
+// libOSMesa entry points, same lifetime as the EGL ones
+static struct {
+  void *library;
+  void *(*GetProcAddress)(const char *);
+  void *(*CreateContextAttribs)(const int *, void *);
+  unsigned char (*MakeCurrent)(void *, void *, int, int, int);
+  void (*DestroyContext)(void *);
+  void *(*GetCurrentContext)(void);
+  void (*Finish)(void);
+} osmesa;
+
+static PyMutex osmesa_lock;
+
+static int load_osmesa(void) {
+  PyMutex_Lock(&osmesa_lock);
+  if (osmesa.library) {
+    PyMutex_Unlock(&osmesa_lock);
+    return 0;
+  }
+
+  static const char *names[] = {"libOSMesa.so.8", "libOSMesa.so.6",
+                                "libOSMesa.so"};
+  void *library = NULL;
+  for (int i = 0; i < 3 && !library; ++i) {
+    library = dlopen(names[i], RTLD_NOW | RTLD_LOCAL);
+  }
+  if (!library) {
+    PyMutex_Unlock(&osmesa_lock);
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] libOSMesa is not available");
+    return -1;
+  }
+
+#define load_osmesa_symbol(name)                                               \
+  do {                                                                         \
+    void *_sym = dlsym(library, "OSMesa" #name);                               \
+    memcpy((void *)&osmesa.name, (const void *)&_sym, sizeof(void *));         \
+  } while (0)
+
+  load_osmesa_symbol(GetProcAddress);
+  load_osmesa_symbol(CreateContextAttribs);
+  load_osmesa_symbol(MakeCurrent);
+  load_osmesa_symbol(DestroyContext);
+  load_osmesa_symbol(GetCurrentContext);
+
+#undef load_osmesa_symbol
+
+  // OSMesaCreateContextAttribs is the only way to a core profile (Mesa 12+)
+  if (!osmesa.GetProcAddress || !osmesa.CreateContextAttribs ||
+      !osmesa.MakeCurrent || !osmesa.DestroyContext ||
+      !osmesa.GetCurrentContext) {
+    dlclose(library);
+    memset(&osmesa, 0, sizeof(osmesa));
+    PyMutex_Unlock(&osmesa_lock);
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] libOSMesa is too old (Mesa 12+ is required)");
+    return -1;
+  }
+
+  void *finish = osmesa.GetProcAddress("glFinish");
+  memcpy((void *)&osmesa.Finish, (const void *)&finish, sizeof(void *));
+
+  osmesa.library = library;
+  PyMutex_Unlock(&osmesa_lock);
+  return 0;
+}
+#endif
+
 static void *load_opengl_function(PyObject *loader_function,
+                                  void *(*native)(const char *),
                                   const char *method) {
+  if (native) {
+    // Built-in backends resolve without a round trip through Python
+    return native(method);
+  }
   PyObject *res = PyObject_CallFunction(loader_function, "(s)", method);
   if (!res) {
     return NULL;
@@ -196,16 +373,37 @@ static void *load_opengl_function(PyObject *loader_function,
   return ptr;
 }
 
-static int load_gl(PyObject *loader) {
-  PyObject *loader_function =
-      PyObject_GetAttrString(loader, "load_opengl_function");
+// With `verify` set the table is left alone and every function must resolve to
+// the pointer already loaded. All contexts of the process share one table,
+// which holds on EGL/GLX (and on WGL for contexts of the same driver).
+static int load_gl(ModuleState *state, PyObject *loader, int verify) {
+  void *(*native)(const char *) = NULL;
+  PyObject *loader_function = NULL;
 
-  if (!loader_function) {
-    PyErr_Format(PyExc_ValueError, "invalid loader");
-    return -1;
+#ifdef HYPERGL_NATIVE_EGL
+  if (state->HeadlessEGL_type && Py_TYPE(loader) == state->HeadlessEGL_type) {
+    native = egl.GetProcAddress;
+  }
+#endif
+#ifdef HYPERGL_NATIVE_OSMESA
+  if (state->OSMesa_type && Py_TYPE(loader) == state->OSMesa_type) {
+    native = osmesa.GetProcAddress;
+  }
+#endif
+
+  if (!native) {
+    loader_function = PyObject_GetAttrString(loader, "load_opengl_function");
+    if (!loader_function) {
+      PyErr_Format(PyExc_ValueError, "invalid loader");
+      return -1;
+    }
   }
 
   PyObject *missing = PyList_New(0);
+  if (!missing) {
+    Py_XDECREF(loader_function);
+    return -1;
+  }
 
 #define check(name)                                                            \
   do {                                                                         \
@@ -217,16 +415,30 @@ static int load_gl(PyObject *loader) {
     }                                                                          \
   } while (0)
 
+#define mismatch(name, ptr)                                                    \
+  do {                                                                         \
+    if (memcmp((const void *)&(name), (const void *)&(ptr), sizeof(void *))) { \
+      PyObject *_hgl_str = PyUnicode_FromString(#name);                        \
+      if (_hgl_str)                                                            \
+        PyList_Append(missing, _hgl_str);                                      \
+      Py_XDECREF(_hgl_str);                                                    \
+    }                                                                          \
+  } while (0)
+
 #define load(name)                                                             \
   do {                                                                         \
-    void *temp_ptr = load_opengl_function(loader_function, #name);             \
+    void *temp_ptr = load_opengl_function(loader_function, native, #name);     \
     if (!temp_ptr && PyErr_Occurred()) {                                       \
-      Py_DECREF(loader_function);                                              \
+      Py_XDECREF(loader_function);                                             \
       Py_DECREF(missing);                                                      \
       return -1;                                                               \
     }                                                                          \
-    memcpy((void *)&(name), (const void *)&temp_ptr, sizeof(void *));          \
-    check(name);                                                               \
+    if (verify) {                                                              \
+      mismatch(name, temp_ptr);                                                \
+    } else {                                                                   \
+      memcpy((void *)&(name), (const void *)&temp_ptr, sizeof(void *));        \
+      check(name);                                                             \
+    }                                                                          \
   } while (0)
 
   load(glCullFace);
@@ -237,6 +449,7 @@ static int load_gl(PyObject *loader) {
   load(glDisable);
   load(glEnable);
   load(glFlush);
+  load(glFinish);
   load(glDepthFunc);
   load(glReadBuffer);
   load(glReadPixels);
@@ -250,6 +463,10 @@ static int load_gl(PyObject *loader) {
   load(glGenTextures);
   load(glTexImage3D);
   load(glTexSubImage3D);
+  load(glCompressedTexImage2D);
+  load(glCompressedTexImage3D);
+  load(glCompressedTexSubImage2D);
+  load(glCompressedTexSubImage3D);
   load(glActiveTexture);
   load(glBlendFuncSeparate);
   load(glBindBuffer);
@@ -346,6 +563,7 @@ static int load_gl(PyObject *loader) {
   load(glBindImageTexture);
   load(glBindBufferBase);
   load(glMapBufferRange);
+  load(glFlushMappedBufferRange);
   load(glUnmapBuffer);
   load(glPixelStorei);
   load(glGetProgramInterfaceiv);
@@ -355,11 +573,15 @@ static int load_gl(PyObject *loader) {
 
 #define load_optional(name)                                                    \
   do {                                                                         \
-    void *_opt = load_opengl_function(loader_function, #name);                 \
+    void *_opt = load_opengl_function(loader_function, native, #name);         \
     if (!_opt && PyErr_Occurred()) {                                           \
       PyErr_Clear();                                                           \
     }                                                                          \
-    memcpy((void *)&(name), (const void *)&_opt, sizeof(void *));              \
+    if (verify) {                                                              \
+      mismatch(name, _opt);                                                    \
+    } else {                                                                   \
+      memcpy((void *)&(name), (const void *)&_opt, sizeof(void *));            \
+    }                                                                          \
   } while (0)
 
   load_optional(glGetTextureHandleARB);
@@ -367,12 +589,31 @@ static int load_gl(PyObject *loader) {
   load_optional(glMakeTextureHandleNonResidentARB);
   load_optional(glMultiDrawArraysIndirect);
   load_optional(glMultiDrawElementsIndirect);
+  load_optional(glFenceSync);
+  load_optional(glClientWaitSync);
+  load_optional(glDeleteSync);
+  load_optional(glInvalidateBufferData);
+  load_optional(glInvalidateBufferSubData);
+  load_optional(glGetCompressedTexImage);
+  load_optional(glGetTexImage);
+  load_optional(glGetTextureSubImage);
+  load_optional(glCopyImageSubData);
 
 #undef load
 #undef load_optional
+#undef mismatch
 #undef check
 
-  Py_DECREF(loader_function);
+  Py_XDECREF(loader_function);
+
+  if (PyList_Size(missing) > 0 && verify) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] the loader resolves different opengl functions "
+                 "than the other contexts: %R",
+                 missing);
+    Py_DECREF(missing);
+    return -1;
+  }
 
   if (PyList_Size(missing) > 0) {
     PyErr_Format(PyExc_RuntimeError, "cannot load opengl functions: %R",
@@ -387,7 +628,381 @@ static int load_gl(PyObject *loader) {
 
 #else
 
-static void load_gl(PyObject *loader) {}
+static int load_gl(ModuleState *state, PyObject *loader, int verify) {
+  return 0;
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// Built-in Headless Backend (EGL)
+// -----------------------------------------------------------------------------
+
+#ifdef HYPERGL_NATIVE_EGL
+
+// Mesa's surfaceless platform first, then the first enumerated device (headless
+// NVIDIA), then whatever the default display is.
+static void *egl_open_display(void) {
+  const char *client = egl.QueryString(NULL, EGL_EXTENSIONS);
+  int major = 0;
+  int minor = 0;
+
+  if (client && egl.GetPlatformDisplayEXT &&
+      strstr(client, "EGL_MESA_platform_surfaceless")) {
+    void *display =
+        egl.GetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, NULL, NULL);
+    if (display && egl.Initialize(display, &major, &minor)) {
+      return display;
+    }
+  }
+
+  if (client && egl.GetPlatformDisplayEXT && egl.QueryDevicesEXT &&
+      strstr(client, "EGL_EXT_platform_device")) {
+    void *devices[EGL_MAX_DEVICES];
+    int count = 0;
+    if (egl.QueryDevicesEXT(EGL_MAX_DEVICES, devices, &count)) {
+      for (int i = 0; i < count; ++i) {
+        void *display =
+            egl.GetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, devices[i], NULL);
+        if (display && egl.Initialize(display, &major, &minor)) {
+          return display;
+        }
+      }
+    }
+  }
+
+  void *display = egl.GetDisplay(NULL);
+  if (display && egl.Initialize(display, &major, &minor)) {
+    return display;
+  }
+  return NULL;
+}
+
+static HeadlessEGL *HeadlessEGL_create(ModuleState *state) {
+  if (load_egl() < 0) {
+    return NULL;
+  }
+
+  void *display = egl_open_display();
+  if (!display) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] cannot initialize an EGL display (0x%x)",
+                 egl.GetError());
+    return NULL;
+  }
+
+  if (!egl.BindAPI(EGL_OPENGL_API)) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] EGL has no desktop OpenGL support");
+    return NULL;
+  }
+
+  // No surface is ever created, any config able to render OpenGL will do
+  static const int config_attribs[][5] = {
+      {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+       EGL_NONE},
+      {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE},
+  };
+  void *config = NULL;
+  int config_count = 0;
+  for (int i = 0; i < 2 && config_count == 0; ++i) {
+    egl.ChooseConfig(display, config_attribs[i], &config, 1, &config_count);
+  }
+  if (config_count == 0) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] no EGL config supports OpenGL");
+    return NULL;
+  }
+
+  // Highest core profile first
+  static const int versions[][2] = {{4, 6}, {4, 5}, {4, 4}, {4, 3},
+                                    {4, 2}, {4, 1}, {4, 0}, {3, 3}};
+  void *context = NULL;
+  int major = 0;
+  int minor = 0;
+  for (size_t i = 0; i < sizeof(versions) / sizeof(versions[0]); ++i) {
+    const int context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION,       versions[i][0],
+        EGL_CONTEXT_MINOR_VERSION,       versions[i][1],
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE,
+    };
+    context = egl.CreateContext(display, config, NULL, context_attribs);
+    if (context) {
+      major = versions[i][0];
+      minor = versions[i][1];
+      break;
+    }
+  }
+  if (!context) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] cannot create an OpenGL 3.3+ core context (0x%x)",
+                 egl.GetError());
+    return NULL;
+  }
+
+  // EGL_KHR_surfaceless_context, no pbuffer needed
+  if (!egl.MakeCurrent(display, NULL, NULL, context)) {
+    int error = egl.GetError();
+    egl.DestroyContext(display, context);
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] cannot make the EGL context current (0x%x)", error);
+    return NULL;
+  }
+
+  HeadlessEGL *res = PyObject_New(HeadlessEGL, state->HeadlessEGL_type);
+  if (!res) {
+    egl.MakeCurrent(display, NULL, NULL, NULL);
+    egl.DestroyContext(display, context);
+    return NULL;
+  }
+  res->display = display;
+  res->context = context;
+  res->major = major;
+  res->minor = minor;
+  return res;
+}
+
+static PyObject *HeadlessEGL_meth_load_opengl_function(HeadlessEGL *self,
+                                                       PyObject *arg) {
+  const char *name = PyUnicode_AsUTF8(arg);
+  if (!name) {
+    return NULL;
+  }
+  return PyLong_FromVoidPtr(egl.GetProcAddress(name));
+}
+
+static PyObject *HeadlessEGL_meth_make_current(HeadlessEGL *self,
+                                               PyObject *args) {
+  if (!egl.MakeCurrent(self->display, NULL, NULL, self->context)) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] cannot make the EGL context current (0x%x)",
+                 egl.GetError());
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject *HeadlessEGL_meth_release(HeadlessEGL *self, PyObject *args) {
+  if (egl.GetCurrentContext() == self->context) {
+    egl.MakeCurrent(self->display, NULL, NULL, NULL);
+  }
+  Py_RETURN_NONE;
+}
+
+#else
+
+static HeadlessEGL *HeadlessEGL_create(ModuleState *state) {
+  PyErr_SetString(PyExc_RuntimeError,
+                  "[HyperGL] the built-in EGL backend is Linux only");
+  return NULL;
+}
+
+#endif
+
+// The built-in backend where there is one, the Python helpers otherwise
+static PyObject *headless_loader(ModuleState *state) {
+  PyObject *res = (PyObject *)HeadlessEGL_create(state);
+  if (res) {
+    return res;
+  }
+
+  PyObject *egl_error = PyErr_GetRaisedException();
+  res = PyObject_CallMethod(state->helper, "loader", "(i)", 1);
+  if (!res) {
+    // Keep the reason the built-in backend was skipped
+    PyObject *error = PyErr_GetRaisedException();
+    PyException_SetContext(error, egl_error);
+    PyErr_SetRaisedException(error);
+    return NULL;
+  }
+  Py_XDECREF(egl_error);
+  return res;
+}
+
+// -----------------------------------------------------------------------------
+// Built-in Software Backend (OSMesa)
+// -----------------------------------------------------------------------------
+
+#ifdef HYPERGL_NATIVE_OSMESA
+
+// The default framebuffer is the target memory itself: a C contiguous, writable
+// (height, width, 4) array of uint8 or float32. Row 0 is the bottom row, the
+// same order Image.read() returns.
+static int osmesa_get_target(PyObject *target, Py_buffer *view, int *type) {
+  if (PyObject_GetBuffer(target, view,
+                         PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) <
+      0) {
+    return -1;
+  }
+
+  const char *format = view->format ? view->format : "B";
+  if (*format == '<' || *format == '=' || *format == '@') {
+    format += 1;
+  }
+
+  if (!strcmp(format, "B") && view->itemsize == 1) {
+    *type = GL_UNSIGNED_BYTE;
+  } else if (!strcmp(format, "f") && view->itemsize == 4) {
+    *type = GL_FLOAT;
+  } else {
+    PyBuffer_Release(view);
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] the target must hold uint8 or float32 values");
+    return -1;
+  }
+
+  if (view->ndim != 3 || view->shape[2] != 4 || view->shape[0] < 1 ||
+      view->shape[1] < 1 || view->shape[0] > 0x7fffffff ||
+      view->shape[1] > 0x7fffffff) {
+    PyBuffer_Release(view);
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the target must have a (height, width, 4) shape");
+    return -1;
+  }
+  return 0;
+}
+
+static int osmesa_bind(void *context, Py_buffer *view, int type) {
+  int width = (int)view->shape[1];
+  int height = (int)view->shape[0];
+  if (!osmesa.MakeCurrent(context, view->buf, type, width, height)) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] cannot render into a %dx%d target", width, height);
+    return -1;
+  }
+  return 0;
+}
+
+static OSMesa *OSMesa_create(ModuleState *state, PyObject *target) {
+  if (load_osmesa() < 0) {
+    return NULL;
+  }
+
+  Py_buffer view;
+  int type = 0;
+  if (osmesa_get_target(target, &view, &type) < 0) {
+    return NULL;
+  }
+
+  // Highest core profile first
+  static const int versions[][2] = {{4, 6}, {4, 5}, {4, 4}, {4, 3},
+                                    {4, 2}, {4, 1}, {4, 0}, {3, 3}};
+  void *context = NULL;
+  for (size_t i = 0; i < sizeof(versions) / sizeof(versions[0]); ++i) {
+    const int attribs[] = {
+        OSMESA_FORMAT,                OSMESA_RGBA,
+        OSMESA_DEPTH_BITS,            24,
+        OSMESA_STENCIL_BITS,          8,
+        OSMESA_ACCUM_BITS,            0,
+        OSMESA_PROFILE,               OSMESA_CORE_PROFILE,
+        OSMESA_CONTEXT_MAJOR_VERSION, versions[i][0],
+        OSMESA_CONTEXT_MINOR_VERSION, versions[i][1],
+        0,
+    };
+    context = osmesa.CreateContextAttribs(attribs, NULL);
+    if (context) {
+      break;
+    }
+  }
+  if (!context) {
+    PyBuffer_Release(&view);
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] cannot create an OpenGL 3.3+ core OSMesa context");
+    return NULL;
+  }
+
+  if (osmesa_bind(context, &view, type) < 0) {
+    osmesa.DestroyContext(context);
+    PyBuffer_Release(&view);
+    return NULL;
+  }
+
+  OSMesa *res = PyObject_New(OSMesa, state->OSMesa_type);
+  if (!res) {
+    osmesa.MakeCurrent(NULL, NULL, GL_UNSIGNED_BYTE, 0, 0);
+    osmesa.DestroyContext(context);
+    PyBuffer_Release(&view);
+    return NULL;
+  }
+  res->context = context;
+  res->target = view;
+  res->width = (int)view.shape[1];
+  res->height = (int)view.shape[0];
+  res->type = type;
+  return res;
+}
+
+static PyObject *OSMesa_meth_load_opengl_function(OSMesa *self,
+                                                  PyObject *arg) {
+  const char *name = PyUnicode_AsUTF8(arg);
+  if (!name) {
+    return NULL;
+  }
+  return PyLong_FromVoidPtr(osmesa.GetProcAddress(name));
+}
+
+static PyObject *OSMesa_meth_make_current(OSMesa *self, PyObject *args) {
+  if (osmesa_bind(self->context, &self->target, self->type) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject *OSMesa_meth_release(OSMesa *self, PyObject *args) {
+  if (osmesa.GetCurrentContext() == self->context) {
+    osmesa.MakeCurrent(NULL, NULL, GL_UNSIGNED_BYTE, 0, 0);
+  }
+  Py_RETURN_NONE;
+}
+
+// Swap the memory the default framebuffer lives in, e.g. the next slot of a
+// replay buffer. The size may change, the element type may not.
+static PyObject *OSMesa_meth_retarget(OSMesa *self, PyObject *arg) {
+  Py_buffer view;
+  int type = 0;
+  if (osmesa_get_target(arg, &view, &type) < 0) {
+    return NULL;
+  }
+  if (type != self->type) {
+    PyBuffer_Release(&view);
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] the new target must have the same dtype");
+    return NULL;
+  }
+  if (osmesa_bind(self->context, &view, type) < 0) {
+    PyBuffer_Release(&view);
+    return NULL;
+  }
+  PyBuffer_Release(&self->target);
+  self->target = view;
+  self->width = (int)view.shape[1];
+  self->height = (int)view.shape[0];
+  Py_RETURN_NONE;
+}
+
+// Pixels are only guaranteed to be in the target once rendering has finished
+static PyObject *OSMesa_meth_finish(OSMesa *self, PyObject *args) {
+  if (osmesa.GetCurrentContext() != self->context) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] the OSMesa context is not current");
+    return NULL;
+  }
+  if (osmesa.Finish) {
+    Py_BEGIN_ALLOW_THREADS;
+    osmesa.Finish();
+    Py_END_ALLOW_THREADS;
+  }
+  Py_RETURN_NONE;
+}
+
+#else
+
+static OSMesa *OSMesa_create(ModuleState *state, PyObject *target) {
+  PyErr_SetString(PyExc_RuntimeError,
+                  "[HyperGL] the built-in OSMesa backend is Linux only");
+  return NULL;
+}
 
 #endif
 
@@ -734,6 +1349,20 @@ static inline int to_int(PyObject *ptr) {
   return (int)val;
 }
 
+// Buffer sizes and offsets, which may exceed 2 GiB. Values that do not fit
+// become -1 so the range checks of the callers reject them.
+static inline Py_ssize_t to_size(PyObject *obj) {
+  if (!obj || obj == Py_None) {
+    return 0;
+  }
+  const Py_ssize_t val = PyLong_AsSsize_t(obj);
+  if (val == -1 && PyErr_Occurred()) {
+    PyErr_Clear();
+    return -1;
+  }
+  return val;
+}
+
 static inline unsigned to_uint(PyObject *obj) {
   if (!obj || obj == Py_None) {
     return 0;
@@ -760,6 +1389,14 @@ static inline float to_float(PyObject *obj) {
 
 static inline int least_one(int value) { return value > 1 ? value : 1; }
 
+// Compressed formats store whole blocks, pixel_size is the block size
+static inline Py_ssize_t image_data_size(const ImageFormat *fmt, int width,
+                                         int height) {
+  const int block = fmt->block;
+  return (Py_ssize_t)((width + block - 1) / block) *
+         ((height + block - 1) / block) * fmt->pixel_size;
+}
+
 #define FETCH_HELPER_DICT(st, helper, attr_name, out_var)                      \
   PyObject *out_var = PyObject_GetAttr(helper, (st)->str_##attr_name);         \
   if (!(out_var)) {                                                            \
@@ -827,6 +1464,7 @@ static int get_image_format(const ModuleState *state, PyObject *helper,
   res->pixel_size = to_int(TUP(IF_PIXEL_SIZE));
   res->color = to_int(TUP(IF_COLOR));
   res->flags = to_int(TUP(IF_FLAGS));
+  res->block = PyTuple_Size(tup) > IF_BLOCK ? to_int(TUP(IF_BLOCK)) : 1;
 
   res->clear_type = '\0';
   PyObject *ct = TUP(IF_CLEAR_TYPE);
@@ -1094,6 +1732,26 @@ static void gl_object_init(const Context *restrict ctx, GLObject *restrict obj,
   }
 }
 
+// The upload thread runs a second context from the same share group. Textures
+// and buffers are shared with it, container objects (framebuffers, vertex
+// arrays) and bindings are not, so it must leave the shadow state alone.
+static inline int on_upload_thread(const Context *ctx) {
+  long long ident = Atomic_Load64(&ctx->upload_thread_id);
+  return ident != 0 && ident == (long long)PyThread_get_thread_ident();
+}
+
+// While the render thread owns GL, every other thread but the upload thread
+// has to hand its GL work over to it
+static inline int off_render_thread(const Context *ctx) {
+  return ctx->render_ring &&
+         ctx->render_ring->thread_id != PyThread_get_thread_ident() &&
+         !on_upload_thread(ctx);
+}
+
+static PyObject *render_thread_call(Context *ctx, PyObject *self,
+                                    const char *name, PyObject *args,
+                                    PyObject *kwargs, int wait);
+
 // -----------------------------------------------------------------------------
 // Builders (Framebuffers, VAOs, Samplers, Programs)
 // -----------------------------------------------------------------------------
@@ -1268,7 +1926,7 @@ static GLObject *build_vertex_array(Context *self,
   for (int i = 1; i < length; i += 6) {
     Buffer *buffer = (Buffer *)PyTuple_GetItem(bindings, i + 0);
     int location = to_int(PyTuple_GetItem(bindings, i + 1));
-    int offset = to_int(PyTuple_GetItem(bindings, i + 2));
+    Py_ssize_t offset = to_size(PyTuple_GetItem(bindings, i + 2));
     int stride = to_int(PyTuple_GetItem(bindings, i + 3));
     int divisor = to_int(PyTuple_GetItem(bindings, i + 4));
     VertexFormat fmt;
@@ -1473,8 +2131,8 @@ static DescriptorSetBuffers build_descriptor_set_buffers(const Context *self,
       goto error_cleanup;
     }
 
-    int offset = to_int(PyTuple_GetItem(bindings, i + 2));
-    int size = to_int(PyTuple_GetItem(bindings, i + 3));
+    Py_ssize_t offset = to_size(PyTuple_GetItem(bindings, i + 2));
+    Py_ssize_t size = to_size(PyTuple_GetItem(bindings, i + 3));
 
     if (offset < 0 || size < 0) {
       PyErr_SetString(PyExc_ValueError,
@@ -1614,7 +2272,8 @@ static DescriptorSet *build_descriptor_set(Context *self, PyObject *bindings) {
   if (!res) {
     return NULL;
   }
-  zeromem(res, sizeof(*res));
+  // Keep the object header initialized by PyObject_New
+  zeromem((char *)res + sizeof(PyObject), sizeof(*res) - sizeof(PyObject));
 
   res->uniform_buffers =
       build_descriptor_set_buffers(self, PyTuple_GetItem(bindings, 0));
@@ -1685,7 +2344,7 @@ static GlobalSettings *build_global_settings(const Context *self,
   if (!res) {
     return NULL;
   }
-  zeromem(res, sizeof(*res));
+  zeromem((char *)res + sizeof(PyObject), sizeof(*res) - sizeof(PyObject));
 
   int it = 0;
   int length = (int)PyTuple_Size(settings);
@@ -1825,7 +2484,7 @@ static GLObject *compile_shader(Context *self, PyObject *pair) {
   }
   PyMutex_Unlock(&self->state_lock);
 
-  GLObject *res = PyObject_New(GLObject, self->module_state->GLObject_type);
+  GLObject *res = PyObject_GC_New(GLObject, self->module_state->GLObject_type);
   if (!res) {
     // Shader must be deleted since it won't be owned
     PyMutex_Lock(&self->state_lock);
@@ -1836,6 +2495,7 @@ static GLObject *compile_shader(Context *self, PyObject *pair) {
 
   // Use helper for SharedTrash linkage
   gl_object_init(self, res, shader, TRASH_SHADER);
+  PyObject_GC_Track(res);
 
   PyObject *existing = NULL;
   int result = PyDict_SetDefaultRef(self->shader_cache, pair, (PyObject *)res,
@@ -2071,12 +2731,13 @@ static GLObject *compile_compute_program(Context *self, PyObject *includes,
   }
   PyMutex_Unlock(&self->state_lock);
 
-  res = PyObject_New(GLObject, self->module_state->GLObject_type);
+  res = PyObject_GC_New(GLObject, self->module_state->GLObject_type);
   if (!res) {
     goto cleanup;
   }
 
   gl_object_init(self, res, program, TRASH_PROGRAM);
+  PyObject_GC_Track(res);
 
   res->extra = program_interface(self, program);
 
@@ -2196,12 +2857,13 @@ static GLObject *compile_program(Context *self, PyObject *includes,
   }
   PyMutex_Unlock(&self->state_lock);
 
-  res = PyObject_New(GLObject, self->module_state->GLObject_type);
+  res = PyObject_GC_New(GLObject, self->module_state->GLObject_type);
   if (!res) {
     goto cleanup;
   }
 
   gl_object_init(self, res, program, TRASH_PROGRAM);
+  PyObject_GC_Track(res);
 
   res->extra = program_interface(self, program);
   if (!res->extra) {
@@ -2245,6 +2907,19 @@ static ImageFace *build_image_face(Image *self, PyObject *key) // HAS GC_TRACK
     return (ImageFace *)cache_obj;
   }
 
+  if (on_upload_thread(self->ctx)) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] image faces cannot be created on the upload "
+                    "thread, framebuffers are not shared between contexts");
+    return NULL;
+  }
+  if (self->fmt.block > 1) {
+    PyErr_SetString(PyExc_TypeError,
+                    "[HyperGL] compressed images cannot be rendered to, they "
+                    "have no faces");
+    return NULL;
+  }
+
   int layer = to_int(PyTuple_GetItem(key, 0));
   int level = to_int(PyTuple_GetItem(key, 1));
 
@@ -2321,6 +2996,54 @@ static ImageFace *build_image_face(Image *self, PyObject *key) // HAS GC_TRACK
   return res;
 }
 
+// Layer 0 level 0. Faces are created on first use, an image that is only ever
+// sampled never owns a framebuffer.
+static ImageFace *image_base_face(Image *self) { // returns a new reference
+  PyObject *key = Py_BuildValue("(ii)", 0, 0);
+  if (!key) {
+    return NULL;
+  }
+  ImageFace *res = build_image_face(self, key);
+  Py_DECREF(key);
+  return res;
+}
+
+// Level 0 faces, one per layer. Only whole image clears and layered reads need
+// every layer, the tuple is built the first time one of them runs.
+static PyObject *image_layers(Image *self) { // returns a borrowed reference
+  PyObject *layers = Atomic_LoadPtr(&self->layers);
+  if (layers) {
+    return layers;
+  }
+
+  layers = PyTuple_New(self->layer_count);
+  if (!layers) {
+    return NULL;
+  }
+
+  for (int i = 0; i < self->layer_count; ++i) {
+    PyObject *key = Py_BuildValue("(ii)", i, 0);
+    if (!key) {
+      Py_DECREF(layers);
+      return NULL;
+    }
+    ImageFace *face = build_image_face(self, key);
+    Py_DECREF(key);
+    if (!face) {
+      Py_DECREF(layers);
+      return NULL;
+    }
+    PyTuple_SET_ITEM(layers, i, (PyObject *)face);
+  }
+
+  PyObject *existing = Atomic_CompareExchangePtr(&self->layers, NULL, layers);
+  if (existing) { // Race Lost
+    Py_DECREF(layers);
+    return existing;
+  }
+  return layers;
+}
+
 // -----------------------------------------------------------------------------
 // Image Manipulation Utilities
 // -----------------------------------------------------------------------------
@@ -2382,7 +3105,15 @@ static PyObject *blit_image_face(const ImageFace *src, PyObject *target_arg,
                    "[HyperGL] cannot blit to whole cubemap or array images");
       return NULL;
     }
-    target_arg = PyTuple_GetItem(image->layers, 0);
+    ImageFace *face = image_base_face(image);
+    if (!face) {
+      return NULL;
+    }
+    PyObject *res =
+        blit_image_face(src, (PyObject *)face, offset_arg, size_arg, crop_arg,
+                        filter);
+    Py_DECREF(face);
+    return res;
   }
 
   if (target_arg != Py_None &&
@@ -2501,49 +3232,113 @@ static int parse_size_and_offset(const ImageFace *self, PyObject *size_arg,
   return 1;
 }
 
+// Strided views GL can walk directly with a row length: every pixel row is
+// contiguous and rows are a whole number of pixels apart (a NumPy slice of a
+// larger canvas). Returns the row length in pixels, 0 for packed views and -1
+// for layouts that need a contiguous copy.
+static int view_row_length(const Py_buffer *view, int rows,
+                           Py_ssize_t row_bytes, int pixel_size) {
+  if (PyBuffer_IsContiguous(view, 'C')) {
+    return 0;
+  }
+  if (view->ndim < 2 || view->suboffsets || view->shape[0] != rows) {
+    return -1;
+  }
+
+  Py_ssize_t packed = view->itemsize;
+  for (int i = view->ndim - 1; i >= 1; --i) {
+    if (view->shape[i] > 1 && view->strides[i] != packed) {
+      return -1;
+    }
+    packed *= view->shape[i];
+  }
+
+  const Py_ssize_t stride = view->strides[0];
+  if (packed != row_bytes || stride < row_bytes || stride % pixel_size) {
+    return -1;
+  }
+  return (int)(stride / pixel_size);
+}
+
 static PyObject *read_image_face(ImageFace *src, IntPair size, IntPair offset,
-                                 PyObject *into) {
-  if (!src->ctx || src->ctx->is_lost) {
-    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
+                                 PyObject *into);
+static PyObject *read_image_face_as(ImageFace *src, IntPair size,
+                                    IntPair offset, PyObject *into, int format,
+                                    int pixel_size);
+static Image *Context_meth_image(Context *self, PyObject *args,
+                                 PyObject *kwargs);
+
+// Multisampled reads resolve into a single sampled image of the face size
+// kept in the context pool. The target leaves the pool while it is in use, so
+// concurrent readers never share one.
+static PyObject *read_multisampled_face(ImageFace *src, IntPair size,
+                                        IntPair offset, PyObject *into) {
+  Context *ctx = src->ctx;
+  PyObject *key =
+      Py_BuildValue("(iiO)", src->width, src->height, src->image->format);
+  if (!key) {
     return NULL;
   }
-  if (!src->framebuffer) {
-    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] invalid framebuffer");
+
+  PyObject *target = NULL;
+  if (PyDict_Pop(ctx->resolve_pool, key, &target) < 0) {
+    Py_DECREF(key);
     return NULL;
   }
-  if (src->image->samples > 1) {
-    PyObject *temp =
-        PyObject_CallMethod((PyObject *)src->image->ctx, "image", "((ii)O)",
-                            size.x, size.y, src->image->format);
-    if (!temp) {
+
+  if (!target) {
+    PyObject *image_kwargs = Py_BuildValue(
+        "{s(ii)sOsO}", "size", src->width, src->height, "format",
+        src->image->format, "texture", Py_False);
+    if (!image_kwargs) {
+      Py_DECREF(key);
       return NULL;
     }
-
-    // Perform Resolve
-    PyObject *blit = PyObject_CallMethod(
-        (PyObject *)src, "blit", "(O(ii)(ii)(iiii))", temp, 0, 0, size.x,
-        size.y, offset.x, offset.y, size.x, size.y);
-    if (!blit) {
-      Py_DECREF(temp);
+    target = (PyObject *)Context_meth_image(ctx, ctx->module_state->empty_tuple,
+                                            image_kwargs);
+    Py_DECREF(image_kwargs);
+    if (!target) {
+      Py_DECREF(key);
       return NULL;
     }
-    Py_DECREF(blit);
+  }
 
-    // Read from Resolved
-    PyObject *res =
-        PyObject_CallMethod(temp, "read", "(OOO)", Py_None, Py_None, into);
+  PyObject *res = NULL;
+  ImageFace *face = image_base_face((Image *)target);
+  PyObject *region = Py_BuildValue("(ii)", offset.x, offset.y);
+  PyObject *extent = Py_BuildValue("(ii)", size.x, size.y);
+  PyObject *crop =
+      Py_BuildValue("(iiii)", offset.x, offset.y, size.x, size.y);
+
+  if (face && region && extent && crop) {
+    PyObject *blit =
+        blit_image_face(src, (PyObject *)face, region, extent, crop, 0);
+    if (blit) {
+      Py_DECREF(blit);
+      res = read_image_face(face, size, offset, into);
+    }
+  }
 
-    // Return temp to pool (Using 'O' so we keep ownership for the manual DECREF
-    // below)
-    PyObject *release = PyObject_CallMethod((PyObject *)src->image->ctx,
-                                            "release", "(O)", temp);
-    Py_XDECREF(release);
-    Py_DECREF(temp);
+  Py_XDECREF(crop);
+  Py_XDECREF(extent);
+  Py_XDECREF(region);
+  Py_XDECREF(face);
 
-    return res; // res is NULL if the 'read' call failed, which is correct
+  PyObject *existing = NULL;
+  if (PyDict_SetDefaultRef(ctx->resolve_pool, key, target, &existing) < 0) {
+    Py_CLEAR(res);
   }
+  Py_XDECREF(existing);
+  Py_DECREF(target);
+  Py_DECREF(key);
+  return res;
+}
 
-  int write_size = size.x * size.y * src->image->fmt.pixel_size;
+// Reads with an explicit pixel transfer format, the type stays the image's
+static PyObject *read_image_face_as(ImageFace *src, IntPair size,
+                                    IntPair offset, PyObject *into, int format,
+                                    int pixel_size) {
+  Py_ssize_t write_size = (Py_ssize_t)size.x * size.y * pixel_size;
 
   if (into == Py_None) {
     PyObject *res = PyBytes_FromStringAndSize(NULL, write_size);
@@ -2553,7 +3348,8 @@ static PyObject *read_image_face(ImageFace *src, IntPair size, IntPair offset,
 
     PyMutex_Lock(&src->ctx->state_lock);
     bind_read_framebuffer_internal(src->ctx, src->framebuffer->obj);
-    glReadPixels(offset.x, offset.y, size.x, size.y, src->image->fmt.format,
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(offset.x, offset.y, size.x, size.y, format,
                  src->image->fmt.type, PyBytes_AsString(res));
     PyMutex_Unlock(&src->ctx->state_lock);
     return res;
@@ -2577,7 +3373,7 @@ static PyObject *read_image_face(ImageFace *src, IntPair size, IntPair offset,
     PyMutex_Lock(&src->ctx->state_lock);
     bind_read_framebuffer_internal(src->ctx, src->framebuffer->obj);
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
-    glReadPixels(offset.x, offset.y, size.x, size.y, src->image->fmt.format,
+    glReadPixels(offset.x, offset.y, size.x, size.y, format,
                  src->image->fmt.type, ptr);
     PyMutex_Unlock(&src->ctx->state_lock);
     Py_DECREF(buffer_view);
@@ -2585,72 +3381,60 @@ static PyObject *read_image_face(ImageFace *src, IntPair size, IntPair offset,
   }
 
   Py_buffer view;
-  if (PyObject_GetBuffer(into, &view, PyBUF_WRITABLE)) {
+  if (PyObject_GetBuffer(into, &view, PyBUF_WRITABLE | PyBUF_STRIDES)) {
     return NULL;
   }
 
-  if (write_size > (int)view.len) {
+  if (write_size > view.len) {
     PyBuffer_Release(&view);
     PyErr_Format(PyExc_ValueError, "[HyperGL] invalid write size");
     return NULL;
   }
 
+  const int row_length = view_row_length(
+      &view, size.y, (Py_ssize_t)size.x * pixel_size, pixel_size);
+  if (row_length < 0) {
+    PyBuffer_Release(&view);
+    PyErr_Format(PyExc_BufferError,
+                 "[HyperGL] into must be contiguous or have one row of "
+                 "pixels per outer index");
+    return NULL;
+  }
+
   PyMutex_Lock(&src->ctx->state_lock);
   bind_read_framebuffer_internal(src->ctx, src->framebuffer->obj);
-  glReadPixels(offset.x, offset.y, size.x, size.y, src->image->fmt.format,
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glPixelStorei(GL_PACK_ROW_LENGTH, row_length);
+  glReadPixels(offset.x, offset.y, size.x, size.y, format,
                src->image->fmt.type, view.buf);
+  glPixelStorei(GL_PACK_ROW_LENGTH, 0);
   PyMutex_Unlock(&src->ctx->state_lock);
 
   PyBuffer_Release(&view);
   Py_RETURN_NONE;
 }
 
+static PyObject *read_image_face(ImageFace *src, IntPair size, IntPair offset,
+                                 PyObject *into) {
+  if (!src->ctx || src->ctx->is_lost) {
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
+    return NULL;
+  }
+  if (!src->framebuffer) {
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] invalid framebuffer");
+    return NULL;
+  }
+  if (src->image->samples > 1) {
+    return read_multisampled_face(src, size, offset, into);
+  }
+  return read_image_face_as(src, size, offset, into, src->image->fmt.format,
+                            src->image->fmt.pixel_size);
+}
+
 // -----------------------------------------------------------------------------
 // Initialization & Module Loading
 // -----------------------------------------------------------------------------
 
-static int init_gl_limits(ModuleState *state) {
-  // Zero first so missing queries are obvious in debug
-  memset(&state->limits, 0, sizeof(Limits));
-
-  glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS,
-                &state->limits.max_uniform_buffer_bindings);
-
-  glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE,
-                &state->limits.max_uniform_block_size);
-
-  glGetIntegerv(GL_MAX_COMBINED_UNIFORM_BLOCKS,
-                &state->limits.max_combined_uniform_blocks);
-
-  glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS,
-                &state->limits.max_combined_texture_image_units);
-
-  glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &state->limits.max_vertex_attribs);
-
-  glGetIntegerv(GL_MAX_DRAW_BUFFERS, &state->limits.max_draw_buffers);
-
-  glGetIntegerv(GL_MAX_SAMPLES, &state->limits.max_samples);
-
-  // Only exists on newer GL — guard it
-#ifdef GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS
-  glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS,
-                &state->limits.max_shader_storage_buffer_bindings);
-#else
-  state->limits.max_shader_storage_buffer_bindings = 0;
-#endif
-
-#ifdef DEBUG
-  GLenum err = glGetError();
-  if (err != GL_NO_ERROR) {
-    PyErr_Format(PyExc_RuntimeError,
-                 "[HyperGL] OpenGL error while querying limits (0x%x)", err);
-    return -1;
-  }
-#endif
-
-  return 0;
-}
-
 static int init_internal(ModuleState *module_state, PyObject *module_obj,
                          PyObject *loader) {
   PyObject *new_loader = NULL;
@@ -2678,7 +3462,7 @@ static int init_internal(ModuleState *module_state, PyObject *module_obj,
 
   // Load OpenGL (Must be done on main thread usually, but here we assume caller
   // handles thread affinity)
-  if (load_gl(new_loader) < 0) {
+  if (load_gl(module_state, new_loader, 0) < 0) {
     Py_DECREF(new_loader);
     return -1;
   }
@@ -2690,10 +3474,7 @@ static int init_internal(ModuleState *module_state, PyObject *module_obj,
   module_state->default_loader = new_loader;
   module_state->default_context = new_ref(Py_None);
 
-  if (init_gl_limits(module_state) < 0) {
-    return -1;
-  }
-
+  // Limits are queried per context, in Context_new
   module_state->gl_initialized = 1;
 
   Py_XDECREF(old_loader);
@@ -2702,8 +3483,9 @@ static int init_internal(ModuleState *module_state, PyObject *module_obj,
 }
 
 static PyObject *meth_init(PyObject *self, PyObject *args, PyObject *kwargs) {
-  static char *keywords[] = {"loader", "headless", NULL};
+  static char *keywords[] = {"loader", "headless", "target", NULL};
   PyObject *loader = Py_None;
+  PyObject *target = Py_None;
   PyObject *new_loader = NULL;
   int headless = 0;
 
@@ -2712,8 +3494,8 @@ static PyObject *meth_init(PyObject *self, PyObject *args, PyObject *kwargs) {
     return NULL;
   }
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|Op", keywords, &loader,
-                                   &headless)) {
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OpO", keywords, &loader,
+                                   &headless, &target)) {
     return NULL;
   }
 
@@ -2722,6 +3504,8 @@ static PyObject *meth_init(PyObject *self, PyObject *args, PyObject *kwargs) {
   // 1. Resolve Loader
   if (loader != Py_None) {
     new_loader = Py_NewRef(loader);
+  } else if (target != Py_None) {
+    new_loader = (PyObject *)OSMesa_create(module_state, target);
   } else {
     int use_python_loader = 1;
 #ifdef _WIN64
@@ -2730,7 +3514,9 @@ static PyObject *meth_init(PyObject *self, PyObject *args, PyObject *kwargs) {
     }
 #endif
 
-    if (use_python_loader) {
+    if (use_python_loader && headless) {
+      new_loader = headless_loader(module_state);
+    } else if (use_python_loader) {
       new_loader =
           PyObject_CallMethod(module_state->helper, "loader", "(i)", headless);
     } else {
@@ -2769,6 +3555,17 @@ finally:
   Py_RETURN_NONE;
 }
 
+// Offset alignments are powers of two up to 256, the safe value otherwise
+static int get_alignment(const int pname) {
+  int value = 0;
+  glGetIntegerv(pname, &value);
+  if (glGetError() != GL_NO_ERROR || value <= 0 || value > 256 ||
+      (value & (value - 1))) {
+    return 256;
+  }
+  return value;
+}
+
 static int get_limit(const int pname, const int min, const int max) {
   int value = 0;
   glGetIntegerv(pname, &value);
@@ -2848,115 +3645,249 @@ static void safe_decref_list(Context *self, PyObject **list, int count,
   }
 }
 
+// Monotonic seconds, only used to budget the deletion queue
+static double trash_clock(void) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, now;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&now);
+  return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Issue one glDelete* call for a group of ids of the same type
+static void delete_trash_ids(int type, const GLuint *ids, int count) {
+  if (count <= 0) {
+    return;
+  }
+  switch (type) {
+  case TRASH_BUFFER:
+    glDeleteBuffers(count, ids);
+    break;
+  case TRASH_TEXTURE:
+    glDeleteTextures(count, ids);
+    break;
+  case TRASH_RENDERBUFFER:
+    glDeleteRenderbuffers(count, ids);
+    break;
+  case TRASH_FRAMEBUFFER:
+    glDeleteFramebuffers(count, ids);
+    break;
+  case TRASH_VERTEX_ARRAY:
+    glDeleteVertexArrays(count, ids);
+    break;
+  case TRASH_SAMPLER:
+    glDeleteSamplers(count, ids);
+    break;
+  case TRASH_QUERY:
+    glDeleteQueries(count, ids);
+    break;
+  case TRASH_PROGRAM:
+    for (int i = 0; i < count; ++i) {
+      glDeleteProgram(ids[i]);
+    }
+    break;
+  case TRASH_SHADER:
+    for (int i = 0; i < count; ++i) {
+      glDeleteShader(ids[i]);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+static void free_trash_nodes(TrashNode *node) {
+  while (node) {
+    TrashNode *next = node->next;
+    PyMem_RawFree(node);
+    node = next;
+  }
+}
+
 // Flush Trash using SharedTrash (Thread-Safe)
-void flush_trash(const Context *self) {
+// Ids are grouped by type and deleted TRASH_FLUSH_BATCH at a time. A positive
+// budget (seconds) stops the flush early, the rest stays queued for the next
+// frame. A budget of 0 drains everything.
+void flush_trash(const Context *self, double budget) {
   SharedTrash *shared = self->trash_shared;
   if (!shared) {
     return;
   }
 
-  TrashItem *to_delete = NULL;
-  size_t count = 0;
-  // int invalid_type = 0;
+  TrashItem reserve[SHARED_TRASH_RESERVE];
+  size_t reserve_count = 0;
 
-  // CRITICAL SECTION: Just swap the pointer!
+  // Producers never touch the lock, it only serializes consumers
   PyMutex_Lock(&shared->lock);
-  if (shared->count > 0) {
-    count = shared->count;
-    to_delete = shared->bin; // Steal the full bin
-
-    // Allocate a new empty bin for the producers
-    size_t old_capacity = shared->capacity;
-    shared->bin = PyMem_Malloc(old_capacity * sizeof(TrashItem));
-    if (shared->bin) {
-      shared->capacity = old_capacity;
-      shared->count = 0;
-    } else {
-      shared->bin = to_delete;
-      shared->count = count;
-      to_delete = NULL;
-    }
+  TrashNode *work = shared->pending;
+  shared->pending = NULL;
+  TrashNode *incoming = Atomic_ExchangePtr(&shared->head, NULL);
+  while (incoming) {
+    TrashNode *next = incoming->next;
+    incoming->next = work;
+    work = incoming;
+    incoming = next;
+  }
+  if (shared->reserve_count) {
+    reserve_count = shared->reserve_count;
+    memcpy(reserve, shared->reserve, reserve_count * sizeof(TrashItem));
+    shared->reserve_count = 0;
   }
   PyMutex_Unlock(&shared->lock);
 
-  if (!to_delete) {
+  if (!work && !reserve_count) {
     return;
   }
 
   if (self->is_lost) {
-    PyMem_Free(to_delete);
+    free_trash_nodes(work);
     return;
   }
+
+  GLuint ids[TRASH_TYPE_COUNT][TRASH_FLUSH_BATCH];
+  int counts[TRASH_TYPE_COUNT] = {0};
+  double deadline = budget > 0.0 ? trash_clock() + budget : 0.0;
+
   // Delete OpenGL resources OUTSIDE the lock
-  Py_BEGIN_ALLOW_THREADS for (size_t i = 0; i < count; i++) {
-    unsigned int id = (unsigned int)to_delete[i].id;
-    if (id == 0) {
+  Py_BEGIN_ALLOW_THREADS
+  for (size_t i = 0; i < reserve_count; ++i) {
+    int type = reserve[i].type;
+    if (type <= 0 || type >= TRASH_TYPE_COUNT) {
       continue;
     }
-    switch (to_delete[i].type) {
-    case TRASH_BUFFER:
-      glDeleteBuffers(1, &id);
-      break;
-    case TRASH_TEXTURE:
-      glDeleteTextures(1, &id);
-      break;
-    case TRASH_RENDERBUFFER:
-      glDeleteRenderbuffers(1, &id);
-      break;
-    case TRASH_FRAMEBUFFER:
-      glDeleteFramebuffers(1, &id);
-      break;
-    case TRASH_VERTEX_ARRAY:
-      glDeleteVertexArrays(1, &id);
-      break;
-    case TRASH_PROGRAM:
-      glDeleteProgram(id);
-      break;
-    case TRASH_SHADER:
-      glDeleteShader(id);
-      break;
-    case TRASH_SAMPLER:
-      glDeleteSamplers(1, &id);
-      break;
-    case TRASH_QUERY:
-      glDeleteQueries(1, &id);
-      break;
-    default: {
-      continue;
+    ids[type][counts[type]++] = (GLuint)reserve[i].id;
+    if (counts[type] == TRASH_FLUSH_BATCH) {
+      delete_trash_ids(type, ids[type], counts[type]);
+      counts[type] = 0;
+    }
+  }
+
+  while (work) {
+    for (int n = 0; work && n < TRASH_FLUSH_BATCH; ++n) {
+      TrashNode *node = work;
+      work = node->next;
+      int type = node->type;
+      if (type == TRASH_SYNC) {
+        glDeleteSync(node->sync);
+      } else if (type > 0 && type < TRASH_TYPE_COUNT) {
+        ids[type][counts[type]++] = (GLuint)node->id;
+        if (counts[type] == TRASH_FLUSH_BATCH) {
+          delete_trash_ids(type, ids[type], counts[type]);
+          counts[type] = 0;
+        }
+      }
+      PyMem_RawFree(node);
     }
+    if (deadline > 0.0 && trash_clock() >= deadline) {
+      break;
     }
   }
+
+  for (int type = 1; type < TRASH_TYPE_COUNT; ++type) {
+    delete_trash_ids(type, ids[type], counts[type]);
+  }
   Py_END_ALLOW_THREADS
 
-      PyMem_Free(to_delete);
+  if (work) {
+    // Out of budget, hand the remainder to the next flush
+    PyMutex_Lock(&shared->lock);
+    if (shared->pending) {
+      TrashNode *tail = shared->pending;
+      while (tail->next) {
+        tail = tail->next;
+      }
+      tail->next = work;
+    } else {
+      shared->pending = work;
+    }
+    PyMutex_Unlock(&shared->lock);
+  }
+}
+
+static void push_trash_node(SharedTrash *trash, TrashNode *node) {
+  TrashNode *head;
+  do {
+    head = Atomic_LoadPtr(&trash->head);
+    node->next = head;
+  } while (Atomic_CompareExchangePtr(&trash->head, head, node) != head);
 }
 
+// Lock-free push, callable from any thread (including deallocators running
+// without an attached thread state)
 static void enqueue_trash(SharedTrash *trash, int id, int type) {
   if (!trash || id <= 0) { // assumes all GL objects are unsigned
     return;
   }
 
-  PyMutex_Lock(&trash->lock);
-
-  if (trash->count >= trash->capacity) {
-    size_t old_cap = trash->capacity;
-    size_t new_cap = old_cap ? old_cap * 2 : 64;
+  TrashNode *node = PyMem_RawMalloc(sizeof(TrashNode));
+  if (UNLIKELY(!node)) {
+    // Out of memory: park the id inline rather than leaking the GL object.
+    // Deallocators may run on any thread with any context current, so once
+    // the reserve is full the name is leaked and counted in ctx.info.
+    PyMutex_Lock(&trash->lock);
+    if (trash->reserve_count < SHARED_TRASH_RESERVE) {
+      trash->reserve[trash->reserve_count++] = (TrashItem){id, type};
+    } else {
+      Atomic_Increment(&trash->leaked);
+    }
+    PyMutex_Unlock(&trash->lock);
+    return;
+  }
 
-    TrashItem *new_bin = PyMem_Realloc(trash->bin, new_cap * sizeof(TrashItem));
+  node->sync = NULL;
+  node->id = id;
+  node->type = type;
+  push_trash_node(trash, node);
+}
 
-    if (!new_bin) {
-      // Allocation failed → drop item (lossy but safe)
-      PyMutex_Unlock(&trash->lock);
-      return;
-    }
+// Sync objects have no integer name, so they skip the inline reserve. If the
+// node cannot be allocated the sync is leaked rather than deleted off-context.
+static void enqueue_trash_sync(SharedTrash *trash, void *sync) {
+  if (!trash || !sync) {
+    return;
+  }
 
-    trash->bin = new_bin;
-    trash->capacity = new_cap;
+  TrashNode *node = PyMem_RawMalloc(sizeof(TrashNode));
+  if (UNLIKELY(!node)) {
+    Atomic_Increment(&trash->leaked);
+    return;
   }
 
-  trash->bin[trash->count++] = (TrashItem){id, type};
+  node->sync = sync;
+  node->id = 0;
+  node->type = TRASH_SYNC;
+  push_trash_node(trash, node);
+}
+
+// Called once the last reference (Context or GLObject) lets go
+static void free_shared_trash(SharedTrash *trash) {
+  free_trash_nodes(trash->head);
+  free_trash_nodes(trash->pending);
+  PyMem_Free(trash);
+}
+
+// Drop recorded encoder commands without running them
+static void release_encoder_commands(EncoderCommand *commands, int count) {
+  for (int i = 0; i < count; ++i) {
+    Py_XDECREF(commands[i].target);
+    Py_XDECREF(commands[i].args);
+    Py_XDECREF(commands[i].kwargs);
+  }
+}
 
-  PyMutex_Unlock(&trash->lock);
+static void release_encoder_batches(EncoderBatch *batch) {
+  while (batch) {
+    EncoderBatch *next = batch->next;
+    release_encoder_commands(batch->commands, batch->count);
+    PyMem_Free(batch->commands);
+    PyMem_Free(batch);
+    batch = next;
+  }
 }
 
 static void release_descriptor_set(Context *self, DescriptorSet *set,
@@ -3135,13 +4066,24 @@ static int Context_traverse(Context *self, visitproc visit, void *arg) {
   Py_VISIT(self->program_cache);
   Py_VISIT(self->shader_cache);
   Py_VISIT(self->includes);
+  Py_VISIT(self->resolve_pool);
   Py_VISIT(self->info_dict);
+  Py_VISIT(self->loader);
 
   // Visit custom structs that start with PyObject_HEAD
   Py_VISIT((PyObject *)self->default_framebuffer);
   Py_VISIT((PyObject *)self->current_descriptor_set);
   Py_VISIT((PyObject *)self->current_global_settings);
 
+  // Submitted encoder batches hold references to resources
+  for (EncoderBatch *batch = self->encoder_head; batch; batch = batch->next) {
+    for (int i = 0; i < batch->count; ++i) {
+      Py_VISIT(batch->commands[i].target);
+      Py_VISIT(batch->commands[i].args);
+      Py_VISIT(batch->commands[i].kwargs);
+    }
+  }
+
   // SharedTrash is malloc'd C struct, not visited
   return 0;
 }
@@ -3155,12 +4097,18 @@ static int Context_clear(Context *self) {
   Py_CLEAR(self->program_cache);
   Py_CLEAR(self->shader_cache);
   Py_CLEAR(self->includes);
+  Py_CLEAR(self->resolve_pool);
   Py_CLEAR(self->info_dict);
 
   Py_CLEAR(self->default_framebuffer);
   Py_CLEAR(self->current_descriptor_set);
   Py_CLEAR(self->current_global_settings);
 
+  EncoderBatch *batch = self->encoder_head;
+  self->encoder_head = NULL;
+  self->encoder_tail = NULL;
+  release_encoder_batches(batch);
+
   return 0;
 }
 
@@ -3171,10 +4119,46 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
   INTERNAL_CHECK(module_state,
                  "Could not retrieve module state from Context type");
 
+  static char *keywords[] = {"loader", "headless", "target", NULL};
+  PyObject *loader = Py_None;
+  PyObject *target = Py_None;
+  int headless = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OpO", keywords, &loader,
+                                   &headless, &target)) {
+    return NULL;
+  }
+
+  // Context() is the process wide default. Context(headless=True),
+  // Context(target=array) or Context(loader=...) is an independent context with
+  // its own caches, trash and state shadow, bound to the calling thread.
+  PyObject *own_loader = NULL;
+  if (loader != Py_None) {
+    own_loader = Py_NewRef(loader);
+  } else if (target != Py_None) {
+    own_loader = (PyObject *)OSMesa_create(module_state, target);
+    if (!own_loader) {
+      return NULL;
+    }
+  } else if (headless) {
+    own_loader = headless_loader(module_state);
+    if (!own_loader) {
+      return NULL;
+    }
+  }
+
   PyMutex_Lock(&module_state->setup_lock);
 
-  // Singleton check
-  if (module_state->default_context != Py_None) {
+  if (own_loader) {
+    // One function table serves every context, check the new one agrees
+    if (load_gl(module_state, own_loader, module_state->gl_initialized) < 0) {
+      Py_DECREF(own_loader);
+      PyMutex_Unlock(&module_state->setup_lock);
+      return NULL;
+    }
+    module_state->gl_initialized = 1;
+  } else if (module_state->default_context != Py_None) {
+    // Singleton check
     PyObject *existing = Py_NewRef(module_state->default_context);
     PyMutex_Unlock(&module_state->setup_lock);
     return existing;
@@ -3204,6 +4188,7 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
   // Allocate default framebuffer wrapper
   if (!module_state->GLObject_type) {
     PyErr_SetString(PyExc_RuntimeError, "[HyperGL] GLObject_type is NULL");
+    Py_XDECREF(own_loader);
     PyMutex_Unlock(&module_state->setup_lock);
     return NULL;
   }
@@ -3211,6 +4196,7 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
   GLObject *default_framebuffer =
       PyObject_GC_New(GLObject, module_state->GLObject_type);
   if (!default_framebuffer) {
+    Py_XDECREF(own_loader);
     PyMutex_Unlock(&module_state->setup_lock);
     return NULL;
   }
@@ -3223,11 +4209,16 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
   Context *res = (Context *)type->tp_alloc(type, 0);
   if (!res) {
     Py_DECREF(default_framebuffer);
+    Py_XDECREF(own_loader);
     PyMutex_Unlock(&module_state->setup_lock);
     return NULL;
   }
 
   res->thread_id = PyThread_get_thread_ident();
+  res->loader = own_loader;
+  if (own_loader) {
+    Atomic_Increment(&module_state->independent_contexts);
+  }
 
   PyObject_GC_UnTrack((PyObject *)res);
 
@@ -3240,6 +4231,7 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
   res->program_cache = NULL;
   res->shader_cache = NULL;
   res->includes = NULL;
+  res->resolve_pool = NULL;
   res->framebuffer_cache = NULL;
 
   // --- Shared Trash Allocation ---
@@ -3251,20 +4243,8 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
     return PyErr_NoMemory();
   }
 
-  shared->bin = PyMem_Malloc(SHARED_TRASH_INITIAL_CAPACITY * sizeof(TrashItem));
-  if (!shared->bin) {
-    PyMem_Free(shared);
-    Py_DECREF(res);
-    Py_DECREF(default_framebuffer);
-    PyMutex_Unlock(&module_state->setup_lock);
-    return PyErr_NoMemory();
-  }
-
-  // Initialize the mutex in the shared struct (Zeroing it is enough for
-  // PyMutex)
-  memset(&shared->lock, 0, sizeof(PyMutex));
-  shared->count = 0;
-  shared->capacity = SHARED_TRASH_INITIAL_CAPACITY;
+  // Zeroing is enough for the PyMutex, the empty stack and the reserve
+  memset(shared, 0, sizeof(SharedTrash));
   shared->ref_count = 1; // 1 ref held by the Context itself
   res->trash_shared = shared;
 
@@ -3276,11 +4256,13 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
   res->program_cache = PyDict_New();
   res->shader_cache = PyDict_New();
   res->includes = PyDict_New();
+  res->resolve_pool = PyDict_New();
   res->framebuffer_cache = Py_BuildValue("{OO}", Py_None, default_framebuffer);
 
   if (!res->descriptor_set_cache || !res->global_settings_cache ||
       !res->sampler_cache || !res->vertex_array_cache || !res->program_cache ||
-      !res->shader_cache || !res->includes || !res->framebuffer_cache) {
+      !res->shader_cache || !res->includes || !res->resolve_pool ||
+      !res->framebuffer_cache) {
     goto fail;
   }
 
@@ -3296,21 +4278,33 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
   }
 
   // --- Fill Limits ---
-  res->module_state->limits.max_uniform_buffer_bindings =
+  res->limits.max_uniform_buffer_bindings =
       get_limit(GL_MAX_UNIFORM_BUFFER_BINDINGS, MIN_BUFFER_BINDINGS, MAX_BUFFER_BINDINGS);
-  res->module_state->limits.max_uniform_block_size =
+  res->limits.max_uniform_block_size =
       get_limit(GL_MAX_UNIFORM_BLOCK_SIZE, GL_MIN_UBO_SIZE, GL_MAX_UBO_SIZE);
-  res->module_state->limits.max_combined_uniform_blocks =
+  res->limits.max_combined_uniform_blocks =
       get_limit(GL_MAX_COMBINED_UNIFORM_BLOCKS, GL_MIN_UNIFORM_BUFFER_BINDINGS, MAX_BUFFER_BINDINGS);
-  res->module_state->limits.max_combined_texture_image_units =
+  res->limits.max_combined_texture_image_units =
       get_limit(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, GL_MIN_UNIFORM_BUFFER_BINDINGS, MAX_SAMPLER_BINDINGS);
-  res->module_state->limits.max_vertex_attribs =
+  res->limits.max_vertex_attribs =
       get_limit(GL_MAX_VERTEX_ATTRIBS, GL_MIN_UNIFORM_BUFFER_BINDINGS, GL_ENGINE_MAX_VERTEX_ATTRIBS);
-  res->module_state->limits.max_draw_buffers =
+  res->limits.max_draw_buffers =
       get_limit(GL_MAX_DRAW_BUFFERS, GL_MIN_UNIFORM_BUFFER_BINDINGS, GL_ENGINE_MAX_VERTEX_ATTRIBS);
-  res->module_state->limits.max_samples = get_limit(GL_MAX_SAMPLES, HGL_MIN_SAMPLES, HGL_MAX_SAMPLES);
-  res->module_state->limits.max_shader_storage_buffer_bindings =
+  res->limits.max_samples = get_limit(GL_MAX_SAMPLES, HGL_MIN_SAMPLES, HGL_MAX_SAMPLES);
+  res->limits.max_texture_size =
+      get_limit(GL_MAX_TEXTURE_SIZE, HGL_MIN_TEXTURE_SIZE, HGL_MAX_TEXTURE_SIZE);
+  res->limits.max_cube_map_texture_size = get_limit(
+      GL_MAX_CUBE_MAP_TEXTURE_SIZE, HGL_MIN_TEXTURE_SIZE, HGL_MAX_TEXTURE_SIZE);
+  res->limits.max_renderbuffer_size = get_limit(
+      GL_MAX_RENDERBUFFER_SIZE, HGL_MIN_TEXTURE_SIZE, HGL_MAX_TEXTURE_SIZE);
+  res->limits.max_array_texture_layers = get_limit(
+      GL_MAX_ARRAY_TEXTURE_LAYERS, HGL_MIN_ARRAY_LAYERS, HGL_MAX_ARRAY_LAYERS);
+  res->limits.max_shader_storage_buffer_bindings =
       get_limit(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, 0, MAX_BUFFER_BINDINGS);
+  res->limits.uniform_buffer_offset_alignment =
+      get_alignment(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+  res->limits.storage_buffer_offset_alignment =
+      get_alignment(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT);
 
   const char *raw_version = glGetString(GL_VERSION);
   const char *raw_vendor = glGetString(GL_VENDOR);
@@ -3333,16 +4327,16 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
       "renderer", raw_renderer ? raw_renderer : "Unknown", "version",
       raw_version ? raw_version : "Unknown", "glsl",
       raw_glsl ? raw_glsl : "Unknown", "max_uniform_buffer_bindings",
-      res->module_state->limits.max_uniform_buffer_bindings,
+      res->limits.max_uniform_buffer_bindings,
       "max_uniform_block_size",
-      res->module_state->limits.max_uniform_block_size,
+      res->limits.max_uniform_block_size,
       "max_combined_uniform_blocks",
-      res->module_state->limits.max_combined_uniform_blocks,
+      res->limits.max_combined_uniform_blocks,
       "max_combined_texture_image_units",
-      res->module_state->limits.max_combined_texture_image_units,
-      "max_vertex_attribs", res->module_state->limits.max_vertex_attribs,
-      "max_draw_buffers", res->module_state->limits.max_draw_buffers,
-      "max_samples", res->module_state->limits.max_samples);
+      res->limits.max_combined_texture_image_units,
+      "max_vertex_attribs", res->limits.max_vertex_attribs,
+      "max_draw_buffers", res->limits.max_draw_buffers,
+      "max_samples", res->limits.max_samples);
   if (!tmp) {
     goto fail;
   }
@@ -3355,7 +4349,9 @@ static PyObject *Context_new(PyTypeObject *type, PyObject *args,
     res->default_texture_unit = 1;
   }
 
-  Py_XSETREF(module_state->default_context, Py_NewRef((PyObject *)res));
+  if (!own_loader) {
+    Py_XSETREF(module_state->default_context, Py_NewRef((PyObject *)res));
+  }
   Py_DECREF(default_framebuffer);
   PyMutex_Unlock(&module_state->setup_lock);
 
@@ -3383,6 +4379,12 @@ static PyObject *meth_context(PyObject *self, PyObject *arg) {
 static PyObject *Context_meth_migrate(Context *self, PyObject *arg) {
     // Update the internal thread ID to the current thread.
     // Call this once at the start of your Render Thread loop.
+    if (self->render_ring) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "[HyperGL] the render thread owns the context, call "
+                        "stop_render_thread() first");
+        return NULL;
+    }
     self->thread_id = PyThread_get_thread_ident();
     Py_RETURN_NONE;
 }
@@ -3393,22 +4395,61 @@ static PyObject *Context_meth_migrate(Context *self, PyObject *arg) {
 
 static Buffer *Context_meth_buffer(Context *self, PyObject *args,
                                    PyObject *kwargs) {
-  static char *keywords[] = {"data",    "size",    "access",   "index",
-                             "uniform", "storage", "external", NULL};
+  static char *keywords[] = {"data",     "size",   "access",   "index",
+                             "uniform",  "storage", "external", "mapped",
+                             "coherent", NULL};
+
+  if (off_render_thread(self)) {
+    return (Buffer *)render_thread_call(self, (PyObject *)self, "buffer",
+                                        args, kwargs, 1);
+  }
 
   PyObject *data = Py_None;               // borrowed
   PyObject *contiguous_data = NULL;      // owned
   PyObject *size_arg = Py_None;
   PyObject *access_arg = Py_None;
+  PyObject *mapped_arg = Py_None;
   int index = 0;
   int uniform = 0;
   int storage = 0;
   int external = 0;
-
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O$OOpppi", keywords, &data,
-                                   &size_arg, &access_arg, &index, &uniform,
-                                   &storage, &external)) {
-    return NULL;
+  int coherent = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O$OOpppiOp", keywords,
+                                   &data, &size_arg, &access_arg, &index,
+                                   &uniform, &storage, &external, &mapped_arg,
+                                   &coherent)) {
+    return NULL;
+  }
+
+  // Persistent mappings need immutable storage, allocated for any target
+  int map_access = 0;
+  if (mapped_arg != Py_None) {
+    const char *mapped = PyUnicode_Check(mapped_arg)
+                             ? PyUnicode_AsUTF8(mapped_arg)
+                             : NULL;
+    if (mapped && !strcmp(mapped, "read")) {
+      map_access = GL_MAP_READ_BIT;
+    } else if (mapped && !strcmp(mapped, "write")) {
+      map_access = GL_MAP_WRITE_BIT;
+    } else if (mapped && !strcmp(mapped, "readwrite")) {
+      map_access = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
+    } else {
+      PyErr_Format(PyExc_ValueError,
+                   "[HyperGL] mapped must be 'read', 'write' or 'readwrite'");
+      return NULL;
+    }
+    if (external) {
+      PyErr_Format(PyExc_ValueError,
+                   "[HyperGL] external buffers cannot be mapped");
+      return NULL;
+    }
+    map_access |= GL_MAP_PERSISTENT_BIT;
+    if (coherent) {
+      map_access |= GL_MAP_COHERENT_BIT;
+    } else if (map_access & GL_MAP_WRITE_BIT) {
+      map_access |= GL_MAP_FLUSH_EXPLICIT_BIT;
+    }
   }
 
   if (self->is_lost) {
@@ -3431,9 +4472,9 @@ static Buffer *Context_meth_buffer(Context *self, PyObject *args,
     return NULL;
   }
 
-  int size = 0;
+  Py_ssize_t size = 0;
   if (size_arg != Py_None) {
-    size = to_int(size_arg);
+    size = to_size(size_arg);
     if (size <= 0) {
       PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
       return NULL;
@@ -3468,7 +4509,7 @@ static Buffer *Context_meth_buffer(Context *self, PyObject *args,
       return NULL;
     }
 
-    size = (int)view.len;
+    size = view.len;
     if (size == 0) {
       PyBuffer_Release(&view);
         Py_DECREF(contiguous_data);
@@ -3490,7 +4531,7 @@ static Buffer *Context_meth_buffer(Context *self, PyObject *args,
                          access_arg, &access)) {
     if (have_view) {
       PyBuffer_Release(&view);
-      Py_DECREF(data);
+      Py_DECREF(contiguous_data);
     }
     PyErr_Format(PyExc_ValueError, "[HyperGL] invalid access");
     return NULL;
@@ -3498,49 +4539,68 @@ static Buffer *Context_meth_buffer(Context *self, PyObject *args,
 
   int buffer = 0;
 
-  PyMutex_Lock(&self->state_lock);
+  // On the upload thread the data goes through a neutral binding point of the
+  // upload context, the buffer keeps its target for use on the main one
+  const int upload = on_upload_thread(self);
+  const int bind_target = upload ? GL_COPY_WRITE_BUFFER : target;
 
-  // Handle dependencies on other state
-  if (target == GL_ELEMENT_ARRAY_BUFFER) {
-    // Ensures we don't accidentally bind an element buffer to the wrong VAO
-    bind_vertex_array_internal(self, 0);
-  }
+  if (!upload) {
+    PyMutex_Lock(&self->state_lock);
+
+    // Handle dependencies on other state
+    if (target == GL_ELEMENT_ARRAY_BUFFER) {
+      // Ensures we don't accidentally bind an element buffer to the wrong VAO
+      bind_vertex_array_internal(self, 0);
+    }
 
-  if (target == GL_UNIFORM_BUFFER) {
-    // Invalidate descriptor set cache if manipulating UBOs directly
-    Py_XSETREF(self->current_descriptor_set, NULL);
+    if (target == GL_UNIFORM_BUFFER) {
+      // Invalidate descriptor set cache if manipulating UBOs directly
+      Py_XSETREF(self->current_descriptor_set, NULL);
+    }
   }
 
   if (external) {
     buffer = external;
     // If data is provided for an external buffer, we write it now.
     if (initial_data_ptr) {
-      glBindBuffer(target, buffer);
-      glBufferSubData(target, 0, size, initial_data_ptr);
+      glBindBuffer(bind_target, buffer);
+      glBufferSubData(bind_target, 0, size, initial_data_ptr);
     }
   } else {
     glGenBuffers(1, (GLuint *)&buffer);
-    glBindBuffer(target, buffer);
-    // SSBO
-    if (target == GL_SHADER_STORAGE_BUFFER) {
-      glBufferStorage(target, size, initial_data_ptr,
+    glBindBuffer(bind_target, buffer);
+    if (map_access) {
+      // Readbacks want host memory, the flush bit is a map-only flag
+      int storage_flags = (map_access & ~GL_MAP_FLUSH_EXPLICIT_BIT) |
+                          GL_DYNAMIC_STORAGE_BIT;
+      if (map_access & GL_MAP_READ_BIT) {
+        storage_flags |= GL_CLIENT_STORAGE_BIT;
+      }
+      glBufferStorage(bind_target, size, initial_data_ptr, storage_flags);
+    } else if (target == GL_SHADER_STORAGE_BUFFER) {
+      // SSBO
+      glBufferStorage(bind_target, size, initial_data_ptr,
                       GL_PERSISTENT_WRITE_FLAGS | GL_DYNAMIC_STORAGE_BIT |
                           GL_CLIENT_STORAGE_BIT); // 0x0002 | 0x0040 | 0x0080 |
                                                   // 0x0100 | 0x0200
     } else {
-      glBufferData(target, size, initial_data_ptr, access);
+      glBufferData(bind_target, size, initial_data_ptr, access);
     }
   }
 
-  PyMutex_Unlock(&self->state_lock);
+  if (upload) {
+    glBindBuffer(bind_target, 0);
+  } else {
+    PyMutex_Unlock(&self->state_lock);
+  }
 
   if (have_view) {
     PyBuffer_Release(&view);
     // We are done with 'data'. It was consumed by glBufferData.
-    Py_DECREF(data);
+    Py_DECREF(contiguous_data);
   }
 
-  Buffer *res = PyObject_New(Buffer, self->module_state->Buffer_type);
+  Buffer *res = PyObject_GC_New(Buffer, self->module_state->Buffer_type);
   if (!res) {
     // Rollback
     if (!external && buffer) {
@@ -3559,22 +4619,32 @@ static Buffer *Context_meth_buffer(Context *self, PyObject *args,
   res->target = target;
   res->size = size;
   res->access = access;
+  res->immutable =
+      external || map_access || target == GL_SHADER_STORAGE_BUFFER;
+  res->map_access = map_access;
 
   // Initialize struct members to safe defaults
   res->mapped_ptr = NULL;
   res->memoryview = NULL;
   res->is_persistently_mapped = 0;
 
+  PyObject_GC_Track(res);
   return res;
 }
 
 static PyObject *Buffer_meth_bind(const Buffer *self, PyObject *args) {
   int unit;
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "bind",
+                              args, NULL, 1);
+  }
+
   if (!PyArg_ParseTuple(args, "i", &unit)) {
     return NULL;
   }
 
-  VALIDATE(unit >= 0 && unit < self->ctx->module_state->limits
+  VALIDATE(unit >= 0 && unit < self->ctx->limits
                                    .max_shader_storage_buffer_bindings,
            PyExc_ValueError, "[HyperGL] Binding unit %d out of range", unit);
 
@@ -3596,7 +4666,7 @@ static int Buffer_getbuffer(Buffer *self, Py_buffer *view, int flags) {
 
   view->buf = self->mapped_ptr;
   view->len = self->size;
-  view->readonly = 0;
+  view->readonly = self->map_access && !(self->map_access & GL_MAP_WRITE_BIT);
   view->itemsize = 1;
   view->format = NULL;
   view->ndim = 1;
@@ -3612,6 +4682,11 @@ static int Buffer_getbuffer(Buffer *self, Py_buffer *view, int flags) {
 }
 
 static PyObject *Buffer_meth_map(Buffer *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "map",
+                              args, NULL, 1);
+  }
+
   if (self->memoryview) {
     return Py_XNewRef(self->memoryview);
   }
@@ -3621,19 +4696,28 @@ static PyObject *Buffer_meth_map(Buffer *self, PyObject *args) {
     return NULL;
   }
 
-  VALIDATE(self->target == GL_SHADER_STORAGE_BUFFER, PyExc_TypeError,
-           "[HyperGL] Mapping only supported for SSBOs (ID: %d)", self->buffer);
+  // Buffers created with mapped= map any target with their own access,
+  // plain SSBOs keep the write-only coherent mapping
+  if (!self->map_access) {
+    VALIDATE(self->target == GL_SHADER_STORAGE_BUFFER, PyExc_TypeError,
+             "[HyperGL] Mapping only supported for SSBOs or buffers created "
+             "with mapped= (ID: %d)",
+             self->buffer);
 
-  VALIDATE(self->size % 16 == 0, PyExc_ValueError,
-           "[HyperGL] SSBO size (%d) must be 16-byte aligned", self->size);
+    VALIDATE(self->size % 16 == 0, PyExc_ValueError,
+             "[HyperGL] SSBO size (%zd) must be 16-byte aligned", self->size);
+  }
 
   if (!self->mapped_ptr) {
     PyMutex_Lock(&self->ctx->state_lock);
 
-    glBindBuffer(self->target, self->buffer);
+    // Neutral binding point, an element buffer would rebind the current VAO
+    glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
 
-    self->mapped_ptr = glMapBufferRange(self->target, 0, self->size,
-                                        GL_PERSISTENT_WRITE_FLAGS);
+    self->mapped_ptr = glMapBufferRange(
+        GL_COPY_WRITE_BUFFER, 0, self->size,
+        self->map_access ? self->map_access : GL_PERSISTENT_WRITE_FLAGS);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 
     if (!self->mapped_ptr) {
       GLenum err = glGetError();
@@ -3670,6 +4754,11 @@ static PyObject *Buffer_meth_map(Buffer *self, PyObject *args) {
 }
 
 static PyObject *Buffer_meth_unmap(Buffer *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "unmap",
+                              args, NULL, 1);
+  }
+
   if (!self->mapped_ptr) {
     Py_RETURN_NONE;
   }
@@ -3693,8 +4782,9 @@ static PyObject *Buffer_meth_unmap(Buffer *self, PyObject *args) {
     return NULL;
   }
 
-  glBindBuffer(self->target, self->buffer);
-  glUnmapBuffer(self->target);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+  glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
   self->mapped_ptr = NULL;
   self->is_persistently_mapped = 0;
 
@@ -3705,14 +4795,389 @@ static PyObject *Buffer_meth_unmap(Buffer *self, PyObject *args) {
   Py_RETURN_NONE;
 }
 
+// -----------------------------------------------------------------------------
+// Mapped Arrays: buffer protocol, __array_interface__ and DLPack
+// -----------------------------------------------------------------------------
+
+typedef struct ArrayDtype {
+  const char *name;
+  const char *format;
+  const char *typestr;
+  DLDataType dl_dtype;
+} ArrayDtype;
+
+enum { DL_INT = 0, DL_UINT = 1, DL_FLOAT = 2 };
+
+static const ArrayDtype array_dtypes[] = {
+    {"uint8", "B", "|u1", {DL_UINT, 8, 1}},
+    {"int8", "b", "|i1", {DL_INT, 8, 1}},
+    {"uint16", "H", "<u2", {DL_UINT, 16, 1}},
+    {"int16", "h", "<i2", {DL_INT, 16, 1}},
+    {"uint32", "I", "<u4", {DL_UINT, 32, 1}},
+    {"int32", "i", "<i4", {DL_INT, 32, 1}},
+    {"uint64", "Q", "<u8", {DL_UINT, 64, 1}},
+    {"int64", "q", "<i8", {DL_INT, 64, 1}},
+    {"float16", "e", "<f2", {DL_FLOAT, 16, 1}},
+    {"float32", "f", "<f4", {DL_FLOAT, 32, 1}},
+    {"float64", "d", "<f8", {DL_FLOAT, 64, 1}},
+    {NULL},
+};
+
+// Arrays over [offset, offset + limit) of a buffer, the mapping stays alive
+// until the array and every tensor exported from it are gone
+static MappedArray *new_mapped_array(Buffer *buffer, Py_ssize_t offset,
+                                     Py_ssize_t limit, PyObject *args,
+                                     PyObject *kwargs) {
+  static char *keywords[] = {"dtype", "shape", "offset", NULL};
+  const char *dtype_name = "uint8";
+  PyObject *shape_arg = Py_None;
+  Py_ssize_t array_offset = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sOn", keywords, &dtype_name,
+                                   &shape_arg, &array_offset)) {
+    return NULL;
+  }
+
+  const ArrayDtype *dtype = array_dtypes;
+  while (dtype->name && strcmp(dtype->name, dtype_name)) {
+    ++dtype;
+  }
+  VALIDATE(dtype->name, PyExc_ValueError, "[HyperGL] invalid dtype \"%s\"",
+           dtype_name);
+
+  const Py_ssize_t itemsize = dtype->dl_dtype.bits / 8;
+  VALIDATE(array_offset >= 0 && array_offset <= limit, PyExc_ValueError,
+           "[HyperGL] invalid offset");
+  VALIDATE((offset + array_offset) % itemsize == 0, PyExc_ValueError,
+           "[HyperGL] the offset must be aligned to the dtype (%zd bytes)",
+           itemsize);
+
+  Py_ssize_t shape[MAX_ARRAY_DIMS];
+  int ndim = 1;
+  shape[0] = (limit - array_offset) / itemsize;
+
+  if (shape_arg != Py_None) {
+    PyObject *seq = PyLong_Check(shape_arg)
+                        ? Py_BuildValue("(O)", shape_arg)
+                        : PySequence_Tuple(shape_arg);
+    if (!seq) {
+      return NULL;
+    }
+    ndim = (int)PyTuple_Size(seq);
+    if (ndim < 1 || ndim > MAX_ARRAY_DIMS) {
+      Py_DECREF(seq);
+      PyErr_Format(PyExc_ValueError, "[HyperGL] invalid shape");
+      return NULL;
+    }
+    for (int i = 0; i < ndim; ++i) {
+      shape[i] = PyLong_AsSsize_t(PyTuple_GetItem(seq, i));
+    }
+    Py_DECREF(seq);
+    if (PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+
+  // Check each step against the room left so the product cannot overflow
+  const Py_ssize_t capacity = (limit - array_offset) / itemsize;
+  Py_ssize_t count = 1;
+  for (int i = 0; i < ndim; ++i) {
+    VALIDATE(shape[i] >= 0, PyExc_ValueError, "[HyperGL] invalid shape");
+    VALIDATE(shape[i] == 0 || count <= capacity / shape[i], PyExc_ValueError,
+             "[HyperGL] the shape does not fit in the %zd bytes of the buffer",
+             limit - array_offset);
+    count *= shape[i];
+  }
+
+  PyObject *memoryview = Buffer_meth_map(buffer, NULL);
+  if (!memoryview) {
+    return NULL;
+  }
+
+  MappedArray *res =
+      PyObject_New(MappedArray, buffer->ctx->module_state->MappedArray_type);
+  if (!res) {
+    Py_DECREF(memoryview);
+    return NULL;
+  }
+
+  res->buffer = Py_NewRef((PyObject *)buffer);
+  res->memoryview = memoryview;
+  res->data = (char *)buffer->mapped_ptr + offset + array_offset;
+  res->nbytes = count * itemsize;
+  res->itemsize = itemsize;
+  res->readonly =
+      buffer->map_access && !(buffer->map_access & GL_MAP_WRITE_BIT);
+  res->ndim = ndim;
+  res->format = dtype->format;
+  res->typestr = dtype->typestr;
+  res->dl_dtype = dtype->dl_dtype;
+
+  // C order
+  Py_ssize_t stride = 1;
+  for (int i = ndim - 1; i >= 0; --i) {
+    res->shape[i] = shape[i];
+    res->strides[i] = stride * itemsize;
+    res->dl_shape[i] = shape[i];
+    res->dl_strides[i] = stride;
+    stride *= shape[i];
+  }
+  return res;
+}
+
+static MappedArray *Buffer_meth_as_array(Buffer *self, PyObject *args,
+                                         PyObject *kwargs) {
+  if (off_render_thread(self->ctx)) {
+    return (MappedArray *)render_thread_call(
+        self->ctx, (PyObject *)self, "as_array", args, kwargs, 1);
+  }
+
+  return new_mapped_array(self, 0, self->size, args, kwargs);
+}
+
+static MappedArray *BufferView_meth_as_array(BufferView *self, PyObject *args,
+                                             PyObject *kwargs) {
+  if (off_render_thread(self->buffer->ctx)) {
+    return (MappedArray *)render_thread_call(
+        self->buffer->ctx, (PyObject *)self, "as_array", args, kwargs, 1);
+  }
+
+  return new_mapped_array(self->buffer, self->offset, self->size, args,
+                          kwargs);
+}
+
+static int MappedArray_getbuffer(MappedArray *self, Py_buffer *view,
+                                 int flags) {
+  if ((flags & PyBUF_WRITABLE) && self->readonly) {
+    PyErr_SetString(PyExc_BufferError, "[HyperGL] the mapping is read only");
+    return -1;
+  }
+
+  view->buf = self->data;
+  view->len = self->nbytes;
+  view->readonly = self->readonly;
+  view->itemsize = self->itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? (char *)self->format : NULL;
+  view->ndim = self->ndim;
+  view->shape = self->shape;
+  view->strides = self->strides;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  view->obj = Py_NewRef((PyObject *)self);
+  return 0;
+}
+
+static PyObject *MappedArray_get_shape(MappedArray *self, void *closure) {
+  PyObject *res = PyTuple_New(self->ndim);
+  if (!res) {
+    return NULL;
+  }
+  for (int i = 0; i < self->ndim; ++i) {
+    PyTuple_SET_ITEM(res, i, PyLong_FromSsize_t(self->shape[i]));
+  }
+  return res;
+}
+
+static PyObject *MappedArray_get_array_interface(MappedArray *self,
+                                                 void *closure) {
+  PyObject *shape = MappedArray_get_shape(self, NULL);
+  if (!shape) {
+    return NULL;
+  }
+  return Py_BuildValue("{sNsss(NO)sOsi}", "shape", shape, "typestr",
+                       self->typestr, "data", PyLong_FromVoidPtr(self->data),
+                       self->readonly ? Py_True : Py_False, "strides", Py_None,
+                       "version", 3);
+}
+
+static void mapped_array_deleter(DLManagedTensor *tensor) {
+  // Consumers may free the tensor from any thread
+  PyGILState_STATE gil = PyGILState_Ensure();
+  Py_DECREF((PyObject *)tensor->manager_ctx);
+  PyMem_RawFree(tensor);
+  PyGILState_Release(gil);
+}
+
+static void mapped_array_versioned_deleter(DLManagedTensorVersioned *tensor) {
+  PyGILState_STATE gil = PyGILState_Ensure();
+  Py_DECREF((PyObject *)tensor->manager_ctx);
+  PyMem_RawFree(tensor);
+  PyGILState_Release(gil);
+}
+
+static void mapped_array_capsule_destructor(PyObject *capsule) {
+  // Renamed to "used_dltensor" once a consumer took ownership
+  if (PyCapsule_IsValid(capsule, "dltensor")) {
+    DLManagedTensor *tensor = PyCapsule_GetPointer(capsule, "dltensor");
+    tensor->deleter(tensor);
+  }
+}
+
+static void mapped_array_versioned_capsule_destructor(PyObject *capsule) {
+  if (PyCapsule_IsValid(capsule, "dltensor_versioned")) {
+    DLManagedTensorVersioned *tensor =
+        PyCapsule_GetPointer(capsule, "dltensor_versioned");
+    tensor->deleter(tensor);
+  }
+}
+
+static void mapped_array_dl_tensor(MappedArray *self, DLTensor *tensor) {
+  tensor->data = self->data;
+  tensor->device.device_type = DLPACK_CPU;
+  tensor->device.device_id = 0;
+  tensor->ndim = self->ndim;
+  tensor->dtype = self->dl_dtype;
+  tensor->shape = self->dl_shape;
+  tensor->strides = self->dl_strides;
+  tensor->byte_offset = 0;
+}
+
+// Consumers asking for DLPack 1.0 get a versioned tensor, flagged read only
+// for read mappings. Older consumers cannot see that flag, so read mappings
+// are not exported to them.
+static PyObject *MappedArray_meth_dlpack(MappedArray *self, PyObject *args,
+                                         PyObject *kwargs) {
+  static char *keywords[] = {"stream", "max_version", "dl_device", "copy",
+                             NULL};
+  PyObject *stream = Py_None;
+  PyObject *max_version = Py_None;
+  PyObject *dl_device = Py_None;
+  PyObject *copy = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|$OOOO", keywords, &stream,
+                                   &max_version, &dl_device, &copy)) {
+    return NULL;
+  }
+
+  VALIDATE(stream == Py_None, PyExc_BufferError,
+           "[HyperGL] mapped arrays live in host memory, stream must be None");
+  VALIDATE(copy != Py_True, PyExc_BufferError,
+           "[HyperGL] mapped arrays are only exported without a copy");
+
+  int major = 0;
+  if (max_version != Py_None) {
+    if (!PyTuple_Check(max_version) || PyTuple_GET_SIZE(max_version) != 2) {
+      PyErr_Format(PyExc_TypeError,
+                   "[HyperGL] max_version must be a (major, minor) tuple");
+      return NULL;
+    }
+    major = PyLong_AsInt(PyTuple_GET_ITEM(max_version, 0));
+    if (major == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+
+  if (major >= 1) {
+    DLManagedTensorVersioned *tensor =
+        PyMem_RawMalloc(sizeof(DLManagedTensorVersioned));
+    if (!tensor) {
+      return PyErr_NoMemory();
+    }
+    tensor->version = (DLPackVersion){1, 0};
+    tensor->manager_ctx = Py_NewRef((PyObject *)self);
+    tensor->deleter = mapped_array_versioned_deleter;
+    tensor->flags = self->readonly ? DLPACK_FLAG_BITMASK_READ_ONLY : 0;
+    mapped_array_dl_tensor(self, &tensor->dl_tensor);
+
+    PyObject *res = PyCapsule_New(tensor, "dltensor_versioned",
+                                  mapped_array_versioned_capsule_destructor);
+    if (!res) {
+      Py_DECREF(self);
+      PyMem_RawFree(tensor);
+    }
+    return res;
+  }
+
+  if (self->readonly) {
+    PyErr_Format(PyExc_BufferError,
+                 "[HyperGL] read only mappings need a DLPack 1.0 consumer "
+                 "(max_version >= (1, 0))");
+    return NULL;
+  }
+
+  DLManagedTensor *tensor = PyMem_RawMalloc(sizeof(DLManagedTensor));
+  if (!tensor) {
+    return PyErr_NoMemory();
+  }
+
+  mapped_array_dl_tensor(self, &tensor->dl_tensor);
+  tensor->manager_ctx = Py_NewRef((PyObject *)self);
+  tensor->deleter = mapped_array_deleter;
+
+  PyObject *res =
+      PyCapsule_New(tensor, "dltensor", mapped_array_capsule_destructor);
+  if (!res) {
+    Py_DECREF(self);
+    PyMem_RawFree(tensor);
+  }
+  return res;
+}
+
+static PyObject *MappedArray_meth_dlpack_device(MappedArray *self,
+                                                PyObject *args) {
+  return Py_BuildValue("(ii)", DLPACK_CPU, 0);
+}
+
+// Only non-coherent mappings need this. CPU writes in the range are made
+// visible to the GPU, and GPU writes become visible to a read mapping once a
+// fence issued after this call has signaled.
+static PyObject *Buffer_meth_flush(Buffer *self, PyObject *args,
+                                   PyObject *kwargs) {
+  static char *keywords[] = {"offset", "size", NULL};
+  Py_ssize_t offset = 0;
+  PyObject *size_arg = Py_None;
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "flush",
+                              args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nO", keywords, &offset,
+                                   &size_arg)) {
+    return NULL;
+  }
+
+  VALIDATE(offset >= 0 && offset <= self->size, PyExc_ValueError,
+           "[HyperGL] invalid offset");
+
+  Py_ssize_t size = self->size - offset;
+  if (size_arg != Py_None) {
+    size = to_size(size_arg);
+  }
+  VALIDATE(size >= 0 && size <= self->size - offset, PyExc_ValueError,
+           "[HyperGL] invalid size");
+
+  const int access = self->map_access;
+  if (!access || (access & GL_MAP_COHERENT_BIT) || size == 0) {
+    Py_RETURN_NONE;
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+  if ((access & GL_MAP_FLUSH_EXPLICIT_BIT) && self->mapped_ptr) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+    glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, offset, size);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+  if (access & GL_MAP_READ_BIT) {
+    glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
+  }
+  PyMutex_Unlock(&self->ctx->state_lock);
+  Py_RETURN_NONE;
+}
+
 static PyObject *Buffer_meth_write_texture_handle(const Buffer *self,
                                                   PyObject *args,
                                                   PyObject *kwargs) {
   static char *keywords[] = {"offset", "image", NULL};
   PyObject *image_obj;
-  int offset;
+  Py_ssize_t offset;
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(
+        self->ctx, (PyObject *)self, "write_texture_handle", args, kwargs, 1);
+  }
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iO", keywords, &offset,
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "nO", keywords, &offset,
                                    &image_obj)) {
     return NULL;
   }
@@ -3741,7 +5206,7 @@ static PyObject *Buffer_meth_write_texture_handle(const Buffer *self,
     }
   }
 
-  if (offset < 0 || offset + sizeof(GLuint64) > (size_t)self->size) {
+  if (offset < 0 || offset > self->size - (Py_ssize_t)sizeof(GLuint64)) {
     PyErr_SetString(PyExc_ValueError, "[HyperGL] Offset out of bounds");
     return NULL;
   }
@@ -3764,14 +5229,288 @@ static PyObject *Buffer_meth_write_texture_handle(const Buffer *self,
   Py_RETURN_NONE;
 }
 
+// Tell the driver the old contents of a range are dead before it is rewritten,
+// so the write does not wait for draws still reading them. A whole mutable
+// buffer is orphaned (fresh storage under the same name), anything else is
+// invalidated when GL 4.3 is there. Expects the buffer bound to bind_target.
+static void discard_buffer_range(const Buffer *self, int bind_target,
+                                 Py_ssize_t offset, Py_ssize_t size) {
+  if (self->mapped_ptr || size <= 0) {
+    // Mapped memory is shared with the caller, its contents must survive
+    return;
+  }
+  if (offset == 0 && size == self->size) {
+    if (!self->immutable) {
+      glBufferData(bind_target, self->size, NULL, self->access);
+    } else if (glInvalidateBufferData) {
+      glInvalidateBufferData(self->buffer);
+    }
+  } else if (glInvalidateBufferSubData) {
+    glInvalidateBufferSubData(self->buffer, offset, size);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Upload Conversion: float32 -> float16 / snorm16 / unorm8
+// -----------------------------------------------------------------------------
+
+typedef enum UploadConvert {
+  CONVERT_NONE,
+  CONVERT_F16,
+  CONVERT_SNORM16,
+  CONVERT_UNORM8,
+} UploadConvert;
+
+static int to_upload_convert(const char *name) {
+  if (!name) {
+    return CONVERT_NONE;
+  }
+  if (!strcmp(name, "f32->f16")) {
+    return CONVERT_F16;
+  }
+  if (!strcmp(name, "f32->snorm16")) {
+    return CONVERT_SNORM16;
+  }
+  if (!strcmp(name, "f32->unorm8")) {
+    return CONVERT_UNORM8;
+  }
+  PyErr_Format(PyExc_ValueError, "[HyperGL] invalid convert \"%s\"", name);
+  return -1;
+}
+
+static inline Py_ssize_t converted_size(int convert, Py_ssize_t count) {
+  return convert == CONVERT_UNORM8 ? count : count * 2;
+}
+
+// Round to nearest even, denormals, infinities and NaN included
+static inline uint16_t float_to_half(float value) {
+  const uint32_t f32_infinity = 255U << 23;
+  const uint32_t f16_max = (127U + 16U) << 23;
+  const uint32_t denormal_magic = ((127U - 15U) + (23U - 10U) + 1U) << 23;
+
+  uint32_t x;
+  memcpy(&x, &value, sizeof(x));
+  const uint32_t sign = x & 0x80000000U;
+  x ^= sign;
+
+  uint32_t res;
+  if (x >= f16_max) {
+    res = x > f32_infinity ? 0x7E00 : 0x7C00;
+  } else if (x < (113U << 23)) {
+    float magic;
+    memcpy(&magic, &denormal_magic, sizeof(magic));
+    float scaled;
+    memcpy(&scaled, &x, sizeof(scaled));
+    scaled += magic;
+    memcpy(&res, &scaled, sizeof(res));
+    res -= denormal_magic;
+  } else {
+    const uint32_t mantissa_odd = (x >> 13) & 1;
+    x += ((15U - 127U) << 23) + 0xFFFU;
+    x += mantissa_odd;
+    res = x >> 13;
+  }
+  return (uint16_t)(res | (sign >> 16));
+}
+
+#ifdef HYPERGL_F16C
+__attribute__((target("avx,f16c"))) static Py_ssize_t
+floats_to_half_f16c(uint16_t *dst, const float *src, Py_ssize_t count) {
+  Py_ssize_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 value = _mm256_loadu_ps(src + i);
+    _mm_storeu_si128((__m128i *)(dst + i),
+                     _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+  }
+  return i;
+}
+#endif
+
+static void floats_to_half(uint16_t *dst, const float *src, Py_ssize_t count) {
+  Py_ssize_t i = 0;
+#if defined(HYPERGL_F16C)
+  // Threads racing on the first call store the same value
+  static volatile long long has_f16c = -1;
+  long long f16c = Atomic_Load64(&has_f16c);
+  if (f16c < 0) {
+    __builtin_cpu_init();
+    f16c = __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+    Atomic_Store64(&has_f16c, f16c);
+  }
+  if (f16c) {
+    i = floats_to_half_f16c(dst, src, count);
+  }
+#elif defined(HYPERGL_NEON)
+  for (; i + 4 <= count; i += 4) {
+    vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = float_to_half(src[i]);
+  }
+}
+
+// Plain loops, written branch free so they auto-vectorize at -O3
+static void floats_to_snorm16(int16_t *dst, const float *src,
+                              Py_ssize_t count) {
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    float value = src[i] >= -1.0f ? src[i] : -1.0f; // NaN maps to -1
+    value = value <= 1.0f ? value : 1.0f;
+    dst[i] = (int16_t)(value * 32767.0f + (value >= 0.0f ? 0.5f : -0.5f));
+  }
+}
+
+static void floats_to_unorm8(uint8_t *dst, const float *src,
+                             Py_ssize_t count) {
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    float value = src[i] >= 0.0f ? src[i] : 0.0f; // NaN maps to 0
+    value = value <= 1.0f ? value : 1.0f;
+    dst[i] = (uint8_t)(value * 255.0f + 0.5f);
+  }
+}
+
+static void convert_floats(int convert, void *dst, const float *src,
+                           Py_ssize_t count) {
+  switch (convert) {
+  case CONVERT_F16:
+    floats_to_half(dst, src, count);
+    break;
+  case CONVERT_SNORM16:
+    floats_to_snorm16(dst, src, count);
+    break;
+  case CONVERT_UNORM8:
+    floats_to_unorm8(dst, src, count);
+    break;
+  default:
+    break;
+  }
+}
+
+// Float count of a contiguous float32 source, -1 with an error set otherwise
+static Py_ssize_t convert_source_count(const Py_buffer *view) {
+  if (view->format && strcmp(view->format, "f") &&
+      strcmp(view->format, "<f") && strcmp(view->format, "=f")) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] convert expects float32 data, got format \"%s\"",
+                 view->format);
+    return -1;
+  }
+  if (view->len % sizeof(float)) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] convert expects whole float32 values");
+    return -1;
+  }
+  return view->len / (Py_ssize_t)sizeof(float);
+}
+
+// Row gather/scatter. The common attribute sizes get fixed size copies the
+// compiler turns into single vector loads and stores.
+static void copy_rows(char *dst, Py_ssize_t dst_stride, const char *src,
+                      Py_ssize_t src_stride, Py_ssize_t rows,
+                      Py_ssize_t row_bytes) {
+#define COPY_ROWS(n)                                                           \
+  for (Py_ssize_t i = 0; i < rows; ++i) {                                      \
+    memcpy(dst + i * dst_stride, src + i * src_stride, (n));                   \
+  }                                                                            \
+  return
+
+  switch (row_bytes) {
+  case 4:
+    COPY_ROWS(4);
+  case 8:
+    COPY_ROWS(8);
+  case 12:
+    COPY_ROWS(12);
+  case 16:
+    COPY_ROWS(16);
+  case 32:
+    COPY_ROWS(32);
+  case 64:
+    COPY_ROWS(64);
+  default:
+    COPY_ROWS(row_bytes);
+  }
+#undef COPY_ROWS
+}
+
+static inline int buffer_mapped_for_write(const Buffer *self) {
+  return self->mapped_ptr &&
+         (!self->map_access || (self->map_access & GL_MAP_WRITE_BIT));
+}
+
+// float32 sources are converted on the way in, straight into the mapping when
+// there is one, otherwise into a single staging block
+static PyObject *write_converted_buffer(const Buffer *self, PyObject *data,
+                                        Py_ssize_t offset, int discard,
+                                        int convert) {
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS)) {
+    return NULL;
+  }
+
+  const Py_ssize_t count = convert_source_count(&view);
+  if (count < 0) {
+    PyBuffer_Release(&view);
+    return NULL;
+  }
+
+  const Py_ssize_t data_size = converted_size(convert, count);
+  if (data_size > self->size - offset) {
+    PyBuffer_Release(&view);
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
+    return NULL;
+  }
+
+  if (buffer_mapped_for_write(self)) {
+    convert_floats(convert, (char *)self->mapped_ptr + offset, view.buf,
+                   count);
+    PyBuffer_Release(&view);
+    Py_RETURN_NONE;
+  }
+
+  void *staging = PyMem_Malloc(data_size ? data_size : 1);
+  if (!staging) {
+    PyBuffer_Release(&view);
+    return PyErr_NoMemory();
+  }
+  convert_floats(convert, staging, view.buf, count);
+  PyBuffer_Release(&view);
+
+  if (data_size > 0) {
+    const int upload = on_upload_thread(self->ctx);
+    if (!upload) {
+      PyMutex_Lock(&self->ctx->state_lock);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+    if (discard) {
+      discard_buffer_range(self, GL_COPY_WRITE_BUFFER, offset, data_size);
+    }
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, data_size, staging);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (!upload) {
+      PyMutex_Unlock(&self->ctx->state_lock);
+    }
+  }
+
+  PyMem_Free(staging);
+  Py_RETURN_NONE;
+}
+
 static PyObject *Buffer_meth_write(const Buffer *self, PyObject *args,
                                    PyObject *kwargs) {
-  static char *keywords[] = {"data", "offset", NULL};
+  static char *keywords[] = {"data", "offset", "discard", "convert", NULL};
   PyObject *data;
-  int offset = 0;
+  Py_ssize_t offset = 0;
+  int discard = 0;
+  const char *convert_name = NULL;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", keywords, &data,
-                                   &offset)) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "write",
+                              args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n$pz", keywords, &data,
+                                   &offset, &discard, &convert_name)) {
     return NULL;
   }
 
@@ -3780,6 +5519,14 @@ static PyObject *Buffer_meth_write(const Buffer *self, PyObject *args,
   VALIDATE(offset >= 0 && offset <= self->size, PyExc_ValueError,
            "[HyperGL] invalid offset");
 
+  const int convert = to_upload_convert(convert_name);
+  if (convert < 0) {
+    return NULL;
+  }
+  if (convert != CONVERT_NONE) {
+    return write_converted_buffer(self, data, offset, discard, convert);
+  }
+
   BufferView *buffer_view = NULL;
   if (Py_TYPE(data) == self->ctx->module_state->Buffer_type) {
     buffer_view = (BufferView *)PyObject_CallMethod(data, "view", NULL);
@@ -3788,7 +5535,7 @@ static PyObject *Buffer_meth_write(const Buffer *self, PyObject *args,
   }
 
   if (buffer_view) {
-    if (buffer_view->size + offset > self->size) {
+    if (buffer_view->size > self->size - offset) {
       Py_DECREF(buffer_view);
       PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
       return NULL;
@@ -3798,6 +5545,10 @@ static PyObject *Buffer_meth_write(const Buffer *self, PyObject *args,
 
     glBindBuffer(GL_COPY_READ_BUFFER, buffer_view->buffer->buffer);
     glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+    if (discard) {
+      discard_buffer_range(self, GL_COPY_WRITE_BUFFER, offset,
+                           buffer_view->size);
+    }
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
                         buffer_view->offset, offset, buffer_view->size);
     glBindBuffer(GL_COPY_READ_BUFFER, 0);
@@ -3820,15 +5571,23 @@ static PyObject *Buffer_meth_write(const Buffer *self, PyObject *args,
     return NULL;
   }
 
-  int data_size = (int)view.len;
-  if (data_size + offset > self->size) {
+  Py_ssize_t data_size = view.len;
+  if (data_size > self->size - offset) {
     PyBuffer_Release(&view);
     Py_DECREF(mem);
     PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
     return NULL;
   }
 
-  if (data_size > 0) {
+  if (data_size > 0 && on_upload_thread(self->ctx)) {
+    // Main context bindings are untouched, skip the lock and the shadow state
+    glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+    if (discard) {
+      discard_buffer_range(self, GL_COPY_WRITE_BUFFER, offset, data_size);
+    }
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, data_size, view.buf);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  } else if (data_size > 0) {
     PyMutex_Lock(&self->ctx->state_lock);
 
     // Logic to prevent breaking VAO/Descriptor state
@@ -3842,6 +5601,9 @@ static PyObject *Buffer_meth_write(const Buffer *self, PyObject *args,
 
     // Use a neutral binding point (GL_COPY_WRITE_BUFFER)
     glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+    if (discard) {
+      discard_buffer_range(self, GL_COPY_WRITE_BUFFER, offset, data_size);
+    }
     glBufferSubData(GL_COPY_WRITE_BUFFER, offset, data_size, view.buf);
     glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 
@@ -3853,15 +5615,234 @@ static PyObject *Buffer_meth_write(const Buffer *self, PyObject *args,
   Py_RETURN_NONE;
 }
 
-static PyObject *Buffer_meth_read(Buffer *self, PyObject *args,
-                                  PyObject *kwargs) {
-  static char *keywords[] = {"size", "offset", "into", NULL};
+static PyObject *Buffer_meth_write_strided(Buffer *self, PyObject *args,
+                                           PyObject *kwargs) {
+  static char *keywords[] = {"data", "dst_offset", "dst_stride", NULL};
+  PyObject *data;
+  Py_ssize_t dst_offset = 0;
+  Py_ssize_t dst_stride = 0;
 
-  PyObject *size_arg = Py_None;
-  int offset = 0;
-  PyObject *into = Py_None;
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "write_strided",
+                              args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|nn", keywords, &data,
+                                   &dst_offset, &dst_stride)) {
+    return NULL;
+  }
+
+  VALIDATE(!self->ctx->is_lost, PyExc_RuntimeError,
+           "[HyperGL] the context is lost");
+
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_STRIDED_RO)) {
+    return NULL;
+  }
+
+  // Rows are the outer index, each row must be contiguous on its own. A field
+  // or column slice of a structured array qualifies.
+  PyObject *mem = NULL;
+  Py_ssize_t rows = view.ndim ? view.shape[0] : 1;
+  Py_ssize_t row_bytes = view.itemsize;
+  for (int i = view.ndim - 1; i >= 1; --i) {
+    if (view.shape[i] > 1 && view.strides[i] != row_bytes) {
+      row_bytes = -1;
+      break;
+    }
+    row_bytes *= view.shape[i];
+  }
+  if (row_bytes < 0 || view.suboffsets) {
+    PyBuffer_Release(&view);
+    mem = PyMemoryView_GetContiguous(data, PyBUF_READ, 'C');
+    if (!mem || PyObject_GetBuffer(mem, &view, PyBUF_STRIDED_RO)) {
+      Py_XDECREF(mem);
+      return NULL;
+    }
+    row_bytes = rows ? view.len / rows : 0;
+  }
+  const Py_ssize_t src_stride = view.ndim ? view.strides[0] : row_bytes;
+
+  if (!dst_stride) {
+    dst_stride = row_bytes;
+  }
+
+  // Bound the stride before multiplying so a huge one cannot wrap the span
+  if (dst_stride < row_bytes || dst_offset < 0 || dst_offset > self->size ||
+      (rows && row_bytes > self->size - dst_offset) ||
+      (rows > 1 &&
+       dst_stride > (self->size - dst_offset - row_bytes) / (rows - 1))) {
+    PyBuffer_Release(&view);
+    Py_XDECREF(mem);
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] invalid dst_offset or dst_stride");
+    return NULL;
+  }
+  const Py_ssize_t span = rows ? (rows - 1) * dst_stride + row_bytes : 0;
+
+  if (!span) {
+    PyBuffer_Release(&view);
+    Py_XDECREF(mem);
+    Py_RETURN_NONE;
+  }
+
+  // Mapped buffers are written in place, like map()
+  if (buffer_mapped_for_write(self)) {
+    copy_rows((char *)self->mapped_ptr + dst_offset, dst_stride, view.buf,
+              src_stride, rows, row_bytes);
+    PyBuffer_Release(&view);
+    Py_XDECREF(mem);
+    Py_RETURN_NONE;
+  }
+
+  const int upload = on_upload_thread(self->ctx);
+  if (!upload) {
+    PyMutex_Lock(&self->ctx->state_lock);
+  }
+
+  // Map only the covered range, without invalidating it, so the bytes between
+  // rows survive and the rows are gathered straight into the driver's memory
+  glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+  void *ptr = self->mapped_ptr
+                  ? NULL
+                  : glMapBufferRange(GL_COPY_WRITE_BUFFER, dst_offset, span,
+                                     GL_MAP_WRITE_BIT);
+  if (ptr) {
+    copy_rows(ptr, dst_stride, view.buf, src_stride, rows, row_bytes);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+  } else {
+    // Mapped for reading elsewhere, fall back to one update per row
+    for (Py_ssize_t i = 0; i < rows; ++i) {
+      glBufferSubData(GL_COPY_WRITE_BUFFER, dst_offset + i * dst_stride,
+                      row_bytes, (const char *)view.buf + i * src_stride);
+    }
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+  if (!upload) {
+    PyMutex_Unlock(&self->ctx->state_lock);
+  }
+
+  PyBuffer_Release(&view);
+  Py_XDECREF(mem);
+  Py_RETURN_NONE;
+}
+
+// Many small updates under one lock and one bind
+static PyObject *Buffer_meth_write_many(Buffer *self, PyObject *args) {
+  PyObject *items_arg;
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "write_many",
+                              args, NULL, 1);
+  }
+
+  if (!PyArg_ParseTuple(args, "O", &items_arg)) {
+    return NULL;
+  }
+
+  VALIDATE(!self->ctx->is_lost, PyExc_RuntimeError,
+           "[HyperGL] the context is lost");
+
+  PyObject *items =
+      PySequence_Fast(items_arg, "[HyperGL] expected a sequence of "
+                                 "(offset, data) pairs");
+  if (!items) {
+    return NULL;
+  }
+
+  const Py_ssize_t count = PySequence_Fast_GET_SIZE(items);
+  Py_buffer *views = PyMem_Calloc(count ? count : 1, sizeof(Py_buffer));
+  Py_ssize_t *offsets = PyMem_Malloc((count ? count : 1) * sizeof(Py_ssize_t));
+  Py_ssize_t acquired = 0;
+  PyObject *res = NULL;
+
+  if (!views || !offsets) {
+    PyErr_NoMemory();
+    goto done;
+  }
+
+  for (; acquired < count; ++acquired) {
+    PyObject *item = PySequence_Fast_GET_ITEM(items, acquired);
+    if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+      PyErr_Format(PyExc_TypeError,
+                   "[HyperGL] expected an (offset, data) tuple at %zd",
+                   acquired);
+      goto done;
+    }
+    offsets[acquired] = PyNumber_AsSsize_t(PyTuple_GET_ITEM(item, 0),
+                                           PyExc_OverflowError);
+    if (offsets[acquired] == -1 && PyErr_Occurred()) {
+      goto done;
+    }
+    // Strided data is gathered into a copy, the same as write()
+    PyObject *mem = PyMemoryView_GetContiguous(PyTuple_GET_ITEM(item, 1),
+                                               PyBUF_READ, 'C');
+    if (!mem) {
+      goto done;
+    }
+    const int failed = PyObject_GetBuffer(mem, &views[acquired], PyBUF_SIMPLE);
+    Py_DECREF(mem);
+    if (failed) {
+      goto done;
+    }
+    if (offsets[acquired] < 0 ||
+        views[acquired].len > self->size - offsets[acquired]) {
+      PyBuffer_Release(&views[acquired]);
+      PyErr_Format(PyExc_ValueError, "[HyperGL] invalid offset or size at %zd",
+                   acquired);
+      goto done;
+    }
+  }
+
+  if (buffer_mapped_for_write(self)) {
+    for (Py_ssize_t i = 0; i < count; ++i) {
+      memcpy((char *)self->mapped_ptr + offsets[i], views[i].buf,
+             views[i].len);
+    }
+  } else if (count) {
+    const int upload = on_upload_thread(self->ctx);
+    if (!upload) {
+      PyMutex_Lock(&self->ctx->state_lock);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, self->buffer);
+    for (Py_ssize_t i = 0; i < count; ++i) {
+      if (views[i].len) {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offsets[i], views[i].len,
+                        views[i].buf);
+      }
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (!upload) {
+      PyMutex_Unlock(&self->ctx->state_lock);
+    }
+  }
+  res = Py_NewRef(Py_None);
+
+done:
+  for (Py_ssize_t i = 0; i < acquired; ++i) {
+    PyBuffer_Release(&views[i]);
+  }
+  PyMem_Free(views);
+  PyMem_Free(offsets);
+  Py_DECREF(items);
+  return res;
+}
+
+static PyObject *Buffer_meth_read(Buffer *self, PyObject *args,
+                                  PyObject *kwargs) {
+  static char *keywords[] = {"size", "offset", "into", NULL};
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "read",
+                              args, kwargs, 1);
+  }
+
+  PyObject *size_arg = Py_None;
+  Py_ssize_t offset = 0;
+  PyObject *into = Py_None;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OiO", keywords, &size_arg,
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OnO", keywords, &size_arg,
                                    &offset, &into)) {
     return NULL;
   }
@@ -3881,16 +5862,16 @@ static PyObject *Buffer_meth_read(Buffer *self, PyObject *args,
     return NULL;
   }
 
-  int size = self->size - offset;
+  Py_ssize_t size = self->size - offset;
   if (size_arg != Py_None) {
-    size = to_int(size_arg);
+    size = to_size(size_arg);
     if (size < 0) {
       PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
       return NULL;
     }
   }
 
-  if (size < 0 || size + offset > self->size) {
+  if (size < 0 || size > self->size - offset) {
     PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
     return NULL;
   }
@@ -3913,7 +5894,7 @@ static PyObject *Buffer_meth_read(Buffer *self, PyObject *args,
 
   if (Py_TYPE(into) == self->ctx->module_state->Buffer_type) {
     PyObject *chunk =
-        PyObject_CallMethod((PyObject *)self, "view", "(ii)", size, offset);
+        PyObject_CallMethod((PyObject *)self, "view", "(nn)", size, offset);
     return PyObject_CallMethod(into, "write", "(N)", chunk);
   }
 
@@ -3924,8 +5905,8 @@ static PyObject *Buffer_meth_read(Buffer *self, PyObject *args,
       return NULL;
     }
     PyObject *chunk =
-        PyObject_CallMethod((PyObject *)self, "view", "(ii)", size, offset);
-    return PyObject_CallMethod((PyObject *)buffer_view->buffer, "write", "(Ni)",
+        PyObject_CallMethod((PyObject *)self, "view", "(nn)", size, offset);
+    return PyObject_CallMethod((PyObject *)buffer_view->buffer, "write", "(Nn)",
                                chunk, buffer_view->offset);
   }
 
@@ -3934,7 +5915,8 @@ static PyObject *Buffer_meth_read(Buffer *self, PyObject *args,
     return NULL;
   }
 
-  if (size > (int)view.len) {
+  if (size > view.len) {
+    PyBuffer_Release(&view);
     PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
     return NULL;
   }
@@ -3952,16 +5934,16 @@ static BufferView *Buffer_meth_view(Buffer *self, PyObject *args,
   static char *keywords[] = {"size", "offset", NULL};
 
   PyObject *size_arg = Py_None;
-  int offset = 0;
+  Py_ssize_t offset = 0;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|Oi", keywords, &size_arg,
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|On", keywords, &size_arg,
                                    &offset)) {
     return NULL;
   }
 
-  int size = self->size - offset;
+  Py_ssize_t size = self->size - offset;
   if (size_arg != Py_None) {
-    size = to_int(size_arg);
+    size = to_size(size_arg);
   }
 
   if (self->ctx->is_lost) {
@@ -3974,1921 +5956,5276 @@ static BufferView *Buffer_meth_view(Buffer *self, PyObject *args,
     return NULL;
   }
 
-  if (size < 0 || offset + size > self->size) {
+  if (size < 0 || size > self->size - offset) {
     PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
     return NULL;
   }
 
   BufferView *res =
       PyObject_New(BufferView, self->ctx->module_state->BufferView_type);
+  if (!res) {
+    return NULL;
+  }
   res->buffer = (Buffer *)new_ref(self);
   res->offset = offset;
   res->size = size;
+  res->heap = NULL;
   return res;
 }
 
 // -----------------------------------------------------------------------------
-// Type: Image
+// Type: BufferView
 // -----------------------------------------------------------------------------
 
-static int Image_write_internal(const Image *self, PyObject *data) {
-  if (self->ctx->is_lost) {
-    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] the context is lost");
-    return -1;
+static Py_ssize_t data_nbytes(PyObject *data, const ModuleState *state) {
+  if (Py_TYPE(data) == state->Buffer_type) {
+    return ((Buffer *)data)->size;
   }
-  if (self->renderbuffer) {
-    PyErr_SetString(PyExc_RuntimeError,
-                    "[HyperGL] cannot write to renderbuffer");
-    return -1;
+  if (Py_TYPE(data) == state->BufferView_type) {
+    return ((BufferView *)data)->size;
   }
-  if (self->image == 0) {
-    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] invalid image object");
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_FULL_RO) < 0) {
     return -1;
   }
+  Py_ssize_t res = view.len;
+  PyBuffer_Release(&view);
+  return res;
+}
 
-  Py_buffer view;
-  // We use PyBUF_SIMPLE to get a contiguous pointer
-  if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) < 0) {
-    return -1;
+// Writes and reads are bounded by the view, offsets are relative to it
+static PyObject *BufferView_meth_write(BufferView *self, PyObject *args,
+                                       PyObject *kwargs) {
+  static char *keywords[] = {"data", "offset", "discard", NULL};
+  PyObject *data;
+  Py_ssize_t offset = 0;
+  int discard = 0;
+
+  if (off_render_thread(self->buffer->ctx)) {
+    return render_thread_call(self->buffer->ctx, (PyObject *)self, "write",
+                              args, kwargs, 1);
   }
 
-  enum {
-    CUBEMAP_LAYER_COUNT = 6,
-    SINGLE_LAYER_COUNT = 1,
-  };
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n$p", keywords, &data,
+                                   &offset, &discard)) {
+    return NULL;
+  }
 
+  Py_ssize_t size = data_nbytes(data, self->buffer->ctx->module_state);
+  if (size < 0) {
+    return NULL;
+  }
+  VALIDATE(offset >= 0 && offset <= self->size, PyExc_ValueError,
+           "[HyperGL] invalid offset");
+  VALIDATE(size <= self->size - offset, PyExc_ValueError,
+           "[HyperGL] invalid size");
+
+  PyObject *write_args = Py_BuildValue("(On)", data, self->offset + offset);
+  PyObject *write_kwargs =
+      discard ? Py_BuildValue("{sO}", "discard", Py_True) : NULL;
+  PyObject *res = NULL;
+  if (write_args && (write_kwargs || !discard)) {
+    res = Buffer_meth_write(self->buffer, write_args, write_kwargs);
+  }
+  Py_XDECREF(write_args);
+  Py_XDECREF(write_kwargs);
+  return res;
+}
 
-  int bpp = self->fmt.pixel_size;
-  Py_ssize_t layers;
+static PyObject *BufferView_meth_read(BufferView *self, PyObject *args,
+                                      PyObject *kwargs) {
+  static char *keywords[] = {"size", "offset", "into", NULL};
+  PyObject *size_arg = Py_None;
+  Py_ssize_t offset = 0;
+  PyObject *into = Py_None;
 
-  if (self->cubemap) {
-      layers = CUBEMAP_LAYER_COUNT;
-  } else if (self->array) {
-      layers = self->array;
-  } else {
-      layers = SINGLE_LAYER_COUNT;
+  if (off_render_thread(self->buffer->ctx)) {
+    return render_thread_call(self->buffer->ctx, (PyObject *)self, "read",
+                              args, kwargs, 1);
   }
 
-  Py_ssize_t expected_size =
-      (Py_ssize_t)self->width * self->height * bpp * layers;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OnO", keywords, &size_arg,
+                                   &offset, &into)) {
+    return NULL;
+  }
 
-  if (view.len < expected_size) {
-    PyErr_Format(
-        PyExc_ValueError,
-        "[HyperGL] data buffer too small (expected %zd bytes, got %zd)",
-        expected_size, view.len);
-    PyBuffer_Release(&view);
-    return -1;
+  VALIDATE(offset >= 0 && offset <= self->size, PyExc_ValueError,
+           "[HyperGL] invalid offset");
+  Py_ssize_t size = self->size - offset;
+  if (size_arg != Py_None) {
+    size = to_size(size_arg);
   }
+  VALIDATE(size >= 0 && size <= self->size - offset, PyExc_ValueError,
+           "[HyperGL] invalid size");
 
-  PyMutex_Lock(&self->ctx->state_lock);
+  PyObject *read_args =
+      Py_BuildValue("(nnO)", size, self->offset + offset, into);
+  if (!read_args) {
+    return NULL;
+  }
+  PyObject *res = Buffer_meth_read(self->buffer, read_args, NULL);
+  Py_DECREF(read_args);
+  return res;
+}
 
-  glActiveTexture(self->ctx->default_texture_unit);
-  glBindTexture(self->target, self->image);
+// -----------------------------------------------------------------------------
+// Type: Heap
+// -----------------------------------------------------------------------------
 
-  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-  glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
-  glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+// Buddy allocator over whole chunks. Blocks are naturally aligned to their
+// size, so a block size that is a multiple of the UBO/SSBO offset alignment
+// keeps every view bindable as a range.
 
-  if (self->cubemap) {
-    Py_ssize_t face_size = (Py_ssize_t)self->width * self->height * bpp;
-    char *ptr = (char *)view.buf;
+static int heap_order(Py_ssize_t units) {
+  int order = 0;
+  while (((Py_ssize_t)1 << order) < units) {
+    order += 1;
+  }
+  return order;
+}
 
-    for (int i = 0; i < 6; ++i) {
-      glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, 0, 0, self->width,
-                      self->height, self->fmt.format, self->fmt.type,
-                      ptr + (i * face_size));
-    }
-  } else if (self->array) {
-    glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
-    glTexSubImage3D(self->target, 0, 0, 0, 0, self->width, self->height,
-                    self->array, self->fmt.format, self->fmt.type, view.buf);
+static void heap_update(unsigned char *longest, Py_ssize_t node, int order) {
+  const unsigned char left = longest[2 * node + 1];
+  const unsigned char right = longest[2 * node + 2];
+  // Both halves entirely free merge back into one block
+  if (left == order && right == order) {
+    longest[node] = (unsigned char)(order + 1);
   } else {
-    glTexSubImage2D(self->target, 0, 0, 0, self->width, self->height,
-                    self->fmt.format, self->fmt.type, view.buf);
+    longest[node] = left > right ? left : right;
   }
+}
 
-  PyMutex_Unlock(&self->ctx->state_lock);
+// Returns the offset in blocks, -1 when the chunk has no room
+static Py_ssize_t heap_chunk_alloc(const Heap *self, HeapChunk *chunk,
+                                   int order) {
+  unsigned char *longest = chunk->longest;
+  if (longest[0] < order + 1) {
+    return -1;
+  }
 
-  PyBuffer_Release(&view);
-  return 0;
-}
+  Py_ssize_t node = 0;
+  int node_order = self->max_order;
+  while (node_order > order) {
+    const Py_ssize_t left = 2 * node + 1;
+    node = longest[left] >= order + 1 ? left : left + 1;
+    node_order -= 1;
+  }
 
-static int Image_traverse(const Image *self, visitproc visit, void *arg) {
-  Py_VISIT(self->ctx);
-  Py_VISIT(self->size);
-  Py_VISIT(self->format);
-  Py_VISIT(self->faces);
-  Py_VISIT(self->layers);
-  return 0;
-}
+  longest[node] = 0;
+  const Py_ssize_t offset =
+      ((node + 1) << node_order) - ((Py_ssize_t)1 << self->max_order);
 
-static int Image_clear(Image *self) {
-  Py_CLEAR(self->ctx);
-  Py_CLEAR(self->size);
-  Py_CLEAR(self->format);
-  Py_CLEAR(self->faces);
-  Py_CLEAR(self->layers);
-  return 0;
+  while (node) {
+    node = (node - 1) / 2;
+    node_order += 1;
+    heap_update(longest, node, node_order);
+  }
+  return offset;
 }
 
-static Image *Context_meth_image(Context *self, PyObject *args,
-                                 PyObject *kwargs) { // HAS GC_TRACK
-  ModuleState *state = self->module_state;
-  static char *keywords[] = {"size",     "format", "data",    "samples",
-                             "array",    "levels", "texture", "cubemap",
-                             "external", NULL};
+// Returns the order of the freed block, -1 when offset is not the start of an
+// allocated block
+static int heap_chunk_free(const Heap *self, HeapChunk *chunk,
+                           Py_ssize_t offset) {
+  unsigned char *longest = chunk->longest;
+  Py_ssize_t node = offset + ((Py_ssize_t)1 << self->max_order) - 1;
+  int order = 0;
 
-  int width;
-  int height;
-  int samples = 1;
-  int array = 0;
-  int cubemap = 0;
-  int levels = 1;
-  int external = 0;
-  PyObject *format = state->str_rgba8unorm;
-  PyObject *data = Py_None;
-  PyObject *texture = Py_None;
+  while (longest[node]) {
+    if (!node) {
+      return -1;
+    }
+    node = (node - 1) / 2;
+    order += 1;
+  }
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "(ii)|O!OiiiOpi", keywords,
-                                   &width, &height, &PyUnicode_Type, &format,
-                                   &data, &samples, &array, &levels, &texture,
-                                   &cubemap, &external)) {
+  if (((node + 1) << order) - ((Py_ssize_t)1 << self->max_order) != offset) {
+    return -1;
+  }
+
+  const int freed = order;
+  longest[node] = (unsigned char)(order + 1);
+  while (node) {
+    node = (node - 1) / 2;
+    order += 1;
+    heap_update(longest, node, order);
+  }
+  return freed;
+}
+
+static HeapChunk *heap_add_chunk(Heap *self) {
+  const Py_ssize_t chunk_size = self->block << self->max_order;
+  const Py_ssize_t nodes = ((Py_ssize_t)2 << self->max_order) - 1;
+
+  unsigned char *longest = PyMem_Malloc(nodes);
+  HeapChunk *chunks = PyMem_Realloc(self->chunks, sizeof(HeapChunk) *
+                                                      (self->chunk_count + 1));
+  if (!longest || !chunks) {
+    PyMem_Free(longest);
+    if (chunks) {
+      self->chunks = chunks;
+    }
+    PyErr_NoMemory();
     return NULL;
   }
+  self->chunks = chunks;
 
-  // --- Validation Logic ---
-  int max_levels = count_mipmaps(width, height);
-  if (levels <= 0) {
-    levels = max_levels;
+  // Level by level, every node starts as one free block of its own size
+  for (int depth = 0; depth <= self->max_order; ++depth) {
+    const Py_ssize_t first = ((Py_ssize_t)1 << depth) - 1;
+    memset(longest + first, self->max_order - depth + 1,
+           (size_t)1 << depth);
   }
-  if (self->is_lost) {
-    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
+
+  PyObject *kwargs = Py_BuildValue("{snsO}", "size", chunk_size, "access",
+                                   self->ctx->module_state->str_dynamic_draw);
+  if (kwargs && !PyUnicode_EqualToUTF8(self->kind, "vertex") &&
+      PyDict_SetItem(kwargs, self->kind, Py_True) < 0) {
+    Py_CLEAR(kwargs);
+  }
+  Buffer *buffer =
+      kwargs ? Context_meth_buffer(self->ctx, self->ctx->module_state->empty_tuple,
+                                   kwargs)
+             : NULL;
+  Py_XDECREF(kwargs);
+  if (!buffer) {
+    PyMem_Free(longest);
     return NULL;
   }
 
-  VALIDATE(texture == Py_True || texture == Py_False || texture == Py_None,
-           PyExc_TypeError, "[HyperGL] invalid texture parameter");
-  VALIDATE(!(samples > 1 && texture == Py_True), PyExc_TypeError,
-           "[HyperGL] for multisampled images texture must be False");
-  VALIDATE(samples >= 1 && !(samples & (samples - 1)) && samples <= 16,
-           PyExc_ValueError, "[HyperGL] samples must be 1, 2, 4, 8 or 16");
-  VALIDATE(array >= 0, PyExc_ValueError,
-           "[HyperGL] array must not be negative");
-  VALIDATE(levels <= max_levels, PyExc_ValueError, "[HyperGL] too many levels");
-  VALIDATE(!(cubemap && array), PyExc_TypeError,
-           "[HyperGL] cubemap arrays are not supported");
-  VALIDATE(!(samples > 1 && (array || cubemap)), PyExc_TypeError,
-           "[HyperGL] multisampled array or cubemap images are not supported");
-  VALIDATE(!(texture == Py_False && (array || cubemap)), PyExc_TypeError,
-           "[HyperGL] for array or cubemap images texture must be True");
-  VALIDATE(!(data != Py_None && samples > 1), PyExc_ValueError,
-           "[HyperGL] cannot write to multisampled images");
-  VALIDATE(!(data != Py_None && texture == Py_False), PyExc_ValueError,
-           "[HyperGL] cannot write to renderbuffers");
-  VALIDATE(width > 0 && height > 0, PyExc_ValueError,
-           "[HyperGL] invalid image size");
-  if (external) {
-    VALIDATE(external > 0, PyExc_ValueError,
-             "[HyperGL] external must be a valid GL object");
-  }
-
-  char renderbuffer = (samples > 1 || texture == Py_False) ? 1 : 0;
-  int target;
+  HeapChunk *chunk = &self->chunks[self->chunk_count++];
+  chunk->buffer = buffer;
+  chunk->longest = longest;
+  return chunk;
+}
 
-  if (cubemap) {
-      target = GL_TEXTURE_CUBE_MAP;
-  } else if (array) {
-      target = GL_TEXTURE_2D_ARRAY;
-  } else {
-      target = GL_TEXTURE_2D;
-  }
+static BufferView *Heap_meth_alloc(Heap *self, PyObject *args,
+                                   PyObject *kwargs) {
+  static char *keywords[] = {"size", "data", NULL};
+  PyObject *size_arg = Py_None;
+  PyObject *data = Py_None;
 
-  if (samples > self->module_state->limits.max_samples) {
-    samples = self->module_state->limits.max_samples;
+  if (off_render_thread(self->ctx)) {
+    return (BufferView *)render_thread_call(
+        self->ctx, (PyObject *)self, "alloc", args, kwargs, 1);
   }
 
-  ImageFormat fmt;
-  if (!get_image_format(state, state->helper, format, &fmt)) {
-    PyErr_SetString(PyExc_ValueError, "[HyperGL] invalid image format");
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO", keywords, &size_arg,
+                                   &data)) {
     return NULL;
   }
 
-  // --- Critical Section: OpenGL State ---
-  int image = 0;
-  PyMutex_Lock(&self->state_lock);
-
-  if (external) {
-    image = external;
-  } else if (renderbuffer) {
-    glGenRenderbuffers(1, (GLuint *)&image);
-    glBindRenderbuffer(GL_RENDERBUFFER, image);
-    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples > 1 ? samples : 0,
-                                     fmt.internal_format, width, height);
-  } else {
-    glGenTextures(1, (GLuint *)&image);
-    glActiveTexture(self->default_texture_unit);
-    glBindTexture(target, image);
-    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    for (int level = 0; level < levels; ++level) {
-      int w = least_one(width >> level);
-      int h = least_one(height >> level);
-      if (cubemap) {
-        for (int i = 0; i < 6; ++i) {
-          glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level,
-                       fmt.internal_format, w, h, 0, fmt.format, fmt.type,
-                       NULL);
-        }
-      } else if (array) {
-        glTexImage3D(target, level, fmt.internal_format, w, h, array, 0,
-                     fmt.format, fmt.type, NULL);
-      } else {
-        glTexImage2D(target, level, fmt.internal_format, w, h, 0, fmt.format,
-                     fmt.type, NULL);
-      }
+  Py_ssize_t size = 0;
+  if (data != Py_None) {
+    size = data_nbytes(data, self->ctx->module_state);
+    if (size < 0) {
+      return NULL;
     }
   }
-  PyMutex_Unlock(&self->state_lock);
-
-  if (state->Image_type == NULL) {
-    PyErr_SetString(PyExc_RuntimeError,
-                    "HyperGL Internal Error: Image type not loaded");
-    return NULL;
+  if (size_arg != Py_None) {
+    Py_ssize_t requested = to_size(size_arg);
+    if (data != Py_None && requested < size) {
+      PyErr_Format(PyExc_ValueError, "[HyperGL] the data does not fit");
+      return NULL;
+    }
+    size = requested;
   }
-
-  // --- Object Allocation ---
-  Image *res = PyObject_GC_New(Image, state->Image_type);
-  if (!res) {
+  if (size <= 0) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
     return NULL;
   }
-  res->ctx = NULL;
-  res->size = NULL;
-  res->format = NULL;
-  res->faces = NULL;
-  res->layers = NULL;
-
-  res->ctx = (Context *)new_ref(self);
-  res->size = Py_BuildValue("(ii)", width, height);
-  res->format = new_ref(format);
-  res->faces = PyDict_New();
-  res->fmt = fmt;
-  res->image = image;
-  res->width = width;
-  res->height = height;
-  res->samples = samples;
-  res->array = array;
-  res->cubemap = cubemap;
-  res->target = target;
-  res->renderbuffer = renderbuffer;
-  res->external = external;
-  res->layer_count = (array ? array : 1) * (cubemap ? 6 : 1);
-  res->level_count = levels;
-
-  res->bindless_handle = 0;
-  res->is_resident = 0;
-
-  if (fmt.buffer == GL_DEPTH || fmt.buffer == GL_DEPTH_STENCIL) {
-    res->clear_value.clear_floats[0] = 1.0F;
-  }
 
-  res->layers = PyTuple_New(res->layer_count);
-  if (!res->layers) {
-    Py_DECREF(res);
+  const int order = heap_order((size + self->block - 1) / self->block);
+  if (order > self->max_order) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] %zd bytes do not fit in a heap chunk of %zd",
+                 size, self->block << self->max_order);
     return NULL;
   }
 
-  for (int i = 0; i < res->layer_count; ++i) {
-    PyObject *key = Py_BuildValue("(ii)", i, 0);
-    if (!key) {
-      Py_DECREF(res);
-      return NULL;
-    }
-    ImageFace *face = build_image_face(res, key);
-    Py_DECREF(key);
-    if (!face) {
-      Py_DECREF(res); // triggers dealloc -> cleanup
+  PyMutex_Lock(&self->lock);
+  HeapChunk *chunk = NULL;
+  Py_ssize_t offset = -1;
+  for (int i = 0; i < self->chunk_count && offset < 0; ++i) {
+    chunk = &self->chunks[i];
+    offset = heap_chunk_alloc(self, chunk, order);
+  }
+  if (offset < 0) {
+    chunk = heap_add_chunk(self);
+    if (!chunk) {
+      PyMutex_Unlock(&self->lock);
       return NULL;
     }
-    PyTuple_SetItem(res->layers, i, (PyObject *)face);
+    offset = heap_chunk_alloc(self, chunk, order);
   }
+  self->used += self->block << order;
+  Buffer *buffer = (Buffer *)new_ref(chunk->buffer);
+  PyMutex_Unlock(&self->lock);
+
+  BufferView *res =
+      PyObject_New(BufferView, self->ctx->module_state->BufferView_type);
+  if (!res) {
+    // Give the block back, the chunk owns the buffer
+    PyMutex_Lock(&self->lock);
+    heap_chunk_free(self, chunk, offset);
+    self->used -= self->block << order;
+    PyMutex_Unlock(&self->lock);
+    Py_DECREF(buffer);
+    return NULL;
+  }
+  res->buffer = buffer;
+  res->offset = offset * self->block;
+  res->size = size;
+  res->heap = (Heap *)new_ref(self);
 
-  // --- Data Upload ---
   if (data != Py_None) {
-    if (Image_write_internal(res, data) < 0) {
+    PyObject *written = PyObject_CallMethod((PyObject *)res, "write", "(O)",
+                                            data);
+    if (!written) {
       Py_DECREF(res);
       return NULL;
     }
+    Py_DECREF(written);
   }
-
-  PyObject_GC_Track(res);
   return res;
 }
 
-static PyObject *Image_meth_get_handle(Image *self, PyObject *args) {
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] context lost");
+// The range is reused by the next alloc(), free it once the GPU is done with
+// it (e.g. after the frame that last drew from it)
+static PyObject *Heap_meth_free(Heap *self, PyObject *arg) {
+  if (Py_TYPE(arg) != self->ctx->module_state->BufferView_type ||
+      ((BufferView *)arg)->heap != self) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the view is not allocated from this heap");
     return NULL;
   }
+  BufferView *view = (BufferView *)arg;
 
-  // Lazy creation of the handle
-  if (self->bindless_handle == 0) {
-    if (!glGetTextureHandleARB) {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "[HyperGL] Bindless textures not supported "
-                      "(GL_ARB_bindless_texture missing)");
-      return NULL;
+  PyMutex_Lock(&self->lock);
+  int order = -1;
+  for (int i = 0; i < self->chunk_count; ++i) {
+    if (self->chunks[i].buffer == view->buffer) {
+      order = heap_chunk_free(self, &self->chunks[i],
+                              view->offset / self->block);
+      break;
     }
+  }
+  if (order >= 0) {
+    self->used -= self->block << order;
+  }
+  PyMutex_Unlock(&self->lock);
 
-    PyMutex_Lock(&self->ctx->state_lock);
-    // Ensure texture is bound or just pass ID if DSA is supported,
-    // but glGetTextureHandleARB usually takes the texture ID directly.
-    self->bindless_handle = glGetTextureHandleARB(self->image);
-    PyMutex_Unlock(&self->ctx->state_lock);
+  if (order < 0) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the view is not allocated from this heap");
+    return NULL;
+  }
+  Py_CLEAR(view->heap);
+  Py_RETURN_NONE;
+}
 
-    if (self->bindless_handle == 0) {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "[HyperGL] Failed to create texture handle");
-      return NULL;
-    }
+static PyObject *Heap_get_buffers(Heap *self, void *closure) {
+  PyMutex_Lock(&self->lock);
+  PyObject *res = PyTuple_New(self->chunk_count);
+  for (int i = 0; res && i < self->chunk_count; ++i) {
+    PyTuple_SET_ITEM(res, i, new_ref(self->chunks[i].buffer));
   }
+  PyMutex_Unlock(&self->lock);
+  return res;
+}
 
-  return PyLong_FromUnsignedLongLong(self->bindless_handle);
+static PyObject *Heap_get_used(Heap *self, void *closure) {
+  PyMutex_Lock(&self->lock);
+  const Py_ssize_t used = self->used;
+  PyMutex_Unlock(&self->lock);
+  return PyLong_FromSsize_t(used);
 }
 
-static PyObject *Image_meth_make_resident(Image *self, PyObject *args) {
-  if (self->ctx->is_lost) {
-    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
+static PyObject *Heap_get_size(Heap *self, void *closure) {
+  return PyLong_FromSsize_t((self->block << self->max_order) *
+                            Atomic_Load(&self->chunk_count));
+}
+
+// Blocks are a power of two times the bindable alignment. A chunk holds
+// `size` bytes rounded up to a power of two blocks, more chunks (GL buffers)
+// are added as the heap fills up.
+static Heap *Context_meth_heap(Context *self, PyObject *args,
+                               PyObject *kwargs) {
+  static char *keywords[] = {"size", "kind", "block", NULL};
+  Py_ssize_t size;
+  PyObject *kind = NULL;
+  Py_ssize_t block = 256;
+
+  if (off_render_thread(self)) {
+    return (Heap *)render_thread_call(self, (PyObject *)self, "heap",
+                                      args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "n|U$n", keywords, &size,
+                                   &kind, &block)) {
     return NULL;
   }
 
-  int resident = 1; // Default True
-  if (!PyArg_ParseTuple(args, "|p", &resident)) {
+  int alignment = 16;
+  if (!kind || PyUnicode_EqualToUTF8(kind, "vertex") ||
+      PyUnicode_EqualToUTF8(kind, "index")) {
+    alignment = 16;
+  } else if (PyUnicode_EqualToUTF8(kind, "uniform")) {
+    alignment = self->limits.uniform_buffer_offset_alignment;
+  } else if (PyUnicode_EqualToUTF8(kind, "storage")) {
+    alignment = self->limits.storage_buffer_offset_alignment;
+  } else {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] kind must be 'vertex', 'index', 'uniform' or "
+                 "'storage'");
     return NULL;
   }
 
-  if (self->bindless_handle == 0) {
-    PyErr_SetString(
-        PyExc_RuntimeError,
-        "[HyperGL] Texture has no handle. Call get_handle() first.");
+  if (block <= 0 || (block & (block - 1))) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the block size must be a power of two");
+    return NULL;
+  }
+  if (block < alignment) {
+    block = alignment;
+  }
+  if (size < block) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
     return NULL;
   }
 
-  PyMutex_Lock(&self->ctx->state_lock);
-  if (resident && !self->is_resident) {
-    glMakeTextureHandleResidentARB(self->bindless_handle);
-    if (glGetError() == GL_NO_ERROR) {
-      self->is_resident = 1;
-    } else {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "[HyperGL] Failed to make texture handle resident");
-      return NULL;
-    }
-  } else if (!resident && self->is_resident) {
-    glMakeTextureHandleNonResidentARB(self->bindless_handle);
-    if (glGetError() == GL_NO_ERROR) {
-      self->is_resident = 0;
-    } else {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "[HyperGL] Failed to make texture handle non-resident");
-      return NULL;
-    }
+  const int max_order = heap_order((size + block - 1) / block);
+  if (max_order > 40 || (block << max_order) <= 0) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid size");
+    return NULL;
   }
-  PyMutex_Unlock(&self->ctx->state_lock);
 
-  Py_RETURN_NONE;
-}
+  Heap *res = PyObject_New(Heap, self->module_state->Heap_type);
+  if (!res) {
+    return NULL;
+  }
+  res->ctx = (Context *)new_ref(self);
+  res->lock = (PyMutex){0};
+  res->kind = kind ? new_ref(kind) : PyUnicode_FromString("vertex");
+  res->chunks = NULL;
+  res->chunk_count = 0;
+  res->max_order = max_order;
+  res->block = block;
+  res->used = 0;
+  if (!res->kind) {
+    Py_DECREF(res);
+    return NULL;
+  }
 
-static PyObject *Image_meth_clear(const Image *self, PyObject *args) {
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+  // The first chunk is allocated up front so errors surface here
+  if (!heap_add_chunk(res)) {
+    Py_DECREF(res);
     return NULL;
   }
+  return res;
+}
 
-  const int count = (int)PyTuple_Size(self->layers);
+// -----------------------------------------------------------------------------
+// Type: MeshPool
+// -----------------------------------------------------------------------------
 
-  // Get all FBO IDs into a stack-allocated or temporary C array.
-  // This happens while we still own the GIL/Thread State.
-  int *fbo_ids = (int *)PyMem_Malloc(count * sizeof(int));
-  if (!fbo_ids) {
-    return PyErr_NoMemory();
+static int range_init(RangeAllocator *self, Py_ssize_t capacity) {
+  self->ranges = PyMem_Malloc(sizeof(PoolRange) * 8);
+  if (!self->ranges) {
+    PyErr_NoMemory();
+    return -1;
   }
+  self->ranges[0] = (PoolRange){0, capacity};
+  self->count = 1;
+  self->capacity = 8;
+  return 0;
+}
 
-  for (int i = 0; i < count; ++i) {
-    ImageFace *face = (ImageFace *)PyTuple_GetItem(self->layers, i);
-    fbo_ids[i] = face->framebuffer->obj;
+static Py_ssize_t range_alloc(RangeAllocator *self, Py_ssize_t count) {
+  for (int i = 0; i < self->count; ++i) {
+    PoolRange *range = &self->ranges[i];
+    if (range->count >= count) {
+      const Py_ssize_t start = range->start;
+      range->start += count;
+      range->count -= count;
+      if (!range->count) {
+        memmove(range, range + 1, sizeof(PoolRange) * (self->count - i - 1));
+        self->count -= 1;
+      }
+      return start;
+    }
   }
+  return -1;
+}
 
-  Py_BEGIN_ALLOW_THREADS PyMutex_Lock(&self->ctx->state_lock);
+// Insert and merge with the neighbours
+static int range_free(RangeAllocator *self, Py_ssize_t start,
+                      Py_ssize_t count) {
+  if (!count) {
+    return 0;
+  }
 
-  int prev_draw = self->ctx->current_draw_framebuffer;
+  int i = 0;
+  while (i < self->count && self->ranges[i].start < start) {
+    i += 1;
+  }
 
-  for (int i = 0; i < count; ++i) {
-    if (self->ctx->current_draw_framebuffer != fbo_ids[i]) {
-      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_ids[i]);
-      self->ctx->current_draw_framebuffer = fbo_ids[i];
+  const int merge_prev =
+      i > 0 && self->ranges[i - 1].start + self->ranges[i - 1].count == start;
+  const int merge_next =
+      i < self->count && start + count == self->ranges[i].start;
+
+  if (merge_prev && merge_next) {
+    self->ranges[i - 1].count += count + self->ranges[i].count;
+    memmove(&self->ranges[i], &self->ranges[i + 1],
+            sizeof(PoolRange) * (self->count - i - 1));
+    self->count -= 1;
+  } else if (merge_prev) {
+    self->ranges[i - 1].count += count;
+  } else if (merge_next) {
+    self->ranges[i].start = start;
+    self->ranges[i].count += count;
+  } else {
+    if (self->count == self->capacity) {
+      PoolRange *ranges = PyMem_Realloc(
+          self->ranges, sizeof(PoolRange) * self->capacity * 2);
+      if (!ranges) {
+        PyErr_NoMemory();
+        return -1;
+      }
+      self->ranges = ranges;
+      self->capacity *= 2;
     }
-    clear_bound_image(self);
+    memmove(&self->ranges[i + 1], &self->ranges[i],
+            sizeof(PoolRange) * (self->count - i));
+    self->ranges[i] = (PoolRange){start, count};
+    self->count += 1;
   }
+  return 0;
+}
 
-  // Restore state
-  if (self->ctx->current_draw_framebuffer != prev_draw) {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prev_draw);
-    self->ctx->current_draw_framebuffer = prev_draw;
+static Buffer *mesh_pool_buffer(Context *ctx, Py_ssize_t size, int index) {
+  PyObject *kwargs = Py_BuildValue("{snsOsO}", "size", size, "access",
+                                   ctx->module_state->str_dynamic_draw, "index",
+                                   index ? Py_True : Py_False);
+  if (!kwargs) {
+    return NULL;
   }
-
-  PyMutex_Unlock(&self->ctx->state_lock);
-  Py_END_ALLOW_THREADS
-
-      PyMem_Free(fbo_ids);
-  Py_RETURN_NONE;
+  Buffer *res =
+      Context_meth_buffer(ctx, ctx->module_state->empty_tuple, kwargs);
+  Py_DECREF(kwargs);
+  return res;
 }
 
-static PyObject *Image_meth_write(const Image *self, PyObject *args,
-                                  PyObject *kwargs) {
-  static char *keywords[] = {"data", "size", "offset", "layer", "level", NULL};
+static Mesh *MeshPool_meth_add(MeshPool *self, PyObject *args,
+                               PyObject *kwargs) {
+  static char *keywords[] = {"vertices", "indices", NULL};
+  PyObject *vertices;
+  PyObject *indices;
 
-  PyObject *data;
-  PyObject *size_arg = Py_None;
-  PyObject *offset_arg = Py_None;
-  PyObject *layer_arg = Py_None;
-  int level = 0;
+  if (off_render_thread(self->ctx)) {
+    return (Mesh *)render_thread_call(self->ctx, (PyObject *)self, "add",
+                                      args, kwargs, 1);
+  }
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OOOi", keywords, &data,
-                                   &size_arg, &offset_arg, &layer_arg,
-                                   &level)) {
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO", keywords, &vertices,
+                                   &indices)) {
     return NULL;
   }
 
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+  const ModuleState *state = self->ctx->module_state;
+  const Py_ssize_t vertex_bytes = data_nbytes(vertices, state);
+  if (vertex_bytes < 0) {
     return NULL;
   }
-
-  int level_w = least_one(self->width >> level);
-  int level_h = least_one(self->height >> level);
-  int layer = (layer_arg != Py_None) ? to_int(layer_arg) : 0;
-
-  IntPair size;
-  IntPair offset;
-  if (!to_int_pair(&size, size_arg, level_w, level_h) ||
-      !to_int_pair(&offset, offset_arg, 0, 0)) {
-    PyErr_Format(PyExc_TypeError,
-                 "[HyperGL] size and offset must be tuples of 2 ints");
+  const Py_ssize_t index_bytes = data_nbytes(indices, state);
+  if (index_bytes < 0) {
     return NULL;
   }
-
-  if (size.x <= 0 || size.y <= 0 || size.x + offset.x > level_w ||
-      size.y + offset.y > level_h) {
+  if (!vertex_bytes || vertex_bytes % self->stride) {
     PyErr_Format(PyExc_ValueError,
-                 "[HyperGL] invalid size or offset for level %d", level);
+                 "[HyperGL] the vertex data must be a multiple of the %d "
+                 "byte stride",
+                 self->stride);
     return NULL;
   }
-
-  if (layer < 0 || layer >= self->layer_count ||
-      (layer_arg != Py_None && !self->cubemap && !self->array)) {
-    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid layer selection");
+  if (!index_bytes || index_bytes % self->index_size) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the index data must be a multiple of %d bytes",
+                 self->index_size);
     return NULL;
   }
 
-  int expected_size = size.x * size.y * self->fmt.pixel_size;
-  if (layer_arg == Py_None) {
-    expected_size *= self->layer_count;
-  }
-
-  BufferView *buffer_view = NULL;
-  Py_buffer view = {0};
-  PyObject *mem = NULL;
-
-  if (Py_TYPE(data) == self->ctx->module_state->Buffer_type ||
-      Py_TYPE(data) == self->ctx->module_state->BufferView_type) {
-    buffer_view = (Py_TYPE(data) == self->ctx->module_state->Buffer_type)
-                      ? (BufferView *)PyObject_CallMethod(data, "view", NULL)
-                      : (BufferView *)Py_NewRef(data);
-  } else {
-    mem = PyMemoryView_GetContiguous(data, PyBUF_READ, 'C');
-    if (!mem) {
-      return NULL;
-    }
-    if (PyObject_GetBuffer(mem, &view, PyBUF_SIMPLE)) {
-      Py_DECREF(mem);
-      return NULL;
-    }
-  }
-
-  if ((buffer_view ? buffer_view->size : (int)view.len) != expected_size) {
-    PyErr_Format(PyExc_ValueError, "[HyperGL] data size mismatch: expected %d",
-                 expected_size);
-    goto cleanup;
-  }
-
-  PyMutex_Lock(&self->ctx->state_lock);
-
-  glActiveTexture(self->ctx->default_texture_unit);
-  glBindTexture(self->target, self->image);
+  const Py_ssize_t vertex_count = vertex_bytes / self->stride;
+  const Py_ssize_t index_count = index_bytes / self->index_size;
 
-  void *pixels =
-      buffer_view ? (unsigned char *)NULL + buffer_view->offset : view.buf;
-
-  if (buffer_view) {
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_view->buffer->buffer);
-  }
-
-  if (self->cubemap) {
-    int stride = size.x * size.y * self->fmt.pixel_size;
-    if (layer_arg != Py_None) {
-      glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, level, offset.x,
-                      offset.y, size.x, size.y, self->fmt.format,
-                      self->fmt.type, pixels);
-    } else {
-      for (int i = 0; i < 6; ++i) {
-        glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, offset.x,
-                        offset.y, size.x, size.y, self->fmt.format,
-                        self->fmt.type, (char *)pixels + ((size_t)stride * i));
-      }
+  PyMutex_Lock(&self->lock);
+  const Py_ssize_t base_vertex = range_alloc(&self->vertices, vertex_count);
+  Py_ssize_t first_index = -1;
+  if (base_vertex >= 0) {
+    first_index = range_alloc(&self->indices, index_count);
+    if (first_index < 0) {
+      // Cannot fail, the range was just split off
+      range_free(&self->vertices, base_vertex, vertex_count);
     }
-  } else if (self->array) {
-    int depth = (layer_arg != Py_None) ? 1 : self->layer_count;
-    glTexSubImage3D(self->target, level, offset.x, offset.y,
-                    (layer_arg != Py_None ? layer : 0), size.x, size.y, depth,
-                    self->fmt.format, self->fmt.type, pixels);
-  } else {
-    glTexSubImage2D(self->target, level, offset.x, offset.y, size.x, size.y,
-                    self->fmt.format, self->fmt.type, pixels);
   }
-
-  if (buffer_view) {
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  if (first_index >= 0) {
+    self->vertices_used += vertex_count;
+    self->indices_used += index_count;
   }
+  PyMutex_Unlock(&self->lock);
 
-  PyMutex_Unlock(&self->ctx->state_lock);
-
-  if (mem) {
-    PyBuffer_Release(&view);
-    Py_DECREF(mem);
+  if (first_index < 0) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] the mesh pool is full");
+    return NULL;
   }
-  Py_XDECREF(buffer_view);
-  Py_RETURN_NONE;
 
-cleanup:
-  if (mem) {
-    PyBuffer_Release(&view);
-    Py_DECREF(mem);
+  Mesh *res = PyObject_New(Mesh, state->Mesh_type);
+  if (!res) {
+    PyMutex_Lock(&self->lock);
+    range_free(&self->vertices, base_vertex, vertex_count);
+    range_free(&self->indices, first_index, index_count);
+    self->vertices_used -= vertex_count;
+    self->indices_used -= index_count;
+    PyMutex_Unlock(&self->lock);
+    return NULL;
+  }
+  res->pool = (MeshPool *)new_ref(self);
+  res->first_index = first_index;
+  res->index_count = index_count;
+  res->base_vertex = base_vertex;
+  res->vertex_count = vertex_count;
+
+  // Indices stay relative to the mesh, baseVertex offsets them
+  PyObject *written = PyObject_CallMethod(
+      (PyObject *)self->vertex_buffer, "write", "(On)", vertices,
+      base_vertex * self->stride);
+  if (written) {
+    Py_DECREF(written);
+    written = PyObject_CallMethod((PyObject *)self->index_buffer, "write",
+                                  "(On)", indices,
+                                  first_index * self->index_size);
+  }
+  if (!written) {
+    PyObject *exc = PyErr_GetRaisedException();
+    PyObject *freed = PyObject_CallMethod((PyObject *)self, "free", "(O)", res);
+    Py_XDECREF(freed);
+    PyErr_SetRaisedException(exc);
+    Py_DECREF(res);
+    return NULL;
   }
-  Py_XDECREF(buffer_view);
-  return NULL;
+  Py_DECREF(written);
+  return res;
 }
 
-static PyObject *Image_meth_mipmaps(const Image *self, PyObject *args) {
-  if (self->renderbuffer) {
-    PyErr_Format(PyExc_TypeError,
-                 "[HyperGL] cannot generate mipmaps for renderbuffers");
+// Like Heap.free(), the ranges are reused by the next add()
+static PyObject *MeshPool_meth_free(MeshPool *self, PyObject *arg) {
+  if (Py_TYPE(arg) != self->ctx->module_state->Mesh_type ||
+      ((Mesh *)arg)->pool != self) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the mesh is not allocated from this pool");
     return NULL;
   }
+  Mesh *mesh = (Mesh *)arg;
 
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
-    return NULL;
+  PyMutex_Lock(&self->lock);
+  int error = range_free(&self->vertices, mesh->base_vertex,
+                         mesh->vertex_count);
+  if (!error) {
+    self->vertices_used -= mesh->vertex_count;
+    error = range_free(&self->indices, mesh->first_index, mesh->index_count);
+    if (!error) {
+      self->indices_used -= mesh->index_count;
+    }
   }
+  PyMutex_Unlock(&self->lock);
 
-  PyMutex_Lock(&self->ctx->state_lock);
-
-  glActiveTexture(self->ctx->default_texture_unit);
-  glBindTexture(self->target, self->image);
-  glGenerateMipmap(self->target);
-
-  PyMutex_Unlock(&self->ctx->state_lock);
-
+  if (error) {
+    return NULL;
+  }
+  Py_CLEAR(mesh->pool);
   Py_RETURN_NONE;
 }
 
-static PyObject *Image_meth_read(const Image *self, PyObject *args,
-                                 PyObject *kwargs) {
-  static char *keywords[] = {"size", "offset", "into", NULL};
+// One DrawElementsIndirectCommand per entry, baseInstance counts up through
+// the instances so per-instance data can live in one contiguous buffer
+static PyObject *MeshPool_meth_build_commands(MeshPool *self, PyObject *args,
+                                              PyObject *kwargs) {
+  static char *keywords[] = {"instances", "base_instance", NULL};
+  PyObject *instances;
+  Py_ssize_t base_instance = 0;
 
-  PyObject *size_arg = Py_None;
-  PyObject *offset_arg = Py_None;
-  PyObject *into = Py_None;
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "build_commands",
+                              args, kwargs, 1);
+  }
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OOO", keywords, &size_arg,
-                                   &offset_arg, &into)) {
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", keywords, &instances,
+                                   &base_instance)) {
     return NULL;
   }
 
-  IntPair size;
-  IntPair offset;
-  ImageFace *first_layer = (ImageFace *)PyTuple_GetItem(self->layers, 0);
-  if (!parse_size_and_offset(first_layer, size_arg, offset_arg, &size,
-                             &offset)) {
+  PyObject *seq =
+      PySequence_Fast(instances, "[HyperGL] instances must be a sequence");
+  if (!seq) {
     return NULL;
   }
 
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+  const Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+  PyObject *res = PyBytes_FromStringAndSize(
+      NULL, count * (Py_ssize_t)sizeof(DrawElementsIndirectCommand));
+  if (!res) {
+    Py_DECREF(seq);
     return NULL;
   }
 
-  if (self->array || self->cubemap) {
-    if (into != Py_None) {
-      PyErr_Format(PyExc_TypeError,
-                   "[HyperGL] cannot read into user buffer for layered images");
-      return NULL;
-    }
+  DrawElementsIndirectCommand *out =
+      (DrawElementsIndirectCommand *)PyBytes_AS_STRING(res);
+  PyTypeObject *mesh_type = self->ctx->module_state->Mesh_type;
+  Py_ssize_t instance = base_instance;
 
-    int write_size = size.x * size.y * self->fmt.pixel_size;
-    PyObject *res = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)write_size *
-                                                        self->layer_count);
-    for (int i = 0; i < self->layer_count; ++i) {
-      ImageFace *src = (ImageFace *)PyTuple_GetItem(self->layers, i);
-      PyObject *chunk = PyMemoryView_FromMemory(PyBytes_AsString(res) +
-                                                    ((size_t)write_size * i),
-                                                write_size, PyBUF_WRITE);
-      PyObject *temp = read_image_face(src, size, offset, chunk);
-      if (!temp) {
-        Py_DECREF(chunk);
-        Py_DECREF(res);
-        return NULL;
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    PyObject *mesh_obj = item;
+    Py_ssize_t instance_count = 1;
+
+    if (Py_TYPE(item) != mesh_type) {
+      if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+        PyErr_Format(PyExc_TypeError,
+                     "[HyperGL] instances must be meshes or (mesh, count) "
+                     "pairs");
+        goto fail;
+      }
+      mesh_obj = PyTuple_GET_ITEM(item, 0);
+      instance_count = to_size(PyTuple_GET_ITEM(item, 1));
+      if (instance_count < 0) {
+        if (!PyErr_Occurred()) {
+          PyErr_Format(PyExc_ValueError, "[HyperGL] invalid instance count");
+        }
+        goto fail;
       }
-      Py_DECREF(chunk);
-      Py_DECREF(temp);
     }
-    return res;
+
+    if (Py_TYPE(mesh_obj) != mesh_type ||
+        ((Mesh *)mesh_obj)->pool != self) {
+      PyErr_Format(PyExc_ValueError,
+                   "[HyperGL] the mesh is not allocated from this pool");
+      goto fail;
+    }
+    if (instance < 0 || instance_count > UINT32_MAX ||
+        instance > UINT32_MAX - instance_count) {
+      PyErr_Format(PyExc_OverflowError, "[HyperGL] too many instances");
+      goto fail;
+    }
+
+    const Mesh *mesh = (Mesh *)mesh_obj;
+    out[i].count = (uint32_t)mesh->index_count;
+    out[i].instanceCount = (uint32_t)instance_count;
+    out[i].firstIndex = (uint32_t)mesh->first_index;
+    out[i].baseVertex = (int32_t)mesh->base_vertex;
+    out[i].baseInstance = (uint32_t)instance;
+    instance += instance_count;
   }
 
-  return read_image_face(first_layer, size, offset, into);
-}
+  Py_DECREF(seq);
+  return res;
 
-static PyObject *Image_meth_blit(const Image *self, PyObject *args,
-                                 PyObject *kwargs) {
-  static char *keywords[] = {"target", "offset", "size",
-                             "crop",   "filter", NULL};
+fail:
+  Py_DECREF(seq);
+  Py_DECREF(res);
+  return NULL;
+}
 
-  PyObject *target = Py_None;
-  PyObject *offset = Py_None;
-  PyObject *size = Py_None;
-  PyObject *crop = Py_None;
-  int filter = 0;
+// Fixed capacity in vertices and indices, both buffers are allocated up front.
+// Counts are limited to what the indirect command fields can address.
+static MeshPool *Context_meth_mesh_pool(Context *self, PyObject *args,
+                                        PyObject *kwargs) {
+  static char *keywords[] = {"stride", "vertices", "indices", "short_index",
+                             NULL};
+  int stride;
+  Py_ssize_t vertices;
+  Py_ssize_t indices;
+  int short_index = 0;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOOp", keywords, &target,
-                                   &offset, &size, &crop, &filter)) {
-    return NULL;
+  if (off_render_thread(self)) {
+    return (MeshPool *)render_thread_call(self, (PyObject *)self, "mesh_pool",
+                                          args, kwargs, 1);
   }
 
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "inn|$p", keywords, &stride,
+                                   &vertices, &indices, &short_index)) {
     return NULL;
   }
 
-  ImageFace *src = (ImageFace *)PyTuple_GetItem(self->layers, 0);
-  return blit_image_face(src, target, offset, size, crop, filter);
-}
-
-static ImageFace *Image_meth_face(Image *self, PyObject *args,
-                                  PyObject *kwargs) {
-  static char *keywords[] = {"layer", "level", NULL};
-
-  int layer = 0;
-  int level = 0;
+  VALIDATE(stride > 0, PyExc_ValueError, "[HyperGL] invalid stride");
+  VALIDATE(vertices > 0 && vertices <= INT32_MAX &&
+               vertices <= PY_SSIZE_T_MAX / stride,
+           PyExc_ValueError, "[HyperGL] invalid vertex count");
+  VALIDATE(indices > 0 && indices <= INT32_MAX, PyExc_ValueError,
+           "[HyperGL] invalid index count");
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ii", keywords, &layer,
-                                   &level)) {
+  MeshPool *res = PyObject_New(MeshPool, self->module_state->MeshPool_type);
+  if (!res) {
     return NULL;
   }
+  res->ctx = (Context *)new_ref(self);
+  res->lock = (PyMutex){0};
+  res->vertex_buffer = NULL;
+  res->index_buffer = NULL;
+  res->vertices = (RangeAllocator){0};
+  res->indices = (RangeAllocator){0};
+  res->vertex_capacity = vertices;
+  res->index_capacity = indices;
+  res->vertices_used = 0;
+  res->indices_used = 0;
+  res->stride = stride;
+  res->index_size = short_index ? 2 : 4;
 
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+  if (range_init(&res->vertices, vertices) < 0 ||
+      range_init(&res->indices, indices) < 0) {
+    Py_DECREF(res);
     return NULL;
   }
 
-  if (layer < 0 || layer >= self->layer_count) {
-    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid layer");
+  res->vertex_buffer = mesh_pool_buffer(self, vertices * stride, 0);
+  if (!res->vertex_buffer) {
+    Py_DECREF(res);
     return NULL;
   }
-
-  if (level > self->level_count) {
-    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid level");
+  res->index_buffer =
+      mesh_pool_buffer(self, indices * res->index_size, 1);
+  if (!res->index_buffer) {
+    Py_DECREF(res);
     return NULL;
   }
-
-  PyObject *key = Py_BuildValue("(ii)", layer, level);
-  ImageFace *res = build_image_face(self, key);
-  Py_DECREF(key);
   return res;
 }
 
-static PyObject *Image_get_clear_value(const Image *self, void *closure) {
-  if (self->fmt.clear_type == 'x') {
-    return Py_BuildValue("dI", (double)self->clear_value.clear_floats[0],
-                         self->clear_value.clear_uints[1]);
-  }
-  if (self->fmt.components == 1) {
-    if (self->fmt.clear_type == 'f') {
-      return PyFloat_FromDouble(self->clear_value.clear_floats[0]);
-    }
-    if (self->fmt.clear_type == 'i') {
-      return PyLong_FromLong(self->clear_value.clear_ints[0]);
-    }
-    if (self->fmt.clear_type == 'u') {
-      return PyLong_FromUnsignedLong(self->clear_value.clear_uints[0]);
-    }
+// -----------------------------------------------------------------------------
+// Type: Image
+// -----------------------------------------------------------------------------
+
+static int Image_write_internal(const Image *self, PyObject *data) {
+  if (self->ctx->is_lost) {
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return -1;
   }
-  PyObject *res = PyTuple_New(self->fmt.components);
-  for (int i = 0; i < self->fmt.components; ++i) {
-    if (self->fmt.clear_type == 'f') {
-      PyTuple_SetItem(res, i,
-                      PyFloat_FromDouble(self->clear_value.clear_floats[i]));
-    } else if (self->fmt.clear_type == 'i') {
-      PyTuple_SetItem(res, i, PyLong_FromLong(self->clear_value.clear_ints[i]));
-    } else if (self->fmt.clear_type == 'u') {
-      PyTuple_SetItem(
-          res, i, PyLong_FromUnsignedLong(self->clear_value.clear_uints[i]));
-    }
-  }
-  return res;
-}
-
-static int Image_set_clear_value(Image *self, PyObject *value, void *closure) {
-  if (self->fmt.components == 1) {
-    if (self->fmt.clear_type == 'f' && !PyFloat_CheckExact(value)) {
-      PyErr_Format(PyExc_TypeError,
-                   "[HyperGL] the clear value must be a float");
-      return -1;
-    }
-    if (self->fmt.clear_type == 'i' && !PyLong_CheckExact(value)) {
-      PyErr_Format(PyExc_TypeError, "[HyperGL] the clear value must be an int");
-      return -1;
-    }
-    if (self->fmt.clear_type == 'f') {
-      self->clear_value.clear_floats[0] = to_float(value);
-    } else if (self->fmt.clear_type == 'i') {
-      self->clear_value.clear_ints[0] = to_int(value);
-    } else if (self->fmt.clear_type == 'u') {
-      self->clear_value.clear_uints[0] = to_uint(value);
-    }
-    return 0;
-  }
-  PyObject *values = PySequence_Tuple(value);
-  if (!values) {
-    PyErr_Clear();
-    PyErr_Format(PyExc_TypeError, "[HyperGL] the clear value must be a tuple");
+  if (self->renderbuffer) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] cannot write to renderbuffer");
     return -1;
   }
-
-  int size = (int)PyTuple_Size(values);
-
-  if (size != self->fmt.components) {
-    Py_DECREF(values);
-    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid clear value size");
+  if (self->image == 0) {
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] invalid image object");
     return -1;
   }
 
-  if (self->fmt.clear_type == 'f') {
-    for (int i = 0; i < self->fmt.components; ++i) {
-      self->clear_value.clear_floats[i] = to_float(PyTuple_GetItem(values, i));
-    }
-  } else if (self->fmt.clear_type == 'i') {
-    for (int i = 0; i < self->fmt.components; ++i) {
-      self->clear_value.clear_ints[i] = to_int(PyTuple_GetItem(values, i));
-    }
-  } else if (self->fmt.clear_type == 'u') {
-    for (int i = 0; i < self->fmt.components; ++i) {
-      self->clear_value.clear_uints[i] = to_uint(PyTuple_GetItem(values, i));
-    }
-  } else if (self->fmt.clear_type == 'x') {
-    self->clear_value.clear_floats[0] = to_float(PyTuple_GetItem(values, 0));
-    self->clear_value.clear_ints[1] = to_int(PyTuple_GetItem(values, 1));
-  }
-  if (PyErr_Occurred()) {
-    Py_DECREF(values);
+  Py_buffer view;
+  // We use PyBUF_SIMPLE to get a contiguous pointer
+  if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) < 0) {
     return -1;
   }
-  Py_DECREF(values);
-  return 0;
-}
-
-// -----------------------------------------------------------------------------
-// Type: Pipeline
-// -----------------------------------------------------------------------------
-
-static Pipeline *Context_meth_pipeline(Context *self, PyObject *args,
-                                       PyObject *kwargs) {
-  // 1. Variable Declarations
-  PyObject *create_kwargs = NULL;
-  GLObject *program = NULL;
-  PyObject *uniform_layout = NULL;
-  PyObject *validate = NULL;
-  PyObject *layout_bindings = NULL;
-  PyObject *template_obj = NULL;
-  PyObject *framebuffer_attachments = NULL;
-  PyObject *vertex_array_bindings = NULL;
-  PyObject *resource_bindings = NULL;
-  PyObject *settings = NULL;
-  PyObject *uniforms = NULL;
-  PyObject *uniform_data = NULL;
-  GLObject *framebuffer = NULL;
-  GLObject *vertex_array = NULL;
-  DescriptorSet *descriptor_set = NULL;
-  GlobalSettings *global_settings = NULL;
-  Pipeline *res = NULL;
 
-  // 2. Argument Parsing
-  static char *keywords[] = {
-      "vertex_shader", "fragment_shader", "layout",       "resources",
-      "uniforms",      "depth",           "stencil",      "blend",
-      "framebuffer",   "vertex_buffers",  "index_buffer", "short_index",
-      "cull_face",     "topology",        "vertex_count", "instance_count",
-      "first_vertex",  "viewport",        "uniform_data", "viewport_data",
-      "render_data",   "includes",        NULL,
+  enum {
+    CUBEMAP_LAYER_COUNT = 6,
+    SINGLE_LAYER_COUNT = 1,
   };
 
-  PyObject *vertex_shader = NULL;
-  PyObject *fragment_shader = NULL;
-  PyObject *layout = self->module_state->empty_tuple;
-  PyObject *resources = self->module_state->empty_tuple;
-  PyObject *arg_uniforms = Py_None;
-  PyObject *depth = Py_None;
-  PyObject *stencil = Py_None;
-  PyObject *blend = Py_None;
-  PyObject *framebuffer_arg = NULL;
-  PyObject *vertex_buffers = self->module_state->empty_tuple;
-  PyObject *index_buffer = Py_None;
-  int short_index = 0;
-  PyObject *cull_face = self->module_state->str_none;
-  PyObject *topology_arg = self->module_state->str_triangles;
-  int vertex_count = 0;
-  int instance_count = 1;
-  int first_vertex = 0;
-  PyObject *viewport = Py_None;
-  PyObject *arg_uniform_data = Py_None;
-  PyObject *viewport_data = Py_None;
-  PyObject *render_data = Py_None;
-  PyObject *includes = Py_None;
 
-  if (PyTuple_GET_SIZE(args) != 0 || !kwargs) {
-    PyErr_Format(PyExc_TypeError,
-                 "[HyperGL] pipeline only takes keyword-only arguments");
-    return NULL;
+  Py_ssize_t layers;
+
+  if (self->cubemap) {
+      layers = CUBEMAP_LAYER_COUNT;
+  } else if (self->array) {
+      layers = self->array;
+  } else {
+      layers = SINGLE_LAYER_COUNT;
   }
 
-  Pipeline *template = NULL;
-  template_obj = PyDict_GetItemString(kwargs, "template");
-  if (template_obj) {
-    Py_INCREF(template_obj);
-    template = (Pipeline *)template_obj;
+  const Py_ssize_t face_size =
+      image_data_size(&self->fmt, self->width, self->height);
+  Py_ssize_t expected_size = face_size * layers;
+
+  if (view.len < expected_size) {
+    PyErr_Format(
+        PyExc_ValueError,
+        "[HyperGL] data buffer too small (expected %zd bytes, got %zd)",
+        expected_size, view.len);
+    PyBuffer_Release(&view);
+    return -1;
   }
 
-  if (template &&
-      Py_TYPE((PyObject *)template) != self->module_state->Pipeline_type) {
-    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid template");
-    return NULL;
+  // The upload context has bindings of its own, no need to serialize with
+  // the main one
+  const int upload = on_upload_thread(self->ctx);
+  if (!upload) {
+    PyMutex_Lock(&self->ctx->state_lock);
   }
 
-  if (template) {
-    if (PyDict_GetItemString(kwargs, "vertex_shader") ||
-        PyDict_GetItemString(kwargs, "fragment_shader") ||
-        PyDict_GetItemString(kwargs, "layout") ||
-        PyDict_GetItemString(kwargs, "includes")) {
-      PyErr_Format(PyExc_ValueError, "[HyperGL] cannot use template with "
-                                     "shader/layout/includes specified");
-      return NULL;
+  glActiveTexture(self->ctx->default_texture_unit);
+  glBindTexture(self->target, self->image);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+  glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+
+  if (self->fmt.block > 1) {
+    const int internal_format = self->fmt.internal_format;
+    char *ptr = (char *)view.buf;
+    if (self->cubemap) {
+      for (int i = 0; i < 6; ++i) {
+        glCompressedTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, 0, 0,
+                                  self->width, self->height, internal_format,
+                                  (int)face_size, ptr + (i * face_size));
+      }
+    } else if (self->array) {
+      glCompressedTexSubImage3D(self->target, 0, 0, 0, 0, self->width,
+                                self->height, self->array, internal_format,
+                                (int)expected_size, ptr);
+    } else {
+      glCompressedTexSubImage2D(self->target, 0, 0, 0, self->width,
+                                self->height, internal_format,
+                                (int)face_size, ptr);
     }
-    create_kwargs = PyDict_Copy(template->create_kwargs);
-    if (!create_kwargs) {
-      goto fail;
+  } else if (self->cubemap) {
+    char *ptr = (char *)view.buf;
+
+    for (int i = 0; i < 6; ++i) {
+      glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, 0, 0, self->width,
+                      self->height, self->fmt.format, self->fmt.type,
+                      ptr + (i * face_size));
     }
-    PyDict_Update(create_kwargs, kwargs);
-    PyDict_DelItemString(create_kwargs, "template");
+  } else if (self->array) {
+    glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+    glTexSubImage3D(self->target, 0, 0, 0, 0, self->width, self->height,
+                    self->array, self->fmt.format, self->fmt.type, view.buf);
   } else {
-    create_kwargs = PyDict_Copy(kwargs);
-    if (!create_kwargs) {
-      goto fail;
-    }
+    glTexSubImage2D(self->target, 0, 0, 0, self->width, self->height,
+                    self->fmt.format, self->fmt.type, view.buf);
   }
 
-  if (!PyArg_ParseTupleAndKeywords(
-          args, create_kwargs, "|$O!O!OOOOOOOOOpOOiiiOOOOO", keywords,
-          &PyUnicode_Type, &vertex_shader, &PyUnicode_Type, &fragment_shader,
-          &layout, &resources, &arg_uniforms, &depth, &stencil, &blend,
-          &framebuffer_arg, &vertex_buffers, &index_buffer, &short_index,
-          &cull_face, &topology_arg, &vertex_count, &instance_count,
-          &first_vertex, &viewport, &arg_uniform_data, &viewport_data,
-          &render_data, &includes)) {
-    goto fail;
+  if (!upload) {
+    PyMutex_Unlock(&self->ctx->state_lock);
   }
 
-  if (self->is_lost) {
-    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
-    goto fail;
-  }
-  if (!vertex_shader || !fragment_shader || !framebuffer_arg) {
-    PyErr_SetString(PyExc_TypeError, "[HyperGL] missing required args");
-    goto fail;
-  }
+  PyBuffer_Release(&view);
+  return 0;
+}
 
-  Viewport viewport_value;
-  if (!to_viewport(&viewport_value, viewport, 0, 0, 0, 0)) {
-    goto fail;
-  }
+static int Image_traverse(const Image *self, visitproc visit, void *arg) {
+  Py_VISIT(self->ctx);
+  Py_VISIT(self->size);
+  Py_VISIT(self->format);
+  Py_VISIT(self->faces);
+  Py_VISIT(self->layers);
+  Py_VISIT(self->transforms);
+  return 0;
+}
 
-  int topology;
-  if (!get_topology(topology_arg, &topology)) {
-    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid topology: %R", topology_arg);
-    goto fail;
+static int Image_clear(Image *self) {
+  Py_CLEAR(self->ctx);
+  Py_CLEAR(self->size);
+  Py_CLEAR(self->format);
+  Py_CLEAR(self->faces);
+  Py_CLEAR(self->layers);
+  Py_CLEAR(self->transforms);
+  return 0;
+}
+
+static Image *Context_meth_image(Context *self, PyObject *args,
+                                 PyObject *kwargs) { // HAS GC_TRACK
+  ModuleState *state = self->module_state;
+  static char *keywords[] = {"size",     "format", "data",    "samples",
+                             "array",    "levels", "texture", "cubemap",
+                             "external", NULL};
+
+  if (off_render_thread(self)) {
+    return (Image *)render_thread_call(self, (PyObject *)self, "image",
+                                       args, kwargs, 1);
   }
 
-  // 4. Logic & Creation
-  if (template) {
-    program = (GLObject *)new_ref(template->program);
-    Atomic_Increment(&program->uses);
-  } else {
-    program =
-        compile_program(self, includes != Py_None ? includes : self->includes,
-                        vertex_shader, fragment_shader, layout);
+  int width;
+  int height;
+  int samples = 1;
+  int array = 0;
+  int cubemap = 0;
+  int levels = 1;
+  int external = 0;
+  PyObject *format = state->str_rgba8unorm;
+  PyObject *data = Py_None;
+  PyObject *texture = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "(ii)|O!OiiiOpi", keywords,
+                                   &width, &height, &PyUnicode_Type, &format,
+                                   &data, &samples, &array, &levels, &texture,
+                                   &cubemap, &external)) {
+    return NULL;
   }
-  if (!program) {
-    goto fail;
+
+  // --- Validation Logic ---
+  int max_levels = count_mipmaps(width, height);
+  if (levels <= 0) {
+    levels = max_levels;
+  }
+  if (self->is_lost) {
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
+    return NULL;
   }
 
-  if (arg_uniforms != Py_None) {
-    PyObject *tuple =
-        PyObject_CallMethod(self->module_state->helper, "uniforms", "(OOO)",
-                            program->extra, arg_uniforms, arg_uniform_data);
-    if (!tuple) {
-      goto fail;
-    }
-    // try not to break things here. these are borrowed refs.
-    PyObject *item0 = PyTuple_GetItem(tuple, 0);
-    PyObject *item1 = PyTuple_GetItem(tuple, 1);
-    PyObject *item2 = PyTuple_GetItem(tuple, 2);
+  VALIDATE(texture == Py_True || texture == Py_False || texture == Py_None,
+           PyExc_TypeError, "[HyperGL] invalid texture parameter");
+  VALIDATE(!(samples > 1 && texture == Py_True), PyExc_TypeError,
+           "[HyperGL] for multisampled images texture must be False");
+  VALIDATE(samples >= 1 && !(samples & (samples - 1)) && samples <= 16,
+           PyExc_ValueError, "[HyperGL] samples must be 1, 2, 4, 8 or 16");
+  VALIDATE(array >= 0, PyExc_ValueError,
+           "[HyperGL] array must not be negative");
+  VALIDATE(levels <= max_levels, PyExc_ValueError, "[HyperGL] too many levels");
+  VALIDATE(!(cubemap && array), PyExc_TypeError,
+           "[HyperGL] cubemap arrays are not supported");
+  VALIDATE(!(samples > 1 && (array || cubemap)), PyExc_TypeError,
+           "[HyperGL] multisampled array or cubemap images are not supported");
+  VALIDATE(!(texture == Py_False && (array || cubemap)), PyExc_TypeError,
+           "[HyperGL] for array or cubemap images texture must be True");
+  VALIDATE(!(data != Py_None && samples > 1), PyExc_ValueError,
+           "[HyperGL] cannot write to multisampled images");
+  VALIDATE(!(data != Py_None && texture == Py_False), PyExc_ValueError,
+           "[HyperGL] cannot write to renderbuffers");
+  VALIDATE(width > 0 && height > 0, PyExc_ValueError,
+           "[HyperGL] invalid image size");
+  if (external) {
+    VALIDATE(external > 0, PyExc_ValueError,
+             "[HyperGL] external must be a valid GL object");
+  }
 
-    uniforms = PyDictProxy_New(item0);
-    if (!uniforms) {
-      Py_DECREF(tuple);
-      goto fail;
-    }
+  char renderbuffer = (samples > 1 || texture == Py_False) ? 1 : 0;
+  const int max_size = renderbuffer ? self->limits.max_renderbuffer_size
+                       : cubemap    ? self->limits.max_cube_map_texture_size
+                                    : self->limits.max_texture_size;
+  VALIDATE(width <= max_size && height <= max_size, PyExc_ValueError,
+           "[HyperGL] the image size exceeds the %d pixel limit", max_size);
+  VALIDATE(array <= self->limits.max_array_texture_layers, PyExc_ValueError,
+           "[HyperGL] the array exceeds the %d layer limit",
+           self->limits.max_array_texture_layers);
+  int target;
 
-    uniform_layout = new_ref(item1);
-    uniform_data = new_ref(item2);
-    Py_DECREF(tuple);
+  if (cubemap) {
+      target = GL_TEXTURE_CUBE_MAP;
+  } else if (array) {
+      target = GL_TEXTURE_2D_ARRAY;
   } else {
-    uniforms = NULL;
-    if (arg_uniform_data != Py_None) {
-      uniform_data = new_ref(arg_uniform_data);
-    } else {
-      uniform_data = NULL;
-    }
+      target = GL_TEXTURE_2D;
   }
 
-  validate = PyObject_CallMethod(self->module_state->helper, "validate",
-                                 "(OOOOO)", program->extra, layout, resources,
-                                 vertex_buffers, self->info_dict);
-  if (!validate) {
-    goto fail;
+  if (samples > self->limits.max_samples) {
+    samples = self->limits.max_samples;
   }
 
-  layout_bindings = PyObject_CallMethod(self->module_state->helper,
-                                        "layout_bindings", "(O)", layout);
-  if (!layout_bindings) {
-    goto fail;
-  }
-  if (!PyList_Check(layout_bindings)) {
-    PyErr_SetString(PyExc_TypeError,
-                    "[HyperGL] layout_bindings must be a list");
-    goto fail;
+  ImageFormat fmt;
+  if (!get_image_format(state, state->helper, format, &fmt)) {
+    PyErr_SetString(PyExc_ValueError, "[HyperGL] invalid image format");
+    return NULL;
   }
+  VALIDATE(!(fmt.block > 1 && renderbuffer), PyExc_TypeError,
+           "[HyperGL] compressed images must be single sampled textures");
 
-  int layout_count = (int)PyList_Size(layout_bindings);
-  if (layout_count > 0) {
+  // --- Critical Section: OpenGL State ---
+  int image = 0;
+  const int upload = on_upload_thread(self);
+  if (!upload) {
     PyMutex_Lock(&self->state_lock);
-    int prev_program = self->current_program;
-    bind_program_internal(self, program->obj);
-    for (int i = 0; i < layout_count; ++i) {
-      PyObject *obj = PyList_GetItem(layout_bindings, i);
-      if (!PyTuple_Check(obj) || PyTuple_GET_SIZE(obj) < 2) {
-        PyErr_SetString(PyExc_TypeError, "[HyperGL] invalid layout binding");
-        PyMutex_Unlock(&self->state_lock);
-        goto fail;
-      }
-      PyObject *name = PyTuple_GetItem(obj, 0);
-      int binding = to_int(PyTuple_GetItem(obj, 1));
+  }
 
-      const char *name_str = PyUnicode_AsUTF8(name);
-      if (!name_str) {
-        PyMutex_Unlock(&self->state_lock);
-        goto fail;
-      }
+  if (external) {
+    image = external;
+  } else if (renderbuffer) {
+    glGenRenderbuffers(1, (GLuint *)&image);
+    glBindRenderbuffer(GL_RENDERBUFFER, image);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples > 1 ? samples : 0,
+                                     fmt.internal_format, width, height);
+  } else {
+    glGenTextures(1, (GLuint *)&image);
+    glActiveTexture(self->default_texture_unit);
+    glBindTexture(target, image);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-      int location = glGetUniformLocation(program->obj, name_str);
-      if (location >= 0) {
-        glUniform1i(location, binding);
-      } else {
-        GLuint index = glGetUniformBlockIndex(program->obj, name_str);
-        if (index != GL_INVALID_INDEX) {
-          glUniformBlockBinding(program->obj, index, (GLuint)binding);
+    for (int level = 0; level < levels; ++level) {
+      int w = least_one(width >> level);
+      int h = least_one(height >> level);
+      if (fmt.block > 1) {
+        // Specific compressed formats cannot be allocated by glTexImage*
+        const int level_size = (int)image_data_size(&fmt, w, h);
+        if (cubemap) {
+          for (int i = 0; i < 6; ++i) {
+            glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level,
+                                   fmt.internal_format, w, h, 0, level_size,
+                                   NULL);
+          }
+        } else if (array) {
+          glCompressedTexImage3D(target, level, fmt.internal_format, w, h,
+                                 array, 0, level_size * array, NULL);
+        } else {
+          glCompressedTexImage2D(target, level, fmt.internal_format, w, h, 0,
+                                 level_size, NULL);
+        }
+      } else if (cubemap) {
+        for (int i = 0; i < 6; ++i) {
+          glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level,
+                       fmt.internal_format, w, h, 0, fmt.format, fmt.type,
+                       NULL);
         }
+      } else if (array) {
+        glTexImage3D(target, level, fmt.internal_format, w, h, array, 0,
+                     fmt.format, fmt.type, NULL);
+      } else {
+        glTexImage2D(target, level, fmt.internal_format, w, h, 0, fmt.format,
+                     fmt.type, NULL);
       }
     }
-    bind_program_internal(self, prev_program);
-    PyMutex_Unlock(&self->state_lock);
   }
-
-  framebuffer_attachments =
-      PyObject_CallMethod(self->module_state->helper, "framebuffer_attachments",
-                          "(O)", framebuffer_arg);
-  if (!framebuffer_attachments) {
-    goto fail;
+  if (!upload) {
+    PyMutex_Unlock(&self->state_lock);
   }
 
-  if (framebuffer_attachments != Py_None && viewport == Py_None) {
-    PyObject *size = PyTuple_GetItem(framebuffer_attachments, 0);
-    viewport_value.width = to_int(PyTuple_GetItem(size, 0));
-    viewport_value.height = to_int(PyTuple_GetItem(size, 1));
+  if (state->Image_type == NULL) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "HyperGL Internal Error: Image type not loaded");
+    return NULL;
   }
 
-  // All GLObject builders must internally acquire ctx->state_lock
-  framebuffer = build_framebuffer(self, framebuffer_attachments);
-  if (!framebuffer) {
-    goto fail;
+  // --- Object Allocation ---
+  Image *res = PyObject_GC_New(Image, state->Image_type);
+  if (!res) {
+    return NULL;
   }
+  res->ctx = NULL;
+  res->size = NULL;
+  res->format = NULL;
+  res->faces = NULL;
+  res->layers = NULL;
+  res->transforms = NULL;
 
-  vertex_array_bindings =
-      PyObject_CallMethod(self->module_state->helper, "vertex_array_bindings",
-                          "(OO)", vertex_buffers, index_buffer);
-  if (!vertex_array_bindings) {
-    goto fail;
-  }
+  res->ctx = (Context *)new_ref(self);
+  res->size = Py_BuildValue("(ii)", width, height);
+  res->format = new_ref(format);
+  res->faces = PyDict_New();
+  res->fmt = fmt;
+  res->image = image;
+  res->width = width;
+  res->height = height;
+  res->samples = samples;
+  res->array = array;
+  res->cubemap = cubemap;
+  res->target = target;
+  res->renderbuffer = renderbuffer;
+  res->external = external;
+  res->layer_count = (array ? array : 1) * (cubemap ? 6 : 1);
+  res->level_count = levels;
 
-  vertex_array = build_vertex_array(self, vertex_array_bindings);
-  if (!vertex_array) {
-    goto fail;
-  }
+  res->bindless_handle = 0;
+  res->is_resident = 0;
 
-  resource_bindings = PyObject_CallMethod(
-      self->module_state->helper, "resource_bindings", "(O)", resources);
-  if (!resource_bindings) {
-    goto fail;
+  if (fmt.buffer == GL_DEPTH || fmt.buffer == GL_DEPTH_STENCIL) {
+    res->clear_value.clear_floats[0] = 1.0F;
   }
 
-  descriptor_set = build_descriptor_set(self, resource_bindings);
-  if (!descriptor_set) {
-    goto fail;
+  // --- Data Upload ---
+  if (data != Py_None) {
+    if (Image_write_internal(res, data) < 0) {
+      Py_DECREF(res);
+      return NULL;
+    }
   }
 
-  settings = PyObject_CallMethod(self->module_state->helper, "settings",
-                                 "(OOOOO)", cull_face, depth, stencil, blend,
-                                 framebuffer_attachments);
-  if (!settings) {
-    goto fail;
-  }
+  PyObject_GC_Track(res);
+  return res;
+}
 
-  global_settings = build_global_settings(self, settings);
-  if (!global_settings) {
-    goto fail;
+static PyObject *Image_meth_get_handle(Image *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "get_handle",
+                              args, NULL, 1);
   }
 
-  // 5. Allocation
-  res = PyObject_GC_New(Pipeline, self->module_state->Pipeline_type);
-  if (!res) {
-    goto fail;
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] context lost");
+    return NULL;
   }
 
-  // Init pointers to NULL
-  res->ctx = NULL;
-  res->create_kwargs = NULL;
-  res->framebuffer = NULL;
-  res->vertex_array = NULL;
-  res->program = NULL;
-  res->uniforms = NULL;
-  res->uniform_layout = NULL;
-  res->uniform_data = NULL;
-  res->descriptor_set = NULL;
-  res->global_settings = NULL;
-  res->viewport_data = NULL;
-  res->render_data = NULL;
+  // Lazy creation of the handle
+  if (self->bindless_handle == 0) {
+    if (!glGetTextureHandleARB) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "[HyperGL] Bindless textures not supported "
+                      "(GL_ARB_bindless_texture missing)");
+      return NULL;
+    }
 
-  zeromem(&res->uniform_layout_buffer, sizeof(Py_buffer));
-  zeromem(&res->uniform_data_buffer, sizeof(Py_buffer));
-  zeromem(&res->viewport_data_buffer, sizeof(Py_buffer));
-  zeromem(&res->render_data_buffer, sizeof(Py_buffer));
-  zeromem(&res->params, sizeof(RenderParameters));
-  zeromem(&res->viewport, sizeof(Viewport));
+    PyMutex_Lock(&self->ctx->state_lock);
+    // Ensure texture is bound or just pass ID if DSA is supported,
+    // but glGetTextureHandleARB usually takes the texture ID directly.
+    self->bindless_handle = glGetTextureHandleARB(self->image);
+    PyMutex_Unlock(&self->ctx->state_lock);
 
-  res->ctx = self;
-  Py_INCREF(self);
+    if (self->bindless_handle == 0) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "[HyperGL] Failed to create texture handle");
+      return NULL;
+    }
+  }
 
-  // Steal References (Ownership transfer from locals to struct)
-  res->create_kwargs = create_kwargs;
-  create_kwargs = NULL;
-  res->framebuffer = framebuffer;
-  framebuffer = NULL;
-  res->vertex_array = vertex_array;
-  vertex_array = NULL;
-  res->program = program;
-  program = NULL;
-  res->uniforms = uniforms;
-  uniforms = NULL;
-  res->uniform_layout = uniform_layout;
-  uniform_layout = NULL;
-  res->uniform_data = uniform_data;
-  uniform_data = NULL;
-  res->descriptor_set = descriptor_set;
-  descriptor_set = NULL;
-  res->global_settings = global_settings;
-  global_settings = NULL;
+  return PyLong_FromUnsignedLongLong(self->bindless_handle);
+}
 
-  res->topology = topology;
-  res->viewport = viewport_value;
-  res->params.vertex_count = vertex_count;
-  res->params.instance_count = instance_count;
-  res->params.first_vertex = first_vertex;
-  if (index_buffer == Py_None) {
-      res->index_type = INDEX_TYPE_NONE;
-  #ifdef DEBUG
-      if (short_index) {
-          fprintf(stderr,
-              "[HyperGL] short_index set without index buffer\n");
-          abort();
-      }
-  #endif
-  } else {
-      res->index_type = short_index
-          ? GL_UNSIGNED_SHORT
-          : GL_UNSIGNED_INT;
+static PyObject *Image_meth_make_resident(Image *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "make_resident",
+                              args, NULL, 1);
   }
 
-  res->index_size = short_index ? 2 : 4;
+  if (self->ctx->is_lost) {
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
+    return NULL;
+  }
 
-  // 6. MemoryViews
-  if (viewport_data == Py_None) {
-    Py_buffer view = {0};
-    view.buf = (void *)&res->viewport;
-    view.len = sizeof(Viewport);
-    view.readonly = 0;
-    view.itemsize = 1;
-    view.format = NULL;
-    view.ndim = 1;
-    Py_ssize_t shape = view.len;
-    Py_ssize_t stride = 1;
-    view.shape = &shape;
-    view.strides = &stride;
-    view.suboffsets = NULL;
-    view.obj = (PyObject *)res;
-    Py_INCREF(res);
+  int resident = 1; // Default True
+  if (!PyArg_ParseTuple(args, "|p", &resident)) {
+    return NULL;
+  }
 
-    res->viewport_data = PyMemoryView_FromBuffer(&view);
-    if (!res->viewport_data) {
-      Py_DECREF(res);
-      goto fail;
+  if (self->bindless_handle == 0) {
+    PyErr_SetString(
+        PyExc_RuntimeError,
+        "[HyperGL] Texture has no handle. Call get_handle() first.");
+    return NULL;
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+  if (resident && !self->is_resident) {
+    glMakeTextureHandleResidentARB(self->bindless_handle);
+    if (glGetError() == GL_NO_ERROR) {
+      self->is_resident = 1;
+    } else {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "[HyperGL] Failed to make texture handle resident");
+      return NULL;
+    }
+  } else if (!resident && self->is_resident) {
+    glMakeTextureHandleNonResidentARB(self->bindless_handle);
+    if (glGetError() == GL_NO_ERROR) {
+      self->is_resident = 0;
+    } else {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "[HyperGL] Failed to make texture handle non-resident");
+      return NULL;
     }
-  } else {
-    res->viewport_data = new_ref(viewport_data);
   }
+  PyMutex_Unlock(&self->ctx->state_lock);
 
-  if (render_data == Py_None) {
-    Py_buffer view = {0};
-    view.buf = (void *)&res->params;
-    view.len = sizeof(RenderParameters);
-    view.readonly = 0;
-    view.itemsize = 1;
-    view.format = NULL;
-    view.ndim = 1;
-    view.shape = &view.len;
-    view.strides = &view.itemsize;
-    view.suboffsets = NULL;
-    view.obj = (PyObject *)res;
-    Py_INCREF(res);
+  Py_RETURN_NONE;
+}
 
-    res->render_data = PyMemoryView_FromBuffer(&view);
-    if (!res->render_data) {
-      Py_DECREF(res);
-      goto fail;
-    }
-  } else {
-    res->render_data = new_ref(render_data);
+static PyObject *Image_meth_clear(Image *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "clear",
+                              args, NULL, 0);
   }
 
-  // 7. Buffer Acquisition
-  if (PyObject_GetBuffer(res->viewport_data, &res->viewport_data_buffer,
-                         PyBUF_SIMPLE) < 0) {
-    goto fail;
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
   }
-  if (PyObject_GetBuffer(res->render_data, &res->render_data_buffer,
-                         PyBUF_SIMPLE) < 0) {
-    goto fail;
+
+  PyObject *layers = image_layers(self);
+  if (!layers) {
+    return NULL;
   }
+  const int count = (int)PyTuple_Size(layers);
 
-  if (res->uniforms) {
-    if (PyObject_GetBuffer(res->uniform_layout, &res->uniform_layout_buffer,
-                           PyBUF_SIMPLE) < 0) {
-      goto fail;
-    }
-    if (PyObject_GetBuffer(res->uniform_data, &res->uniform_data_buffer,
-                           PyBUF_SIMPLE) < 0) {
-      goto fail;
+  // Get all FBO IDs into a stack-allocated or temporary C array.
+  // This happens while we still own the GIL/Thread State.
+  int *fbo_ids = (int *)PyMem_Malloc(count * sizeof(int));
+  if (!fbo_ids) {
+    return PyErr_NoMemory();
+  }
+
+  for (int i = 0; i < count; ++i) {
+    ImageFace *face = (ImageFace *)PyTuple_GetItem(layers, i);
+    fbo_ids[i] = face->framebuffer->obj;
+  }
+
+  Py_BEGIN_ALLOW_THREADS PyMutex_Lock(&self->ctx->state_lock);
+
+  int prev_draw = self->ctx->current_draw_framebuffer;
+
+  for (int i = 0; i < count; ++i) {
+    if (self->ctx->current_draw_framebuffer != fbo_ids[i]) {
+      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_ids[i]);
+      self->ctx->current_draw_framebuffer = fbo_ids[i];
     }
+    clear_bound_image(self);
   }
 
-  PyObject_GC_Track(res);
+  // Restore state
+  if (self->ctx->current_draw_framebuffer != prev_draw) {
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prev_draw);
+    self->ctx->current_draw_framebuffer = prev_draw;
+  }
 
-  Py_XDECREF(validate);
-  Py_XDECREF(layout_bindings);
-  Py_XDECREF(framebuffer_attachments);
-  Py_XDECREF(vertex_array_bindings);
-  Py_XDECREF(resource_bindings);
-  Py_XDECREF(settings);
+  PyMutex_Unlock(&self->ctx->state_lock);
+  Py_END_ALLOW_THREADS
+
+      PyMem_Free(fbo_ids);
+  Py_RETURN_NONE;
+}
+
+static PyObject *Image_meth_write(const Image *self, PyObject *args,
+                                  PyObject *kwargs) {
+  static char *keywords[] = {"data",  "size",    "offset", "layer",
+                             "level", "convert", NULL};
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "write",
+                              args, kwargs, 1);
+  }
+
+  PyObject *data;
+  PyObject *size_arg = Py_None;
+  PyObject *offset_arg = Py_None;
+  PyObject *layer_arg = Py_None;
+  int level = 0;
+  const char *convert_name = NULL;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OOOi$z", keywords, &data,
+                                   &size_arg, &offset_arg, &layer_arg, &level,
+                                   &convert_name)) {
+    return NULL;
+  }
+
+  const int convert = to_upload_convert(convert_name);
+  if (convert < 0) {
+    return NULL;
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  int level_w = least_one(self->width >> level);
+  int level_h = least_one(self->height >> level);
+  int layer = (layer_arg != Py_None) ? to_int(layer_arg) : 0;
+
+  IntPair size;
+  IntPair offset;
+  if (!to_int_pair(&size, size_arg, level_w, level_h) ||
+      !to_int_pair(&offset, offset_arg, 0, 0)) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] size and offset must be tuples of 2 ints");
+    return NULL;
+  }
+
+  if (size.x <= 0 || size.y <= 0 || size.x + offset.x > level_w ||
+      size.y + offset.y > level_h) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] invalid size or offset for level %d", level);
+    return NULL;
+  }
+
+  if (layer < 0 || layer >= self->layer_count ||
+      (layer_arg != Py_None && !self->cubemap && !self->array)) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid layer selection");
+    return NULL;
+  }
+
+  // Compressed updates cover whole blocks, except at the edges of the level
+  const int block = self->fmt.block;
+  if (block > 1 &&
+      (offset.x % block || offset.y % block ||
+       (size.x % block && offset.x + size.x != level_w) ||
+       (size.y % block && offset.y + size.y != level_h))) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] size and offset must be aligned to %dx%d blocks",
+                 block, block);
+    return NULL;
+  }
+
+  const Py_ssize_t face_size = image_data_size(&self->fmt, size.x, size.y);
+  Py_ssize_t expected_size = face_size;
+  if (layer_arg == Py_None) {
+    expected_size *= self->layer_count;
+  }
+
+  if (convert != CONVERT_NONE && block > 1) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] compressed images cannot convert on upload");
+    return NULL;
+  }
+
+  // The converted texels are uploaded as they are, the image has to store them
+  if (convert != CONVERT_NONE) {
+    const char *format = PyUnicode_AsUTF8(self->format);
+    if (!format) {
+      return NULL;
+    }
+    const int matches =
+        convert == CONVERT_F16       ? self->fmt.type == GL_HALF_FLOAT
+        : convert == CONVERT_SNORM16 ? strstr(format, "16snorm") != NULL
+                                     : strstr(format, "8unorm") != NULL &&
+                                           strstr(format, "srgb") == NULL;
+    if (!matches) {
+      PyErr_Format(PyExc_TypeError,
+                   "[HyperGL] convert \"%s\" does not match the image format "
+                   "\"%s\"",
+                   convert_name, format);
+      return NULL;
+    }
+  }
+
+  BufferView *buffer_view = NULL;
+  Py_buffer view = {0};
+  PyObject *mem = NULL;
+  void *converted = NULL;
+  int row_length = 0;
+
+  if (convert != CONVERT_NONE) {
+    if (Py_TYPE(data) == self->ctx->module_state->Buffer_type ||
+        Py_TYPE(data) == self->ctx->module_state->BufferView_type) {
+      PyErr_Format(PyExc_TypeError, "[HyperGL] convert needs host data");
+      return NULL;
+    }
+    if (PyObject_GetBuffer(data, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS)) {
+      return NULL;
+    }
+    const Py_ssize_t count = convert_source_count(&view);
+    if (count < 0 || converted_size(convert, count) != expected_size) {
+      if (count >= 0) {
+        PyErr_Format(PyExc_ValueError,
+                     "[HyperGL] data size mismatch: expected %zd floats",
+                     convert == CONVERT_UNORM8 ? expected_size
+                                               : expected_size / 2);
+      }
+      PyBuffer_Release(&view);
+      return NULL;
+    }
+    // Converted while staged, the GL upload then reads the packed result
+    converted = PyMem_Malloc(expected_size ? expected_size : 1);
+    if (!converted) {
+      PyBuffer_Release(&view);
+      return PyErr_NoMemory();
+    }
+    convert_floats(convert, converted, view.buf, count);
+  } else if (Py_TYPE(data) == self->ctx->module_state->Buffer_type ||
+             Py_TYPE(data) == self->ctx->module_state->BufferView_type) {
+    buffer_view = (Py_TYPE(data) == self->ctx->module_state->Buffer_type)
+                      ? (BufferView *)PyObject_CallMethod(data, "view", NULL)
+                      : (BufferView *)Py_NewRef(data);
+  } else {
+    // Single layer uploads read strided rows in place, other layouts are
+    // made contiguous first
+    if (PyObject_GetBuffer(data, &view, PyBUF_STRIDED_RO)) {
+      return NULL;
+    }
+    const int single = layer_arg != Py_None || self->layer_count == 1;
+    row_length = block == 1 && single
+                     ? view_row_length(&view, size.y,
+                                       (Py_ssize_t)size.x * self->fmt.pixel_size,
+                                       self->fmt.pixel_size)
+                     : (PyBuffer_IsContiguous(&view, 'C') ? 0 : -1);
+    if (row_length < 0) {
+      PyBuffer_Release(&view);
+      row_length = 0;
+      mem = PyMemoryView_GetContiguous(data, PyBUF_READ, 'C');
+      if (!mem) {
+        return NULL;
+      }
+      if (PyObject_GetBuffer(mem, &view, PyBUF_SIMPLE)) {
+        Py_DECREF(mem);
+        return NULL;
+      }
+    }
+  }
+
+  if (!converted &&
+      (buffer_view ? buffer_view->size : view.len) != expected_size) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] data size mismatch: expected %zd",
+                 expected_size);
+    goto cleanup;
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+
+  glActiveTexture(self->ctx->default_texture_unit);
+  glBindTexture(self->target, self->image);
+
+  void *pixels = buffer_view ? (unsigned char *)NULL + buffer_view->offset
+                : converted ? converted
+                            : view.buf;
+
+  if (buffer_view) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_view->buffer->buffer);
+  }
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length);
+
+  if (block > 1) {
+    const int internal_format = self->fmt.internal_format;
+    if (self->cubemap) {
+      const int first = layer_arg != Py_None ? layer : 0;
+      const int count = layer_arg != Py_None ? 1 : 6;
+      for (int i = 0; i < count; ++i) {
+        glCompressedTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + first + i,
+                                  level, offset.x, offset.y, size.x, size.y,
+                                  internal_format, (int)face_size,
+                                  (char *)pixels + face_size * i);
+      }
+    } else if (self->array) {
+      int depth = (layer_arg != Py_None) ? 1 : self->layer_count;
+      glCompressedTexSubImage3D(self->target, level, offset.x, offset.y,
+                                (layer_arg != Py_None ? layer : 0), size.x,
+                                size.y, depth, internal_format,
+                                (int)expected_size, pixels);
+    } else {
+      glCompressedTexSubImage2D(self->target, level, offset.x, offset.y,
+                                size.x, size.y, internal_format,
+                                (int)face_size, pixels);
+    }
+  } else if (self->cubemap) {
+    const Py_ssize_t stride = face_size;
+    if (layer_arg != Py_None) {
+      glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, level, offset.x,
+                      offset.y, size.x, size.y, self->fmt.format,
+                      self->fmt.type, pixels);
+    } else {
+      for (int i = 0; i < 6; ++i) {
+        glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, level, offset.x,
+                        offset.y, size.x, size.y, self->fmt.format,
+                        self->fmt.type, (char *)pixels + (stride * i));
+      }
+    }
+  } else if (self->array) {
+    int depth = (layer_arg != Py_None) ? 1 : self->layer_count;
+    glTexSubImage3D(self->target, level, offset.x, offset.y,
+                    (layer_arg != Py_None ? layer : 0), size.x, size.y, depth,
+                    self->fmt.format, self->fmt.type, pixels);
+  } else {
+    glTexSubImage2D(self->target, level, offset.x, offset.y, size.x, size.y,
+                    self->fmt.format, self->fmt.type, pixels);
+  }
+
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+  if (buffer_view) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+
+  PyMutex_Unlock(&self->ctx->state_lock);
+
+  if (!buffer_view) {
+    PyBuffer_Release(&view);
+  }
+  PyMem_Free(converted);
+  Py_XDECREF(mem);
+  Py_XDECREF(buffer_view);
+  Py_RETURN_NONE;
+
+cleanup:
+  if (!buffer_view) {
+    PyBuffer_Release(&view);
+  }
+  PyMem_Free(converted);
+  Py_XDECREF(mem);
+  Py_XDECREF(buffer_view);
+  return NULL;
+}
+
+// Tiles are read straight out of the source rows with GL_UNPACK_ROW_LENGTH,
+// so only the pages of the tiles uploaded so far are ever touched.
+static ImageStream *Image_meth_stream_from(Image *self, PyObject *args,
+                                           PyObject *kwargs) {
+  static char *keywords[] = {"source", "tile",   "offset", "layer",
+                             "level",  "budget", NULL};
+  PyObject *source;
+  PyObject *tile_arg = Py_None;
+  Py_ssize_t offset = 0;
+  PyObject *layer_arg = Py_None;
+  int level = 0;
+  Py_ssize_t budget = 4 * 1024 * 1024;
+
+  if (off_render_thread(self->ctx)) {
+    return (ImageStream *)render_thread_call(
+        self->ctx, (PyObject *)self, "stream_from", args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O$nOin", keywords,
+                                   &source, &tile_arg, &offset, &layer_arg,
+                                   &level, &budget)) {
+    return NULL;
+  }
+
+  if (self->renderbuffer) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] cannot stream into a renderbuffer");
+    return NULL;
+  }
+  if (self->fmt.block > 1) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] cannot stream compressed images in tiles");
+    return NULL;
+  }
+  if (level < 0 || level >= self->level_count) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid level");
+    return NULL;
+  }
+  const int layer = layer_arg != Py_None ? to_int(layer_arg) : 0;
+  if (layer < 0 || layer >= self->layer_count ||
+      (layer_arg == Py_None && self->layer_count > 1) ||
+      (layer_arg != Py_None && !self->cubemap && !self->array)) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid layer selection");
+    return NULL;
+  }
+
+  IntPair tile;
+  if (!to_int_pair(&tile, tile_arg, 512, 512)) {
+    PyErr_Format(PyExc_TypeError, "[HyperGL] tile must be a tuple of 2 ints");
+    return NULL;
+  }
+  if (tile.x <= 0 || tile.y <= 0 || budget <= 0 || offset < 0) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid tile, offset or budget");
+    return NULL;
+  }
+
+  const int width = least_one(self->width >> level);
+  const int height = least_one(self->height >> level);
+  const Py_ssize_t expected =
+      (Py_ssize_t)width * height * self->fmt.pixel_size;
+
+  PyObject *mapped = PyObject_CallMethod(self->ctx->module_state->helper,
+                                         "stream_source", "(O)", source);
+  if (!mapped) {
+    return NULL;
+  }
+
+  ImageStream *res =
+      PyObject_New(ImageStream, self->ctx->module_state->ImageStream_type);
+  if (!res) {
+    Py_DECREF(mapped);
+    return NULL;
+  }
+  res->image = (Image *)new_ref(self);
+  res->source = mapped;
+  zeromem(&res->view, sizeof(Py_buffer));
+  if (PyObject_GetBuffer(mapped, &res->view, PyBUF_SIMPLE) < 0) {
+    Py_DECREF(res);
+    return NULL;
+  }
+  if (res->view.len < offset || res->view.len - offset < expected) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] source too small (expected %zd bytes after offset "
+                 "%zd, got %zd)",
+                 expected, offset, res->view.len);
+    Py_DECREF(res);
+    return NULL;
+  }
+
+  res->offset = offset;
+  res->budget = budget;
+  res->target = self->cubemap ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer
+                              : self->target;
+  res->level = level;
+  res->layer = layer;
+  res->width = width;
+  res->height = height;
+  res->tile_width = tile.x < width ? tile.x : width;
+  res->tile_height = tile.y < height ? tile.y : height;
+  res->tiles_x = (width + res->tile_width - 1) / res->tile_width;
+  res->tile_count =
+      res->tiles_x * ((height + res->tile_height - 1) / res->tile_height);
+  res->next_tile = 0;
+  return res;
+}
+
+static void image_stream_release(ImageStream *self) {
+  if (self->view.obj) {
+    PyBuffer_Release(&self->view);
+  }
+  Py_CLEAR(self->source);
+}
+
+// Uploads tiles until `budget` bytes went out (at least one tile), call it
+// once per frame. Returns True once the image is complete.
+static PyObject *ImageStream_meth_step(ImageStream *self, PyObject *args,
+                                       PyObject *kwargs) {
+  static char *keywords[] = {"budget", NULL};
+  Py_ssize_t budget = self->budget;
+
+  if (off_render_thread(self->image->ctx)) {
+    return render_thread_call(self->image->ctx, (PyObject *)self, "step",
+                              args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", keywords, &budget)) {
+    return NULL;
+  }
+
+  if (budget <= 0) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] the budget must be positive");
+    return NULL;
+  }
+
+  if (self->next_tile == self->tile_count) {
+    Py_RETURN_TRUE;
+  }
+
+  Image *image = self->image;
+  if (image->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  const int pixel_size = image->fmt.pixel_size;
+  const unsigned char *base =
+      (const unsigned char *)self->view.buf + self->offset;
+
+  const int upload = on_upload_thread(image->ctx);
+  if (!upload) {
+    PyMutex_Lock(&image->ctx->state_lock);
+  }
+
+  glActiveTexture(image->ctx->default_texture_unit);
+  glBindTexture(image->target, image->image);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, self->width);
+
+  Py_ssize_t sent = 0;
+  do {
+    const int x = (self->next_tile % self->tiles_x) * self->tile_width;
+    const int y = (self->next_tile / self->tiles_x) * self->tile_height;
+    const int w = x + self->tile_width > self->width ? self->width - x
+                                                     : self->tile_width;
+    const int h = y + self->tile_height > self->height ? self->height - y
+                                                       : self->tile_height;
+    const unsigned char *pixels =
+        base + ((Py_ssize_t)y * self->width + x) * pixel_size;
+
+    if (image->array) {
+      glTexSubImage3D(self->target, self->level, x, y, self->layer, w, h, 1,
+                      image->fmt.format, image->fmt.type, pixels);
+    } else {
+      glTexSubImage2D(self->target, self->level, x, y, w, h,
+                      image->fmt.format, image->fmt.type, pixels);
+    }
+
+    sent += (Py_ssize_t)w * h * pixel_size;
+    self->next_tile += 1;
+  } while (self->next_tile < self->tile_count && sent < budget);
+
+  // Image.write() expects tightly packed rows
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+  if (!upload) {
+    PyMutex_Unlock(&image->ctx->state_lock);
+  }
+
+  if (self->next_tile == self->tile_count) {
+    image_stream_release(self);
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+}
+
+static PyObject *ImageStream_get_done(ImageStream *self, void *closure) {
+  return PyBool_FromLong(self->next_tile == self->tile_count);
+}
+
+static PyObject *ImageStream_get_progress(ImageStream *self, void *closure) {
+  return Py_BuildValue("(ii)", self->next_tile, self->tile_count);
+}
+
+static PyObject *ImageStream_get_budget(ImageStream *self, void *closure) {
+  return PyLong_FromSsize_t(self->budget);
+}
+
+static int ImageStream_set_budget(ImageStream *self, PyObject *value,
+                                  void *closure) {
+  if (!value || !PyLong_Check(value)) {
+    PyErr_Format(PyExc_TypeError, "[HyperGL] the budget must be an int");
+    return -1;
+  }
+  const Py_ssize_t budget = PyLong_AsSsize_t(value);
+  if (budget == -1 && PyErr_Occurred()) {
+    return -1;
+  }
+  if (budget <= 0) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] the budget must be positive");
+    return -1;
+  }
+  self->budget = budget;
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Frame Stacks
+// -----------------------------------------------------------------------------
+
+static FrameStack *Context_meth_frame_stack(Context *self, PyObject *args,
+                                            PyObject *kwargs) {
+  static char *keywords[] = {"image", "size", NULL};
+  PyObject *source_arg;
+  int size = 4;
+
+  if (off_render_thread(self)) {
+    return (FrameStack *)render_thread_call(
+        self, (PyObject *)self, "frame_stack", args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|i", keywords,
+                                   self->module_state->Image_type, &source_arg,
+                                   &size)) {
+    return NULL;
+  }
+
+  Image *source = (Image *)source_arg;
+  VALIDATE(size >= 1, PyExc_ValueError,
+           "[HyperGL] the frame stack size must be at least 1");
+  VALIDATE(!source->array && !source->cubemap && source->fmt.block == 1,
+           PyExc_TypeError,
+           "[HyperGL] frame stacks take single layer uncompressed images");
+
+  PyObject *image_kwargs =
+      Py_BuildValue("{sOsOsisO}", "size", source->size, "format",
+                    source->format, "array", size, "texture", Py_True);
+  if (!image_kwargs) {
+    return NULL;
+  }
+  Image *image =
+      Context_meth_image(self, self->module_state->empty_tuple, image_kwargs);
+  Py_DECREF(image_kwargs);
+  if (!image) {
+    return NULL;
+  }
+  image->clear_value = source->clear_value;
+
+  FrameStack *res =
+      PyObject_New(FrameStack, self->module_state->FrameStack_type);
+  if (!res) {
+    Py_DECREF(image);
+    return NULL;
+  }
+
+  res->ctx = (Context *)Py_NewRef(self);
+  res->source = (Image *)Py_NewRef(source);
+  res->image = image;
+  res->size = size;
+  res->index = 0;
+  res->filled = 0;
+  return res;
+}
+
+static int frame_stack_copy(FrameStack *self, int layer) {
+  Image *source = self->source;
+
+  if (glCopyImageSubData && source->samples == 1) {
+    const int upload = on_upload_thread(self->ctx);
+    if (!upload) {
+      PyMutex_Lock(&self->ctx->state_lock);
+    }
+    glCopyImageSubData(source->image,
+                       source->renderbuffer ? GL_RENDERBUFFER : source->target,
+                       0, 0, 0, 0, self->image->image, self->image->target, 0,
+                       0, 0, layer, source->width, source->height, 1);
+    if (!upload) {
+      PyMutex_Unlock(&self->ctx->state_lock);
+    }
+    return 0;
+  }
+
+  // Multisampled sources are resolved by the blit
+  ImageFace *src = image_base_face(source);
+  if (!src) {
+    return -1;
+  }
+  PyObject *key = Py_BuildValue("(ii)", layer, 0);
+  ImageFace *dst = key ? build_image_face(self->image, key) : NULL;
+  Py_XDECREF(key);
+  PyObject *res = dst ? blit_image_face(src, (PyObject *)dst, Py_None,
+                                        Py_None, Py_None, 0)
+                      : NULL;
+  Py_XDECREF(dst);
+  Py_DECREF(src);
+  Py_XDECREF(res);
+  return res ? 0 : -1;
+}
+
+static PyObject *FrameStack_meth_push(FrameStack *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "push",
+                              args, NULL, 0);
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  // The first frame after a reset fills the whole stack, like repeating the
+  // first observation of an episode
+  if (!self->filled) {
+    for (int layer = 0; layer < self->size; ++layer) {
+      if (frame_stack_copy(self, layer) < 0) {
+        return NULL;
+      }
+    }
+    self->filled = 1;
+    self->index = 0;
+    Py_RETURN_NONE;
+  }
+
+  if (frame_stack_copy(self, self->index) < 0) {
+    return NULL;
+  }
+  self->index = (self->index + 1) % self->size;
+  Py_RETURN_NONE;
+}
+
+static PyObject *FrameStack_meth_reset(FrameStack *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "reset",
+                              args, NULL, 0);
+  }
+
+  self->filled = 0;
+  self->index = 0;
+  Py_RETURN_NONE;
+}
+
+// Oldest frame first, (size, height, width, channels) in a single buffer
+static PyObject *FrameStack_meth_read(FrameStack *self, PyObject *args,
+                                      PyObject *kwargs) {
+  static char *keywords[] = {"into", NULL};
+  PyObject *into = Py_None;
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "read",
+                              args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", keywords, &into)) {
+    return NULL;
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  const Image *image = self->image;
+  const Py_ssize_t frame_size =
+      (Py_ssize_t)image->width * image->height * image->fmt.pixel_size;
+
+  PyObject *res = NULL;
+  Py_buffer view;
+  if (into == Py_None) {
+    res = PyBytes_FromStringAndSize(NULL, frame_size * self->size);
+    if (!res) {
+      return NULL;
+    }
+    view.buf = PyBytes_AsString(res);
+  } else {
+    if (PyObject_GetBuffer(into, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS)) {
+      return NULL;
+    }
+    if (view.len < frame_size * self->size) {
+      PyBuffer_Release(&view);
+      PyErr_Format(PyExc_ValueError, "[HyperGL] invalid write size");
+      return NULL;
+    }
+  }
+
+  // The ring starts at index, two ranged reads land it in order. Without
+  // glGetTextureSubImage the whole array is read once and rotated in place.
+  const int head = self->size - self->index;
+  const int ranged =
+      glGetTextureSubImage && frame_size * self->size <= INT_MAX;
+  char *out = (char *)view.buf;
+  int ok = 1;
+  PyMutex_Lock(&self->ctx->state_lock);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  if (ranged) {
+    glGetTextureSubImage(image->image, 0, 0, 0, self->index, image->width,
+                         image->height, head, image->fmt.format,
+                         image->fmt.type, (int)(frame_size * head), out);
+    if (self->index) {
+      glGetTextureSubImage(image->image, 0, 0, 0, 0, image->width,
+                           image->height, self->index, image->fmt.format,
+                           image->fmt.type, (int)(frame_size * self->index),
+                           out + frame_size * head);
+    }
+  } else if (glGetTexImage) {
+    glActiveTexture(self->ctx->default_texture_unit);
+    glBindTexture(image->target, image->image);
+    glGetTexImage(image->target, 0, image->fmt.format, image->fmt.type, out);
+  } else {
+    ok = 0;
+  }
+  PyMutex_Unlock(&self->ctx->state_lock);
+
+  if (!ok) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] glGetTexImage is not available");
+  } else if (!ranged && self->index) {
+    char *temp = PyMem_Malloc(frame_size * self->index);
+    if (temp) {
+      memcpy(temp, out, frame_size * self->index);
+      memmove(out, out + frame_size * self->index, frame_size * head);
+      memcpy(out + frame_size * head, temp, frame_size * self->index);
+      PyMem_Free(temp);
+    } else {
+      PyErr_NoMemory();
+      ok = 0;
+    }
+  }
+
+  if (into != Py_None) {
+    PyBuffer_Release(&view);
+    if (ok) {
+      Py_RETURN_NONE;
+    }
+    return NULL;
+  }
+  if (!ok) {
+    Py_CLEAR(res);
+  }
+  return res;
+}
+
+// -----------------------------------------------------------------------------
+// Texture Containers: KTX2 / DDS
+// -----------------------------------------------------------------------------
+
+typedef struct TextureFormatCode {
+  unsigned code;
+  const char *name;
+} TextureFormatCode;
+
+// VkFormat
+static const TextureFormatCode ktx2_formats[] = {
+    {9, "r8unorm"},           {16, "rg8unorm"},
+    {37, "rgba8unorm"},       {38, "rgba8snorm"},
+    {41, "rgba8uint"},        {42, "rgba8sint"},
+    {43, "rgba8unorm-srgb"},  {64, "rgb10a2unorm"},
+    {76, "r16float"},         {83, "rg16float"},
+    {97, "rgba16float"},      {100, "r32float"},
+    {103, "rg32float"},       {109, "rgba32float"},
+    {122, "rg11b10ufloat"},   {123, "rgb9e5ufloat"},
+    {131, "bc1-rgba-unorm"},  {132, "bc1-rgba-unorm-srgb"},
+    {133, "bc1-rgba-unorm"},  {134, "bc1-rgba-unorm-srgb"},
+    {135, "bc2-rgba-unorm"},  {136, "bc2-rgba-unorm-srgb"},
+    {137, "bc3-rgba-unorm"},  {138, "bc3-rgba-unorm-srgb"},
+    {139, "bc4-r-unorm"},     {140, "bc4-r-snorm"},
+    {141, "bc5-rg-unorm"},    {142, "bc5-rg-snorm"},
+    {143, "bc6h-rgb-ufloat"}, {144, "bc6h-rgb-float"},
+    {145, "bc7-rgba-unorm"},  {146, "bc7-rgba-unorm-srgb"},
+    {147, "etc2-rgb8unorm"},  {148, "etc2-rgb8unorm-srgb"},
+    {149, "etc2-rgb8a1unorm"}, {150, "etc2-rgb8a1unorm-srgb"},
+    {151, "etc2-rgba8unorm"}, {152, "etc2-rgba8unorm-srgb"},
+    {153, "eac-r11unorm"},    {154, "eac-r11snorm"},
+    {155, "eac-rg11unorm"},   {156, "eac-rg11snorm"},
+    {0, NULL},
+};
+
+// DXGI_FORMAT
+static const TextureFormatCode dds_formats[] = {
+    {2, "rgba32float"},      {10, "rgba16float"},
+    {16, "rg32float"},       {24, "rgb10a2unorm"},
+    {26, "rg11b10ufloat"},   {28, "rgba8unorm"},
+    {29, "rgba8unorm-srgb"}, {30, "rgba8uint"},
+    {31, "rgba8snorm"},      {32, "rgba8sint"},
+    {34, "rg16float"},       {41, "r32float"},
+    {49, "rg8unorm"},        {54, "r16float"},
+    {61, "r8unorm"},         {67, "rgb9e5ufloat"},
+    {71, "bc1-rgba-unorm"},  {72, "bc1-rgba-unorm-srgb"},
+    {74, "bc2-rgba-unorm"},  {75, "bc2-rgba-unorm-srgb"},
+    {77, "bc3-rgba-unorm"},  {78, "bc3-rgba-unorm-srgb"},
+    {80, "bc4-r-unorm"},     {81, "bc4-r-snorm"},
+    {83, "bc5-rg-unorm"},    {84, "bc5-rg-snorm"},
+    {95, "bc6h-rgb-ufloat"}, {96, "bc6h-rgb-float"},
+    {98, "bc7-rgba-unorm"},  {99, "bc7-rgba-unorm-srgb"},
+    {0, NULL},
+};
+
+#define FOURCC(a, b, c, d)                                                     \
+  ((unsigned)(a) | ((unsigned)(b) << 8) | ((unsigned)(c) << 16) |              \
+   ((unsigned)(d) << 24))
+
+// Legacy DDS files name the block formats with a FourCC
+static const TextureFormatCode dds_fourcc_formats[] = {
+    {FOURCC('D', 'X', 'T', '1'), "bc1-rgba-unorm"},
+    {FOURCC('D', 'X', 'T', '3'), "bc2-rgba-unorm"},
+    {FOURCC('D', 'X', 'T', '5'), "bc3-rgba-unorm"},
+    {FOURCC('A', 'T', 'I', '1'), "bc4-r-unorm"},
+    {FOURCC('B', 'C', '4', 'U'), "bc4-r-unorm"},
+    {FOURCC('B', 'C', '4', 'S'), "bc4-r-snorm"},
+    {FOURCC('A', 'T', 'I', '2'), "bc5-rg-unorm"},
+    {FOURCC('B', 'C', '5', 'U'), "bc5-rg-unorm"},
+    {FOURCC('B', 'C', '5', 'S'), "bc5-rg-snorm"},
+    {0, NULL},
+};
+
+static const char *texture_format_name(const TextureFormatCode *table,
+                                       unsigned code) {
+  for (; table->name; ++table) {
+    if (table->code == code) {
+      return table->name;
+    }
+  }
+  return NULL;
+}
+
+static inline unsigned read_u32(const unsigned char *ptr) {
+  uint32_t value;
+  memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+static inline unsigned long long read_u64(const unsigned char *ptr) {
+  uint64_t value;
+  memcpy(&value, ptr, sizeof(value));
+  return value;
+}
+
+// Where each mip level lives in the file
+typedef struct TextureLayout {
+  const char *format;
+  int width;
+  int height;
+  int levels;
+  int array;
+  int cubemap;
+  int generate_mipmaps;
+  int layer_major; // DDS stores every mip of a layer before the next layer
+  Py_ssize_t offsets[32];
+} TextureLayout;
+
+static int parse_ktx2(const unsigned char *data, Py_ssize_t size,
+                      TextureLayout *res) {
+  static const unsigned char identifier[12] = {
+      0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+  if (size < 80 || memcmp(data, identifier, sizeof(identifier))) {
+    return 0;
+  }
+
+  const unsigned vk_format = read_u32(data + 12);
+  const unsigned depth = read_u32(data + 28);
+  const unsigned layers = read_u32(data + 32);
+  const unsigned faces = read_u32(data + 36);
+  const unsigned levels = read_u32(data + 40);
+  const unsigned supercompression = read_u32(data + 44);
+
+  res->format = texture_format_name(ktx2_formats, vk_format);
+  if (!res->format) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] unsupported KTX2 format (VkFormat %u)", vk_format);
+    return -1;
+  }
+  if (supercompression) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] supercompressed KTX2 files are not supported");
+    return -1;
+  }
+  if (depth > 1 || (faces != 1 && faces != 6) || (faces == 6 && layers)) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] 3D and cubemap array KTX2 files are not "
+                 "supported");
+    return -1;
+  }
+
+  res->width = (int)read_u32(data + 20);
+  res->height = (int)read_u32(data + 24);
+  res->levels = levels ? (int)levels : 1;
+  res->generate_mipmaps = levels == 0;
+  res->array = (int)layers;
+  res->cubemap = faces == 6;
+  res->layer_major = 0;
+
+  if (res->levels > 32 || size < 80 + 24 * (Py_ssize_t)res->levels) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid KTX2 level index");
+    return -1;
+  }
+  for (int level = 0; level < res->levels; ++level) {
+    const unsigned long long offset = read_u64(data + 80 + 24 * level);
+    if (offset > (unsigned long long)size) {
+      PyErr_Format(PyExc_ValueError, "[HyperGL] invalid KTX2 level index");
+      return -1;
+    }
+    res->offsets[level] = (Py_ssize_t)offset;
+  }
+  return 1;
+}
+
+static int parse_dds(const unsigned char *data, Py_ssize_t size,
+                     TextureLayout *res) {
+  if (size < 128 || memcmp(data, "DDS ", 4) || read_u32(data + 4) != 124) {
+    return 0;
+  }
+
+  enum {
+    DDPF_FOURCC = 0x4,
+    DDPF_RGB = 0x40,
+    DDSCAPS2_CUBEMAP = 0x200,
+    DDS_RESOURCE_MISC_TEXTURECUBE = 0x4,
+    DDS_DIMENSION_TEXTURE3D = 4,
+  };
+
+  const unsigned mip_count = read_u32(data + 28);
+  const unsigned pixel_flags = read_u32(data + 80);
+  const unsigned fourcc = read_u32(data + 84);
+  const unsigned caps2 = read_u32(data + 112);
+  Py_ssize_t offset = 128;
+
+  res->width = (int)read_u32(data + 16);
+  res->height = (int)read_u32(data + 12);
+  res->levels = mip_count ? (int)mip_count : 1;
+  res->generate_mipmaps = 0;
+  res->array = 0;
+  res->cubemap = (caps2 & DDSCAPS2_CUBEMAP) != 0;
+  res->layer_major = 1;
+  res->format = NULL;
+
+  if ((pixel_flags & DDPF_FOURCC) && fourcc == FOURCC('D', 'X', '1', '0')) {
+    if (size < 148) {
+      PyErr_Format(PyExc_ValueError, "[HyperGL] truncated DDS header");
+      return -1;
+    }
+    const unsigned dxgi_format = read_u32(data + 128);
+    const unsigned dimension = read_u32(data + 132);
+    const unsigned array_size = read_u32(data + 140);
+    res->format = texture_format_name(dds_formats, dxgi_format);
+    if (!res->format) {
+      PyErr_Format(PyExc_ValueError,
+                   "[HyperGL] unsupported DDS format (DXGI_FORMAT %u)",
+                   dxgi_format);
+      return -1;
+    }
+    if (dimension == DDS_DIMENSION_TEXTURE3D) {
+      PyErr_Format(PyExc_ValueError,
+                   "[HyperGL] 3D DDS files are not supported");
+      return -1;
+    }
+    res->cubemap = (read_u32(data + 136) & DDS_RESOURCE_MISC_TEXTURECUBE) != 0;
+    if (array_size > 1) {
+      res->array = (int)array_size;
+    }
+    offset = 148;
+  } else if (pixel_flags & DDPF_FOURCC) {
+    res->format = texture_format_name(dds_fourcc_formats, fourcc);
+  } else if ((pixel_flags & DDPF_RGB) && read_u32(data + 88) == 32 &&
+             read_u32(data + 92) == 0x000000FF &&
+             read_u32(data + 96) == 0x0000FF00 &&
+             read_u32(data + 100) == 0x00FF0000) {
+    res->format = "rgba8unorm";
+  }
+
+  if (!res->format) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] unsupported DDS pixel format");
+    return -1;
+  }
+  if (res->cubemap && res->array) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] cubemap array DDS files are not supported");
+    return -1;
+  }
+  if (res->levels > 32) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid DDS mip count");
+    return -1;
+  }
+
+  res->offsets[0] = offset;
+  return 1;
+}
+
+#undef FOURCC
+
+// Every level (and layer) goes straight from the mapping to the texture under
+// a single lock, no per level Python call or contiguous copy
+static int upload_texture_levels(Image *image, const TextureLayout *layout,
+                                 const unsigned char *data, Py_ssize_t size) {
+  const ImageFormat *fmt = &image->fmt;
+  const int compressed = fmt->block > 1;
+  const int layers = image->layer_count;
+
+  // Validate every range before touching GL
+  Py_ssize_t offset = layout->offsets[0];
+  for (int layer = 0; layer < (layout->layer_major ? layers : 1); ++layer) {
+    for (int level = 0; level < layout->levels; ++level) {
+      const Py_ssize_t face_size =
+          image_data_size(fmt, least_one(layout->width >> level),
+                          least_one(layout->height >> level));
+      const Py_ssize_t count = layout->layer_major ? 1 : layers;
+      const Py_ssize_t start =
+          layout->layer_major ? offset : layout->offsets[level];
+      if (start > size || face_size * count > size - start) {
+        PyErr_Format(PyExc_ValueError,
+                     "[HyperGL] the texture file is truncated");
+        return -1;
+      }
+      offset = start + face_size * count;
+    }
+  }
+
+  const int upload = on_upload_thread(image->ctx);
+  if (!upload) {
+    PyMutex_Lock(&image->ctx->state_lock);
+  }
+
+  glActiveTexture(image->ctx->default_texture_unit);
+  glBindTexture(image->target, image->image);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+  offset = layout->offsets[0];
+  for (int layer = 0; layer < (layout->layer_major ? layers : 1); ++layer) {
+    for (int level = 0; level < layout->levels; ++level) {
+      const int w = least_one(layout->width >> level);
+      const int h = least_one(layout->height >> level);
+      const Py_ssize_t face_size = image_data_size(fmt, w, h);
+      const int first = layout->layer_major ? layer : 0;
+      const int count = layout->layer_major ? 1 : layers;
+      const unsigned char *pixels =
+          data + (layout->layer_major ? offset : layout->offsets[level]);
+
+      if (image->cubemap) {
+        for (int i = 0; i < count; ++i) {
+          const int target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + first + i;
+          const void *face = pixels + face_size * i;
+          if (compressed) {
+            glCompressedTexSubImage2D(target, level, 0, 0, w, h,
+                                      fmt->internal_format, (int)face_size,
+                                      face);
+          } else {
+            glTexSubImage2D(target, level, 0, 0, w, h, fmt->format, fmt->type,
+                            face);
+          }
+        }
+      } else if (image->array) {
+        if (compressed) {
+          glCompressedTexSubImage3D(image->target, level, 0, 0, first, w, h,
+                                    count, fmt->internal_format,
+                                    (int)(face_size * count), pixels);
+        } else {
+          glTexSubImage3D(image->target, level, 0, 0, first, w, h, count,
+                          fmt->format, fmt->type, pixels);
+        }
+      } else if (compressed) {
+        glCompressedTexSubImage2D(image->target, level, 0, 0, w, h,
+                                  fmt->internal_format, (int)face_size,
+                                  pixels);
+      } else {
+        glTexSubImage2D(image->target, level, 0, 0, w, h, fmt->format,
+                        fmt->type, pixels);
+      }
+      offset += face_size * count;
+    }
+  }
+
+  if (layout->generate_mipmaps && !compressed) {
+    glGenerateMipmap(image->target);
+  }
+
+  if (!upload) {
+    PyMutex_Unlock(&image->ctx->state_lock);
+  }
+  return 0;
+}
+
+static Image *Context_meth_load_texture(Context *self, PyObject *args,
+                                        PyObject *kwargs) {
+  static char *keywords[] = {"source", NULL};
+  PyObject *source;
+
+  if (off_render_thread(self)) {
+    return (Image *)render_thread_call(self, (PyObject *)self, "load_texture",
+                                       args, kwargs, 1);
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", keywords, &source)) {
+    return NULL;
+  }
+
+  PyObject *mapped = PyObject_CallMethod(self->module_state->helper,
+                                         "stream_source", "(O)", source);
+  if (!mapped) {
+    return NULL;
+  }
+  Py_buffer view;
+  if (PyObject_GetBuffer(mapped, &view, PyBUF_SIMPLE) < 0) {
+    Py_DECREF(mapped);
+    return NULL;
+  }
+
+  Image *res = NULL;
+  TextureLayout layout;
+  int found = parse_ktx2(view.buf, view.len, &layout);
+  if (!found) {
+    found = parse_dds(view.buf, view.len, &layout);
+  }
+  if (!found) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] not a KTX2 or DDS texture file");
+  }
+  if (found <= 0) {
+    goto done;
+  }
+
+  // The header is untrusted input, check it even when validation is off
+  const int max_size = layout.cubemap ? self->limits.max_cube_map_texture_size
+                                      : self->limits.max_texture_size;
+  if (layout.width > max_size || layout.height > max_size) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the texture size exceeds the %d pixel limit",
+                 max_size);
+    goto done;
+  }
+  if (layout.array > self->limits.max_array_texture_layers) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] the texture array exceeds the %d layer limit",
+                 self->limits.max_array_texture_layers);
+    goto done;
+  }
+
+  // Compressed formats cannot generate mipmaps, such files get a single level
+  if (layout.generate_mipmaps) {
+    ImageFormat fmt;
+    PyObject *name = PyUnicode_FromString(layout.format);
+    const int known = name && get_image_format(self->module_state,
+                                               self->module_state->helper,
+                                               name, &fmt);
+    Py_XDECREF(name);
+    if (!known) {
+      if (!PyErr_Occurred()) {
+        PyErr_Format(PyExc_ValueError, "[HyperGL] invalid image format");
+      }
+      goto done;
+    }
+    layout.generate_mipmaps = fmt.block == 1;
+  }
+
+  PyObject *image_kwargs = Py_BuildValue(
+      "{s(ii)sssisisOsO}", "size", layout.width, layout.height, "format",
+      layout.format, "levels", layout.generate_mipmaps ? 0 : layout.levels,
+      "array", layout.array, "cubemap", layout.cubemap ? Py_True : Py_False,
+      "texture", Py_True);
+  if (!image_kwargs) {
+    goto done;
+  }
+  res = Context_meth_image(self, self->module_state->empty_tuple, image_kwargs);
+  Py_DECREF(image_kwargs);
+  if (res && upload_texture_levels(res, &layout, view.buf, view.len) < 0) {
+    Py_CLEAR(res);
+  }
+
+done:
+  PyBuffer_Release(&view);
+  Py_DECREF(mapped);
+  return res;
+}
+
+static PyObject *Image_meth_mipmaps(const Image *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "mipmaps",
+                              args, NULL, 0);
+  }
+
+  if (self->renderbuffer) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] cannot generate mipmaps for renderbuffers");
+    return NULL;
+  }
+  if (self->fmt.block > 1) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] cannot generate mipmaps for compressed images, "
+                 "write each level instead");
+    return NULL;
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+
+  glActiveTexture(self->ctx->default_texture_unit);
+  glBindTexture(self->target, self->image);
+  glGenerateMipmap(self->target);
+
+  PyMutex_Unlock(&self->ctx->state_lock);
+
+  Py_RETURN_NONE;
+}
+
+// Compressed images have no framebuffer to read from, the blocks of the whole
+// base level come back as they are stored
+static PyObject *read_compressed_image(Image *self, PyObject *size_arg,
+                                       PyObject *offset_arg, PyObject *into) {
+  IntPair size;
+  IntPair offset;
+  if (!to_int_pair(&size, size_arg, self->width, self->height) ||
+      !to_int_pair(&offset, offset_arg, 0, 0)) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] size and offset must be tuples of 2 ints");
+    return NULL;
+  }
+  if (size.x != self->width || size.y != self->height || offset.x ||
+      offset.y) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] compressed images can only be read whole");
+    return NULL;
+  }
+  if (!glGetCompressedTexImage) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] glGetCompressedTexImage is not available");
+    return NULL;
+  }
+
+  const Py_ssize_t face_size =
+      image_data_size(&self->fmt, self->width, self->height);
+  const Py_ssize_t total = face_size * self->layer_count;
+
+  PyObject *res = NULL;
+  Py_buffer view = {0};
+  if (into == Py_None) {
+    res = PyBytes_FromStringAndSize(NULL, total);
+    if (!res) {
+      return NULL;
+    }
+    view.buf = PyBytes_AS_STRING(res);
+  } else {
+    if (PyObject_GetBuffer(into, &view, PyBUF_WRITABLE)) {
+      return NULL;
+    }
+    if (view.len < total) {
+      PyBuffer_Release(&view);
+      PyErr_Format(PyExc_ValueError, "[HyperGL] invalid write size");
+      return NULL;
+    }
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+  glActiveTexture(self->ctx->default_texture_unit);
+  glBindTexture(self->target, self->image);
+  if (self->cubemap) {
+    for (int i = 0; i < 6; ++i) {
+      glGetCompressedTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0,
+                              (char *)view.buf + face_size * i);
+    }
+  } else {
+    glGetCompressedTexImage(self->target, 0, view.buf);
+  }
+  PyMutex_Unlock(&self->ctx->state_lock);
+
+  if (res) {
+    return res;
+  }
+  PyBuffer_Release(&view);
+  Py_RETURN_NONE;
+}
+
+// Crop, resize, channel select, flip and normalization run as one draw into a
+// small target owned by the image, only that target is read back.
+static PyObject *read_transformed_image(Image *self, PyObject *size_arg,
+                                        PyObject *offset_arg, PyObject *into,
+                                        PyObject *transform) {
+  if (size_arg != Py_None || offset_arg != Py_None) {
+    PyErr_Format(PyExc_TypeError, "[HyperGL] a transformed read takes its "
+                                  "region from the transform crop");
+    return NULL;
+  }
+
+  if (!PyDict_Check(transform)) {
+    PyErr_Format(PyExc_TypeError, "[HyperGL] the transform must be a dict");
+    return NULL;
+  }
+
+  if (self->array || self->cubemap || self->fmt.block > 1 ||
+      !self->fmt.color) {
+    PyErr_Format(PyExc_TypeError, "[HyperGL] only 2D color images can be read "
+                                  "with a transform");
+    return NULL;
+  }
+
+  PyObject *transforms = Atomic_LoadPtr(&self->transforms);
+  if (!transforms) {
+    PyObject *fresh = PyDict_New();
+    if (!fresh) {
+      return NULL;
+    }
+    transforms = Atomic_CompareExchangePtr(&self->transforms, NULL, fresh);
+    if (transforms) { // Race Lost
+      Py_DECREF(fresh);
+    } else {
+      transforms = fresh;
+    }
+  }
+
+  PyObject *helper_res = PyObject_CallMethod(
+      self->ctx->module_state->helper, "read_transform", "(OOOO)", self->ctx,
+      self, transforms, transform);
+  if (!helper_res) {
+    return NULL;
+  }
+
+  PyObject *target;
+  int channels;
+  if (!PyArg_ParseTuple(helper_res, "O!i", self->ctx->module_state->Image_type,
+                        &target, &channels)) {
+    Py_DECREF(helper_res);
+    return NULL;
+  }
+  ImageFace *face = image_base_face((Image *)target);
+  Py_DECREF(helper_res);
+  if (!face) {
+    return NULL;
+  }
+
+  // Three channels are rendered as rgba and read back without the alpha
+  const ImageFormat *fmt = &face->image->fmt;
+  const int format = channels == 3 ? GL_RGB : fmt->format;
+  const int pixel_size =
+      channels == 3 ? fmt->pixel_size / 4 * 3 : fmt->pixel_size;
+
+  IntPair size = {face->width, face->height};
+  IntPair offset = {0, 0};
+  PyObject *res =
+      read_image_face_as(face, size, offset, into, format, pixel_size);
+  Py_DECREF(face);
+  return res;
+}
+
+static PyObject *Image_meth_read(Image *self, PyObject *args,
+                                 PyObject *kwargs) {
+  static char *keywords[] = {"size", "offset", "into", "transform", NULL};
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "read",
+                              args, kwargs, 1);
+  }
+
+  PyObject *size_arg = Py_None;
+  PyObject *offset_arg = Py_None;
+  PyObject *into = Py_None;
+  PyObject *transform = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOO", keywords, &size_arg,
+                                   &offset_arg, &into, &transform)) {
+    return NULL;
+  }
+
+  if (transform != Py_None) {
+    return read_transformed_image(self, size_arg, offset_arg, into, transform);
+  }
+
+  if (self->fmt.block > 1) {
+    return read_compressed_image(self, size_arg, offset_arg, into);
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  ImageFace *first_layer = image_base_face(self);
+  if (!first_layer) {
+    return NULL;
+  }
+
+  IntPair size;
+  IntPair offset;
+  if (!parse_size_and_offset(first_layer, size_arg, offset_arg, &size,
+                             &offset)) {
+    Py_DECREF(first_layer);
+    return NULL;
+  }
+
+  if (self->array || self->cubemap) {
+    Py_DECREF(first_layer);
+    if (into != Py_None) {
+      PyErr_Format(PyExc_TypeError,
+                   "[HyperGL] cannot read into user buffer for layered images");
+      return NULL;
+    }
+
+    PyObject *layers = image_layers(self);
+    if (!layers) {
+      return NULL;
+    }
+
+    int write_size = size.x * size.y * self->fmt.pixel_size;
+    PyObject *res = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)write_size *
+                                                        self->layer_count);
+    for (int i = 0; i < self->layer_count; ++i) {
+      ImageFace *src = (ImageFace *)PyTuple_GetItem(layers, i);
+      PyObject *chunk = PyMemoryView_FromMemory(PyBytes_AsString(res) +
+                                                    ((size_t)write_size * i),
+                                                write_size, PyBUF_WRITE);
+      PyObject *temp = read_image_face(src, size, offset, chunk);
+      if (!temp) {
+        Py_DECREF(chunk);
+        Py_DECREF(res);
+        return NULL;
+      }
+      Py_DECREF(chunk);
+      Py_DECREF(temp);
+    }
+    return res;
+  }
+
+  PyObject *res = read_image_face(first_layer, size, offset, into);
+  Py_DECREF(first_layer);
+  return res;
+}
+
+static PyObject *Image_meth_blit(Image *self, PyObject *args,
+                                 PyObject *kwargs) {
+  static char *keywords[] = {"target", "offset", "size",
+                             "crop",   "filter", NULL};
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "blit",
+                              args, kwargs, 0);
+  }
+
+  PyObject *target = Py_None;
+  PyObject *offset = Py_None;
+  PyObject *size = Py_None;
+  PyObject *crop = Py_None;
+  int filter = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOOp", keywords, &target,
+                                   &offset, &size, &crop, &filter)) {
+    return NULL;
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  ImageFace *src = image_base_face(self);
+  if (!src) {
+    return NULL;
+  }
+
+  PyObject *res = blit_image_face(src, target, offset, size, crop, filter);
+  Py_DECREF(src);
+  return res;
+}
+
+// A layer or level selection: None for all, a count, or (first, count)
+static int to_image_range(IntPair *value, PyObject *obj, const int all) {
+  if (PyLong_Check(obj)) {
+    value->x = 0;
+    value->y = to_int(obj);
+    return !PyErr_Occurred();
+  }
+  return to_int_pair(value, obj, 0, all);
+}
+
+static PyObject *Image_meth_copy_to(Image *self, PyObject *args,
+                                    PyObject *kwargs) {
+  static char *keywords[] = {"target", "src_rect",  "dst_offset", "layers",
+                             "levels", "dst_layer", NULL};
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "copy_to",
+                              args, kwargs, 0);
+  }
+
+  PyObject *target_arg;
+  PyObject *rect_arg = Py_None;
+  PyObject *offset_arg = Py_None;
+  PyObject *layers_arg = Py_None;
+  PyObject *levels_arg = Py_None;
+  PyObject *dst_layer_arg = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwargs, "O!|OOOOO", keywords,
+          self->ctx->module_state->Image_type, &target_arg, &rect_arg,
+          &offset_arg, &layers_arg, &levels_arg, &dst_layer_arg)) {
+    return NULL;
+  }
+
+  Image *target = (Image *)target_arg;
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  Viewport rect;
+  if (!to_viewport(&rect, rect_arg, 0, 0, self->width, self->height)) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] the src_rect must be a tuple of 4 ints");
+    return NULL;
+  }
+
+  IntPair offset;
+  if (!to_int_pair(&offset, offset_arg, 0, 0)) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] the dst_offset must be a tuple of 2 ints");
+    return NULL;
+  }
+
+  IntPair layers;
+  IntPair levels;
+  if (!to_image_range(&layers, layers_arg, self->layer_count) ||
+      !to_image_range(&levels, levels_arg, 1)) {
+    PyErr_Format(PyExc_TypeError, "[HyperGL] layers and levels must be an int "
+                                  "or a (first, count) tuple");
+    return NULL;
+  }
+
+  if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0 ||
+      rect.x + rect.width > self->width ||
+      rect.y + rect.height > self->height) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid src_rect");
+    return NULL;
+  }
+
+  if (offset.x < 0 || offset.y < 0 ||
+      offset.x + rect.width > target->width ||
+      offset.y + rect.height > target->height) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid dst_offset");
+    return NULL;
+  }
+
+  // Layered targets default to the source layers, a 2D target has only one
+  int dst_layer = target->layer_count > 1 ? layers.x : 0;
+  if (dst_layer_arg != Py_None) {
+    dst_layer = to_int(dst_layer_arg);
+    if (PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+
+  if (layers.x < 0 || layers.y <= 0 ||
+      layers.x + layers.y > self->layer_count || dst_layer < 0 ||
+      dst_layer + layers.y > target->layer_count) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid layers");
+    return NULL;
+  }
+
+  if (levels.x < 0 || levels.y <= 0 ||
+      levels.x + levels.y > self->level_count ||
+      levels.x + levels.y > target->level_count) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid levels");
+    return NULL;
+  }
+
+  // Compressed copies move whole blocks, except at the edges of the image
+  const int block = least_one(self->fmt.block > target->fmt.block
+                                  ? self->fmt.block
+                                  : target->fmt.block);
+  if (block > 1 &&
+      (rect.x % block || rect.y % block || offset.x % block ||
+       offset.y % block ||
+       (rect.width % block && rect.x + rect.width != self->width) ||
+       (rect.height % block && rect.y + rect.height != self->height))) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] src_rect and dst_offset must be aligned to %dx%d "
+                 "blocks",
+                 block, block);
+    return NULL;
+  }
+
+  const int direct = glCopyImageSubData &&
+                     self->fmt.internal_format == target->fmt.internal_format &&
+                     self->samples == target->samples;
+
+  if (!direct) {
+    // Different formats need the conversion a blit does, one face at a time
+    for (int level = levels.x; level < levels.x + levels.y; ++level) {
+      const int w = least_one(rect.width >> level);
+      const int h = least_one(rect.height >> level);
+      PyObject *crop = Py_BuildValue("(iiii)", rect.x >> level,
+                                     rect.y >> level, w, h);
+      PyObject *dst = Py_BuildValue("(ii)", offset.x >> level,
+                                    offset.y >> level);
+      PyObject *size = Py_BuildValue("(ii)", w, h);
+      PyObject *res = crop && dst && size ? Py_None : NULL;
+      for (int layer = layers.x; res && layer < layers.x + layers.y; ++layer) {
+        PyObject *key = Py_BuildValue("(ii)", layer, level);
+        PyObject *dst_key =
+            Py_BuildValue("(ii)", dst_layer + layer - layers.x, level);
+        ImageFace *src_face = key && dst_key ? build_image_face(self, key)
+                                             : NULL;
+        ImageFace *dst_face =
+            src_face ? build_image_face(target, dst_key) : NULL;
+        res = dst_face ? blit_image_face(src_face, (PyObject *)dst_face, dst,
+                                         size, crop, 0)
+                       : NULL;
+        Py_XDECREF(res);
+        Py_XDECREF(dst_face);
+        Py_XDECREF(src_face);
+        Py_XDECREF(dst_key);
+        Py_XDECREF(key);
+      }
+      Py_XDECREF(crop);
+      Py_XDECREF(dst);
+      Py_XDECREF(size);
+      if (!res) {
+        return NULL;
+      }
+    }
+    Py_RETURN_NONE;
+  }
+
+  const int src_target = self->renderbuffer ? GL_RENDERBUFFER : self->target;
+  const int dst_target =
+      target->renderbuffer ? GL_RENDERBUFFER : target->target;
+
+  // No framebuffers involved, so the upload thread can copy too
+  const int upload = on_upload_thread(self->ctx);
+  if (!upload) {
+    PyMutex_Lock(&self->ctx->state_lock);
+  }
+
+  // Layers and cubemap faces are the z axis, all of them go in one call
+  for (int level = levels.x; level < levels.x + levels.y; ++level) {
+    const int w = least_one(rect.width >> level);
+    const int h = least_one(rect.height >> level);
+    glCopyImageSubData(self->image, src_target, level, rect.x >> level,
+                       rect.y >> level, layers.x, target->image, dst_target,
+                       level, offset.x >> level, offset.y >> level, dst_layer,
+                       w, h, layers.y);
+  }
+
+  if (!upload) {
+    PyMutex_Unlock(&self->ctx->state_lock);
+  }
+  Py_RETURN_NONE;
+}
+
+static ImageFace *Image_meth_face(Image *self, PyObject *args,
+                                  PyObject *kwargs) {
+  static char *keywords[] = {"layer", "level", NULL};
+
+  if (off_render_thread(self->ctx)) {
+    return (ImageFace *)render_thread_call(self->ctx, (PyObject *)self, "face",
+                                           args, kwargs, 1);
+  }
+
+  int layer = 0;
+  int level = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ii", keywords, &layer,
+                                   &level)) {
+    return NULL;
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  if (layer < 0 || layer >= self->layer_count) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid layer");
+    return NULL;
+  }
+
+  if (level > self->level_count) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid level");
+    return NULL;
+  }
+
+  PyObject *key = Py_BuildValue("(ii)", layer, level);
+  ImageFace *res = build_image_face(self, key);
+  Py_DECREF(key);
+  return res;
+}
+
+static PyObject *Image_get_clear_value(const Image *self, void *closure) {
+  if (self->fmt.clear_type == 'x') {
+    return Py_BuildValue("dI", (double)self->clear_value.clear_floats[0],
+                         self->clear_value.clear_uints[1]);
+  }
+  if (self->fmt.components == 1) {
+    if (self->fmt.clear_type == 'f') {
+      return PyFloat_FromDouble(self->clear_value.clear_floats[0]);
+    }
+    if (self->fmt.clear_type == 'i') {
+      return PyLong_FromLong(self->clear_value.clear_ints[0]);
+    }
+    if (self->fmt.clear_type == 'u') {
+      return PyLong_FromUnsignedLong(self->clear_value.clear_uints[0]);
+    }
+  }
+  PyObject *res = PyTuple_New(self->fmt.components);
+  for (int i = 0; i < self->fmt.components; ++i) {
+    if (self->fmt.clear_type == 'f') {
+      PyTuple_SetItem(res, i,
+                      PyFloat_FromDouble(self->clear_value.clear_floats[i]));
+    } else if (self->fmt.clear_type == 'i') {
+      PyTuple_SetItem(res, i, PyLong_FromLong(self->clear_value.clear_ints[i]));
+    } else if (self->fmt.clear_type == 'u') {
+      PyTuple_SetItem(
+          res, i, PyLong_FromUnsignedLong(self->clear_value.clear_uints[i]));
+    }
+  }
+  return res;
+}
+
+static int Image_set_clear_value(Image *self, PyObject *value, void *closure) {
+  if (self->fmt.components == 1) {
+    if (self->fmt.clear_type == 'f' && !PyFloat_CheckExact(value)) {
+      PyErr_Format(PyExc_TypeError,
+                   "[HyperGL] the clear value must be a float");
+      return -1;
+    }
+    if (self->fmt.clear_type == 'i' && !PyLong_CheckExact(value)) {
+      PyErr_Format(PyExc_TypeError, "[HyperGL] the clear value must be an int");
+      return -1;
+    }
+    if (self->fmt.clear_type == 'f') {
+      self->clear_value.clear_floats[0] = to_float(value);
+    } else if (self->fmt.clear_type == 'i') {
+      self->clear_value.clear_ints[0] = to_int(value);
+    } else if (self->fmt.clear_type == 'u') {
+      self->clear_value.clear_uints[0] = to_uint(value);
+    }
+    return 0;
+  }
+  PyObject *values = PySequence_Tuple(value);
+  if (!values) {
+    PyErr_Clear();
+    PyErr_Format(PyExc_TypeError, "[HyperGL] the clear value must be a tuple");
+    return -1;
+  }
+
+  int size = (int)PyTuple_Size(values);
+
+  if (size != self->fmt.components) {
+    Py_DECREF(values);
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid clear value size");
+    return -1;
+  }
+
+  if (self->fmt.clear_type == 'f') {
+    for (int i = 0; i < self->fmt.components; ++i) {
+      self->clear_value.clear_floats[i] = to_float(PyTuple_GetItem(values, i));
+    }
+  } else if (self->fmt.clear_type == 'i') {
+    for (int i = 0; i < self->fmt.components; ++i) {
+      self->clear_value.clear_ints[i] = to_int(PyTuple_GetItem(values, i));
+    }
+  } else if (self->fmt.clear_type == 'u') {
+    for (int i = 0; i < self->fmt.components; ++i) {
+      self->clear_value.clear_uints[i] = to_uint(PyTuple_GetItem(values, i));
+    }
+  } else if (self->fmt.clear_type == 'x') {
+    self->clear_value.clear_floats[0] = to_float(PyTuple_GetItem(values, 0));
+    self->clear_value.clear_ints[1] = to_int(PyTuple_GetItem(values, 1));
+  }
+  if (PyErr_Occurred()) {
+    Py_DECREF(values);
+    return -1;
+  }
+  Py_DECREF(values);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Type: Pipeline
+// -----------------------------------------------------------------------------
+
+static Pipeline *Context_meth_pipeline(Context *self, PyObject *args,
+                                       PyObject *kwargs) {
+  if (off_render_thread(self)) {
+    return (Pipeline *)render_thread_call(self, (PyObject *)self, "pipeline",
+                                          args, kwargs, 1);
+  }
+
+  // 1. Variable Declarations
+  PyObject *create_kwargs = NULL;
+  GLObject *program = NULL;
+  PyObject *uniform_layout = NULL;
+  PyObject *validate = NULL;
+  PyObject *layout_bindings = NULL;
+  PyObject *template_obj = NULL;
+  PyObject *framebuffer_attachments = NULL;
+  PyObject *vertex_array_bindings = NULL;
+  PyObject *resource_bindings = NULL;
+  PyObject *stream_resources = NULL;
+  PyObject *settings = NULL;
+  PyObject *uniforms = NULL;
+  PyObject *uniform_data = NULL;
+  GLObject *framebuffer = NULL;
+  GLObject *vertex_array = NULL;
+  DescriptorSet *descriptor_set = NULL;
+  GlobalSettings *global_settings = NULL;
+  Pipeline *res = NULL;
+
+  // 2. Argument Parsing
+  static char *keywords[] = {
+      "vertex_shader", "fragment_shader", "layout",       "resources",
+      "uniforms",      "depth",           "stencil",      "blend",
+      "framebuffer",   "vertex_buffers",  "index_buffer", "short_index",
+      "cull_face",     "topology",        "vertex_count", "instance_count",
+      "first_vertex",  "viewport",        "uniform_data", "viewport_data",
+      "render_data",   "includes",        "vertex_streams", NULL,
+  };
+
+  PyObject *vertex_shader = NULL;
+  PyObject *fragment_shader = NULL;
+  PyObject *layout = self->module_state->empty_tuple;
+  PyObject *resources = self->module_state->empty_tuple;
+  PyObject *arg_uniforms = Py_None;
+  PyObject *depth = Py_None;
+  PyObject *stencil = Py_None;
+  PyObject *blend = Py_None;
+  PyObject *framebuffer_arg = NULL;
+  PyObject *vertex_buffers = self->module_state->empty_tuple;
+  PyObject *index_buffer = Py_None;
+  int short_index = 0;
+  PyObject *cull_face = self->module_state->str_none;
+  PyObject *topology_arg = self->module_state->str_triangles;
+  int vertex_count = 0;
+  int instance_count = 1;
+  int first_vertex = 0;
+  PyObject *viewport = Py_None;
+  PyObject *arg_uniform_data = Py_None;
+  PyObject *viewport_data = Py_None;
+  PyObject *render_data = Py_None;
+  PyObject *includes = Py_None;
+  PyObject *vertex_streams = Py_None;
+
+  if (PyTuple_GET_SIZE(args) != 0 || !kwargs) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] pipeline only takes keyword-only arguments");
+    return NULL;
+  }
+
+  Pipeline *template = NULL;
+  template_obj = PyDict_GetItemString(kwargs, "template");
+  if (template_obj) {
+    Py_INCREF(template_obj);
+    template = (Pipeline *)template_obj;
+  }
+
+  if (template &&
+      Py_TYPE((PyObject *)template) != self->module_state->Pipeline_type) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid template");
+    return NULL;
+  }
+
+  if (template) {
+    if (PyDict_GetItemString(kwargs, "vertex_shader") ||
+        PyDict_GetItemString(kwargs, "fragment_shader") ||
+        PyDict_GetItemString(kwargs, "layout") ||
+        PyDict_GetItemString(kwargs, "includes")) {
+      PyErr_Format(PyExc_ValueError, "[HyperGL] cannot use template with "
+                                     "shader/layout/includes specified");
+      return NULL;
+    }
+    create_kwargs = PyDict_Copy(template->create_kwargs);
+    if (!create_kwargs) {
+      goto fail;
+    }
+    PyDict_Update(create_kwargs, kwargs);
+    PyDict_DelItemString(create_kwargs, "template");
+  } else {
+    create_kwargs = PyDict_Copy(kwargs);
+    if (!create_kwargs) {
+      goto fail;
+    }
+  }
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args, create_kwargs, "|$O!O!OOOOOOOOOpOOiiiOOOOOO", keywords,
+          &PyUnicode_Type, &vertex_shader, &PyUnicode_Type, &fragment_shader,
+          &layout, &resources, &arg_uniforms, &depth, &stencil, &blend,
+          &framebuffer_arg, &vertex_buffers, &index_buffer, &short_index,
+          &cull_face, &topology_arg, &vertex_count, &instance_count,
+          &first_vertex, &viewport, &arg_uniform_data, &viewport_data,
+          &render_data, &includes, &vertex_streams)) {
+    goto fail;
+  }
+
+  // Vertex pulling binds the streams as storage buffers, the vertex array is
+  // then only keyed by the index buffer and shared across pipelines
+  if (vertex_streams != Py_None) {
+    if (PyObject_Size(vertex_buffers) != 0) {
+      if (!PyErr_Occurred()) {
+        PyErr_SetString(PyExc_ValueError,
+                        "[HyperGL] vertex_streams and vertex_buffers are "
+                        "mutually exclusive");
+      }
+      goto fail;
+    }
+    stream_resources =
+        PyObject_CallMethod(self->module_state->helper, "vertex_streams",
+                            "(OO)", vertex_streams, resources);
+    if (!stream_resources) {
+      goto fail;
+    }
+    resources = stream_resources;
+  }
+
+  if (self->is_lost) {
+    PyErr_SetString(PyExc_RuntimeError, "[HyperGL] context lost");
+    goto fail;
+  }
+  if (!vertex_shader || !fragment_shader || !framebuffer_arg) {
+    PyErr_SetString(PyExc_TypeError, "[HyperGL] missing required args");
+    goto fail;
+  }
+
+  Viewport viewport_value;
+  if (!to_viewport(&viewport_value, viewport, 0, 0, 0, 0)) {
+    goto fail;
+  }
+
+  int topology;
+  if (!get_topology(topology_arg, &topology)) {
+    PyErr_Format(PyExc_ValueError, "[HyperGL] invalid topology: %R", topology_arg);
+    goto fail;
+  }
+
+  // 4. Logic & Creation
+  if (template) {
+    program = (GLObject *)new_ref(template->program);
+    Atomic_Increment(&program->uses);
+  } else {
+    program =
+        compile_program(self, includes != Py_None ? includes : self->includes,
+                        vertex_shader, fragment_shader, layout);
+  }
+  if (!program) {
+    goto fail;
+  }
+
+  if (arg_uniforms != Py_None) {
+    PyObject *tuple =
+        PyObject_CallMethod(self->module_state->helper, "uniforms", "(OOO)",
+                            program->extra, arg_uniforms, arg_uniform_data);
+    if (!tuple) {
+      goto fail;
+    }
+    // try not to break things here. these are borrowed refs.
+    PyObject *item0 = PyTuple_GetItem(tuple, 0);
+    PyObject *item1 = PyTuple_GetItem(tuple, 1);
+    PyObject *item2 = PyTuple_GetItem(tuple, 2);
+
+    uniforms = PyDictProxy_New(item0);
+    if (!uniforms) {
+      Py_DECREF(tuple);
+      goto fail;
+    }
+
+    uniform_layout = new_ref(item1);
+    uniform_data = new_ref(item2);
+    Py_DECREF(tuple);
+  } else {
+    uniforms = NULL;
+    if (arg_uniform_data != Py_None) {
+      uniform_data = new_ref(arg_uniform_data);
+    } else {
+      uniform_data = NULL;
+    }
+  }
+
+  validate = PyObject_CallMethod(self->module_state->helper, "validate",
+                                 "(OOOOO)", program->extra, layout, resources,
+                                 vertex_buffers, self->info_dict);
+  if (!validate) {
+    goto fail;
+  }
+
+  layout_bindings = PyObject_CallMethod(self->module_state->helper,
+                                        "layout_bindings", "(O)", layout);
+  if (!layout_bindings) {
+    goto fail;
+  }
+  if (!PyList_Check(layout_bindings)) {
+    PyErr_SetString(PyExc_TypeError,
+                    "[HyperGL] layout_bindings must be a list");
+    goto fail;
+  }
+
+  int layout_count = (int)PyList_Size(layout_bindings);
+  if (layout_count > 0) {
+    PyMutex_Lock(&self->state_lock);
+    int prev_program = self->current_program;
+    bind_program_internal(self, program->obj);
+    for (int i = 0; i < layout_count; ++i) {
+      PyObject *obj = PyList_GetItem(layout_bindings, i);
+      if (!PyTuple_Check(obj) || PyTuple_GET_SIZE(obj) < 2) {
+        PyErr_SetString(PyExc_TypeError, "[HyperGL] invalid layout binding");
+        PyMutex_Unlock(&self->state_lock);
+        goto fail;
+      }
+      PyObject *name = PyTuple_GetItem(obj, 0);
+      int binding = to_int(PyTuple_GetItem(obj, 1));
+
+      const char *name_str = PyUnicode_AsUTF8(name);
+      if (!name_str) {
+        PyMutex_Unlock(&self->state_lock);
+        goto fail;
+      }
+
+      int location = glGetUniformLocation(program->obj, name_str);
+      if (location >= 0) {
+        glUniform1i(location, binding);
+      } else {
+        GLuint index = glGetUniformBlockIndex(program->obj, name_str);
+        if (index != GL_INVALID_INDEX) {
+          glUniformBlockBinding(program->obj, index, (GLuint)binding);
+        }
+      }
+    }
+    bind_program_internal(self, prev_program);
+    PyMutex_Unlock(&self->state_lock);
+  }
+
+  framebuffer_attachments =
+      PyObject_CallMethod(self->module_state->helper, "framebuffer_attachments",
+                          "(O)", framebuffer_arg);
+  if (!framebuffer_attachments) {
+    goto fail;
+  }
+
+  if (framebuffer_attachments != Py_None && viewport == Py_None) {
+    PyObject *size = PyTuple_GetItem(framebuffer_attachments, 0);
+    viewport_value.width = to_int(PyTuple_GetItem(size, 0));
+    viewport_value.height = to_int(PyTuple_GetItem(size, 1));
+  }
+
+  // All GLObject builders must internally acquire ctx->state_lock
+  framebuffer = build_framebuffer(self, framebuffer_attachments);
+  if (!framebuffer) {
+    goto fail;
+  }
+
+  vertex_array_bindings =
+      PyObject_CallMethod(self->module_state->helper, "vertex_array_bindings",
+                          "(OO)", vertex_buffers, index_buffer);
+  if (!vertex_array_bindings) {
+    goto fail;
+  }
+
+  vertex_array = build_vertex_array(self, vertex_array_bindings);
+  if (!vertex_array) {
+    goto fail;
+  }
+
+  resource_bindings = PyObject_CallMethod(
+      self->module_state->helper, "resource_bindings", "(O)", resources);
+  if (!resource_bindings) {
+    goto fail;
+  }
+
+  descriptor_set = build_descriptor_set(self, resource_bindings);
+  if (!descriptor_set) {
+    goto fail;
+  }
+
+  settings = PyObject_CallMethod(self->module_state->helper, "settings",
+                                 "(OOOOO)", cull_face, depth, stencil, blend,
+                                 framebuffer_attachments);
+  if (!settings) {
+    goto fail;
+  }
+
+  global_settings = build_global_settings(self, settings);
+  if (!global_settings) {
+    goto fail;
+  }
+
+  // 5. Allocation
+  res = PyObject_GC_New(Pipeline, self->module_state->Pipeline_type);
+  if (!res) {
+    goto fail;
+  }
+
+  // Init pointers to NULL
+  res->ctx = NULL;
+  res->create_kwargs = NULL;
+  res->framebuffer = NULL;
+  res->vertex_array = NULL;
+  res->program = NULL;
+  res->uniforms = NULL;
+  res->uniform_layout = NULL;
+  res->uniform_data = NULL;
+  res->descriptor_set = NULL;
+  res->global_settings = NULL;
+  res->viewport_data = NULL;
+  res->render_data = NULL;
+
+  zeromem(&res->uniform_layout_buffer, sizeof(Py_buffer));
+  zeromem(&res->uniform_data_buffer, sizeof(Py_buffer));
+  zeromem(&res->viewport_data_buffer, sizeof(Py_buffer));
+  zeromem(&res->render_data_buffer, sizeof(Py_buffer));
+  zeromem(&res->params, sizeof(RenderParameters));
+  zeromem(&res->viewport, sizeof(Viewport));
+
+  res->ctx = self;
+  Py_INCREF(self);
+
+  // Steal References (Ownership transfer from locals to struct)
+  res->create_kwargs = create_kwargs;
+  create_kwargs = NULL;
+  res->framebuffer = framebuffer;
+  framebuffer = NULL;
+  res->vertex_array = vertex_array;
+  vertex_array = NULL;
+  res->program = program;
+  program = NULL;
+  res->uniforms = uniforms;
+  uniforms = NULL;
+  res->uniform_layout = uniform_layout;
+  uniform_layout = NULL;
+  res->uniform_data = uniform_data;
+  uniform_data = NULL;
+  res->descriptor_set = descriptor_set;
+  descriptor_set = NULL;
+  res->global_settings = global_settings;
+  global_settings = NULL;
+
+  res->topology = topology;
+  res->viewport = viewport_value;
+  res->params.vertex_count = vertex_count;
+  res->params.instance_count = instance_count;
+  res->params.first_vertex = first_vertex;
+  if (index_buffer == Py_None) {
+      res->index_type = INDEX_TYPE_NONE;
+  #ifdef DEBUG
+      if (short_index) {
+          fprintf(stderr,
+              "[HyperGL] short_index set without index buffer\n");
+          abort();
+      }
+  #endif
+  } else {
+      res->index_type = short_index
+          ? GL_UNSIGNED_SHORT
+          : GL_UNSIGNED_INT;
+  }
+
+  res->index_size = short_index ? 2 : 4;
+  res->index_offset = 0;
+  if (Py_TYPE(index_buffer) == self->module_state->BufferView_type) {
+    res->index_offset = ((BufferView *)index_buffer)->offset;
+    if (res->index_offset % res->index_size) {
+      PyErr_Format(PyExc_ValueError,
+                   "[HyperGL] the index buffer view is not aligned to the "
+                   "index size");
+      goto fail;
+    }
+  }
+
+  // 6. MemoryViews
+  if (viewport_data == Py_None) {
+    Py_buffer view = {0};
+    view.buf = (void *)&res->viewport;
+    view.len = sizeof(Viewport);
+    view.readonly = 0;
+    view.itemsize = 1;
+    view.format = NULL;
+    view.ndim = 1;
+    Py_ssize_t shape = view.len;
+    Py_ssize_t stride = 1;
+    view.shape = &shape;
+    view.strides = &stride;
+    view.suboffsets = NULL;
+    view.obj = (PyObject *)res;
+    Py_INCREF(res);
+
+    res->viewport_data = PyMemoryView_FromBuffer(&view);
+    if (!res->viewport_data) {
+      Py_DECREF(res);
+      goto fail;
+    }
+  } else {
+    res->viewport_data = new_ref(viewport_data);
+  }
+
+  if (render_data == Py_None) {
+    Py_buffer view = {0};
+    view.buf = (void *)&res->params;
+    view.len = sizeof(RenderParameters);
+    view.readonly = 0;
+    view.itemsize = 1;
+    view.format = NULL;
+    view.ndim = 1;
+    view.shape = &view.len;
+    view.strides = &view.itemsize;
+    view.suboffsets = NULL;
+    view.obj = (PyObject *)res;
+    Py_INCREF(res);
+
+    res->render_data = PyMemoryView_FromBuffer(&view);
+    if (!res->render_data) {
+      Py_DECREF(res);
+      goto fail;
+    }
+  } else {
+    res->render_data = new_ref(render_data);
+  }
+
+  // 7. Buffer Acquisition
+  if (PyObject_GetBuffer(res->viewport_data, &res->viewport_data_buffer,
+                         PyBUF_SIMPLE) < 0) {
+    goto fail;
+  }
+  if (PyObject_GetBuffer(res->render_data, &res->render_data_buffer,
+                         PyBUF_SIMPLE) < 0) {
+    goto fail;
+  }
+
+  if (res->uniforms) {
+    if (PyObject_GetBuffer(res->uniform_layout, &res->uniform_layout_buffer,
+                           PyBUF_SIMPLE) < 0) {
+      goto fail;
+    }
+    if (PyObject_GetBuffer(res->uniform_data, &res->uniform_data_buffer,
+                           PyBUF_SIMPLE) < 0) {
+      goto fail;
+    }
+  }
+
+  PyObject_GC_Track(res);
+
+  Py_XDECREF(validate);
+  Py_XDECREF(layout_bindings);
+  Py_XDECREF(framebuffer_attachments);
+  Py_XDECREF(vertex_array_bindings);
+  Py_XDECREF(resource_bindings);
+  Py_XDECREF(stream_resources);
+  Py_XDECREF(settings);
+
+  return res;
+
+fail:
+  if (res && res->viewport_data_buffer.obj) {
+    PyBuffer_Release(&res->viewport_data_buffer);
+  }
+
+  if (res && res->render_data_buffer.obj) {
+    PyBuffer_Release(&res->render_data_buffer);
+  }
+
+  if (res && res->uniform_layout_buffer.obj) {
+    PyBuffer_Release(&res->uniform_layout_buffer);
+  }
+
+  if (res && res->uniform_data_buffer.obj) {
+    PyBuffer_Release(&res->uniform_data_buffer);
+  }
+
+  Py_XDECREF(create_kwargs);
+  Py_XDECREF(program);
+  Py_XDECREF(uniforms);
+  Py_XDECREF(uniform_layout);
+  Py_XDECREF(uniform_data);
+  Py_XDECREF(template_obj);
+  if (framebuffer) {
+    Py_DECREF(framebuffer);
+  }
+  if (vertex_array) {
+    Py_DECREF(vertex_array);
+  }
+  if (descriptor_set) {
+    Py_DECREF(descriptor_set);
+  }
+  if (global_settings) {
+    Py_DECREF(global_settings);
+  }
+
+  Py_XDECREF(validate);
+  Py_XDECREF(layout_bindings);
+  Py_XDECREF(framebuffer_attachments);
+  Py_XDECREF(vertex_array_bindings);
+  Py_XDECREF(resource_bindings);
+  Py_XDECREF(stream_resources);
+  Py_XDECREF(settings);
+
+  if (res) {
+    Py_DECREF(res);
+  }
+  return NULL;
+}
+
+static int Pipeline_traverse(const Pipeline *self, visitproc visit, void *arg) {
+  Py_VISIT(self->ctx);
+  Py_VISIT(self->create_kwargs);
+  Py_VISIT(self->descriptor_set);
+  Py_VISIT(self->global_settings);
+  Py_VISIT(self->framebuffer);
+  Py_VISIT(self->vertex_array);
+  Py_VISIT(self->program);
+  Py_VISIT(self->uniforms);
+  Py_VISIT(self->uniform_layout);
+  Py_VISIT(self->uniform_data);
+  Py_VISIT(self->viewport_data);
+  Py_VISIT(self->render_data);
+  return 0;
+}
+
+static int Pipeline_clear(Pipeline *self) {
+  Py_CLEAR(self->ctx);
+  Py_CLEAR(self->create_kwargs);
+  Py_CLEAR(self->descriptor_set);
+  Py_CLEAR(self->global_settings);
+  Py_CLEAR(self->framebuffer);
+  Py_CLEAR(self->vertex_array);
+  Py_CLEAR(self->program);
+  Py_CLEAR(self->uniforms);
+  Py_CLEAR(self->uniform_layout);
+  Py_CLEAR(self->uniform_data);
+  Py_CLEAR(self->viewport_data);
+  Py_CLEAR(self->render_data);
+  return 0;
+}
+
+static PyObject *
+Pipeline_meth_render(const Pipeline *self,
+                     PyObject *args) // LGTM. Don’t overthink this path.
+                                     // Indirect handles the scaling problem.
+{
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "render",
+                              args, NULL, 0);
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+
+  Viewport *viewport = (Viewport *)self->viewport_data_buffer.buf;
+
+  bind_viewport_internal(self->ctx, viewport);
+  bind_global_settings_internal(self->ctx, self->global_settings);
+  bind_draw_framebuffer_internal(self->ctx, self->framebuffer->obj);
+  bind_program_internal(self->ctx, self->program->obj);
+  bind_vertex_array_internal(self->ctx, self->vertex_array->obj);
+  bind_descriptor_set_internal(self->ctx, self->descriptor_set);
+
+  if (self->uniforms) {
+    bind_uniforms(self);
+  }
+
+  RenderParameters *params = (RenderParameters *)self->render_data_buffer.buf;
+  if (self->index_type) {
+    intptr offset = self->index_offset +
+                    (intptr)params->first_vertex * (intptr)self->index_size;
+    glDrawElementsInstanced(self->topology, params->vertex_count,
+                            self->index_type, offset, params->instance_count);
+  } else {
+    glDrawArraysInstanced(self->topology, params->first_vertex,
+                          params->vertex_count, params->instance_count);
+  }
+
+  PyMutex_Unlock(&self->ctx->state_lock);
+
+  Py_RETURN_NONE;
+}
+
+static PyObject *Pipeline_meth_render_indirect(const Pipeline *self,
+                                               PyObject *args,
+                                               PyObject *kwargs) {
+  static char *keywords[] = {"buffer", "count", "offset", "stride", NULL};
+  PyObject *buffer_obj;
+  int draw_count;
+  Py_ssize_t offset = 0;
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "render_indirect",
+                              args, kwargs, 0);
+  }
+
+  int stride = self->index_type ? sizeof(DrawElementsIndirectCommand)
+                                : sizeof(DrawArraysIndirectCommand);
+
+  int user_stride = -1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Oi|ni", keywords, &buffer_obj,
+                                   &draw_count, &offset, &user_stride)) {
+    return NULL;
+  }
+
+  if (draw_count < 0) {
+    PyErr_SetString(PyExc_ValueError, "[HyperGL] count must be >= 0");
+    return NULL;
+  }
+
+  if (offset < 0) {
+    PyErr_SetString(PyExc_ValueError, "[HyperGL] offset must be >= 0");
+    return NULL;
+  }
+
+  if (user_stride > 0) {
+    stride = user_stride;
+  }
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] context lost");
+    return NULL;
+  }
+
+  // firstIndex in the commands counts from the start of the element buffer,
+  // GL has no way to shift it by the offset of an index buffer view
+  if (self->index_offset) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] render_indirect() needs an index buffer view at "
+                 "offset 0, add the view offset to firstIndex instead");
+    return NULL;
+  }
+
+  // --- AZDO Check ---
+  if (self->index_type) {
+    if (!glMultiDrawElementsIndirect) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "[HyperGL] glMultiDrawElementsIndirect not "
+                      "supported/loaded on this hardware.");
+      return NULL;
+    }
+  } else {
+    if (!glMultiDrawArraysIndirect) {
+      PyErr_SetString(PyExc_RuntimeError,
+                      "[HyperGL] glMultiDrawArraysIndirect not "
+                      "supported/loaded on this hardware.");
+      return NULL;
+    }
+  }
+  // ------------------
+
+  // A BufferView limits the commands to its range
+  Py_ssize_t base_offset = 0;
+  Py_ssize_t indirect_size = -1;
+  if (Py_TYPE(buffer_obj) == self->ctx->module_state->BufferView_type) {
+    base_offset = ((BufferView *)buffer_obj)->offset;
+    indirect_size = ((BufferView *)buffer_obj)->size;
+    buffer_obj = (PyObject *)((BufferView *)buffer_obj)->buffer;
+  }
+  if (!PyObject_TypeCheck(buffer_obj, self->ctx->module_state->Buffer_type)) {
+    PyErr_SetString(PyExc_TypeError,
+                    "[HyperGL] buffer must be a Buffer object");
+    return NULL;
+  }
+  Buffer *indirect_buffer = (Buffer *)buffer_obj;
+  if (indirect_size < 0) {
+    indirect_size = indirect_buffer->size;
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+
+  Viewport *viewport = (Viewport *)self->viewport_data_buffer.buf;
+  Viewport v1 = self->ctx->current_viewport;
+  Viewport v2 = self->viewport;
+
+  // 1. Bind State
+  if (v1.x != v2.x || v1.y != v2.y || v1.width != v2.width ||
+      v1.height != v2.height) {
+    bind_viewport_internal(self->ctx, viewport);
+  }
+  if (self->ctx->current_global_settings != self->global_settings) {
+    bind_global_settings_internal(self->ctx, self->global_settings);
+  }
+  if (self->ctx->current_draw_framebuffer != self->framebuffer->obj) {
+    bind_draw_framebuffer_internal(self->ctx, self->framebuffer->obj);
+  }
+  if (self->ctx->current_program != self->program->obj) {
+    bind_program_internal(self->ctx, self->program->obj);
+  }
+  if (self->ctx->current_vertex_array != self->vertex_array->obj) {
+    bind_vertex_array_internal(self->ctx, self->vertex_array->obj);
+  }
+  if (self->ctx->current_descriptor_set != self->descriptor_set) {
+    bind_descriptor_set_internal(self->ctx, self->descriptor_set);
+  }
+
+  if (self->uniforms) {
+    bind_uniforms(self);
+  }
+
+  // 2. Bind Indirect Buffer
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer->buffer);
+
+  intptr_t command_size = self->index_type ? sizeof(DrawElementsIndirectCommand)
+                                           : sizeof(DrawArraysIndirectCommand);
+
+  if (stride < command_size || (stride % 4) != 0) {
+    PyErr_SetString(PyExc_ValueError, "[HyperGL] invalid indirect stride");
+    PyMutex_Unlock(&self->ctx->state_lock);
+    return NULL;
+  }
+
+  // Offsets count commands, the byte range may go past 2 GiB
+  if (offset > PY_SSIZE_T_MAX / command_size) {
+    PyErr_SetString(PyExc_ValueError, "[HyperGL] indirect buffer too small");
+    PyMutex_Unlock(&self->ctx->state_lock);
+    return NULL;
+  }
+  intptr_t byte_offset = (intptr_t)offset * command_size;
+  Py_ssize_t required = (Py_ssize_t)draw_count * stride;
+  if (byte_offset > indirect_size || required > indirect_size - byte_offset) {
+    PyErr_SetString(PyExc_ValueError, "[HyperGL] indirect buffer too small");
+    PyMutex_Unlock(&self->ctx->state_lock);
+    return NULL;
+  }
+  // 3. Issue Draw Call (TODO: should use the commented one when ready)
+  // if (indirect_buffer->gpu_dirty) {
+  //     glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+  //     indirect_buffer->gpu_dirty = 0;
+  // }
+  glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+  const void *indirect_offset =
+      (const void *)((unsigned char *)NULL + base_offset + byte_offset);
+  if (self->index_type) {
+    // Indexed Draw
+    glMultiDrawElementsIndirect(self->topology, self->index_type,
+                                indirect_offset, draw_count, stride);
+  } else {
+    // Array Draw
+    glMultiDrawArraysIndirect(self->topology, indirect_offset, draw_count,
+                              stride);
+  }
+
+  PyMutex_Unlock(&self->ctx->state_lock);
+  Py_RETURN_NONE;
+}
+
+static PyObject *Pipeline_get_viewport(const Pipeline *self, void *closure) {
+  return Py_BuildValue("(iiii)", self->viewport.x, self->viewport.y,
+                       self->viewport.width, self->viewport.height);
+}
+
+static int Pipeline_set_viewport(Pipeline *self, PyObject *viewport,
+                                 void *closure) {
+  if (!to_viewport(&self->viewport, viewport, 0, 0, 0, 0)) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] the viewport must be a tuple of 4 ints");
+    return -1;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Type: Compute
+// -----------------------------------------------------------------------------
+
+static PyObject *Compute_meth_run(Compute *self, PyObject *args) {
+  int x = 1;
+  int y = 1;
+  int z = 1;
+
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "run",
+                              args, NULL, 0);
+  }
+
+  if (!PyArg_ParseTuple(args, "|iii", &x, &y, &z)) {
+    return NULL;
+  }
+
+  VALIDATE(x > 0 && y > 0 && z > 0, PyExc_ValueError,
+           "[HyperGL] Dispatch dimensions must be positive");
+
+  if (self->ctx->is_lost) {
+    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+    return NULL;
+  }
+
+  PyMutex_Lock(&self->ctx->state_lock);
+
+  bind_program_internal(self->ctx, self->program->obj);
+
+  bind_descriptor_set(self->ctx, self->descriptor_set);
+
+  if (self->uniforms) {
+    bind_uniforms((Pipeline *)self);
+  }
+  glDispatchCompute(x, y, z);
+  glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
+                  GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+  // glMemoryBarrier(GL_ALL_BARRIER_BITS); // sanity check
+  PyMutex_Unlock(&self->ctx->state_lock);
+
+  Py_RETURN_NONE;
+}
+
+static Compute *Context_meth_compute(Context *self, PyObject *args,
+                                     PyObject *kwargs) {
+  static char *keywords[] = {"compute_shader", "resources", "uniforms",
+                             "uniform_data", NULL};
+
+  if (off_render_thread(self)) {
+    return (Compute *)render_thread_call(self, (PyObject *)self, "compute",
+                                         args, kwargs, 1);
+  }
+
+  PyObject *compute_shader = NULL;
+  PyObject *resources = self->module_state->empty_tuple;
+  PyObject *uniforms_arg = Py_None;
+  PyObject *uniform_data = Py_None;
+  PyObject *shader_bytes = NULL;
+  GLObject *program = NULL;
+  PyObject *uniforms_proxy = NULL;
+  PyObject *uniform_layout = NULL;
+  PyObject *uniform_data_blob = NULL;
+  PyObject *resource_bindings = NULL;
+  DescriptorSet *descriptor_set = NULL;
+  Compute *res = NULL;
+  PyObject *tuple = NULL;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OOO", keywords,
+                                   &compute_shader, &resources, &uniforms_arg,
+                                   &uniform_data)) {
+    return NULL;
+  }
+
+  // --- Shader Processing ---
+  if (PyUnicode_Check(compute_shader)) {
+    shader_bytes = PyUnicode_AsUTF8String(compute_shader);
+    if (!shader_bytes) {
+      goto fail;
+    }
+  } else if (PyBytes_Check(compute_shader)) {
+    shader_bytes = compute_shader;
+    Py_INCREF(shader_bytes);
+  } else {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] compute_shader must be str or bytes");
+    goto fail;
+  }
+
+  program = compile_compute_program(self, NULL, shader_bytes);
+  Py_CLEAR(shader_bytes);
+  if (!program) {
+    goto fail;
+  }
+
+  // --- Uniforms Processing ---
+  if (uniforms_arg != Py_None) {
+    tuple = PyObject_CallMethod(self->module_state->helper, "uniforms", "(OOO)",
+                                program->extra, uniforms_arg, uniform_data);
+
+    if (!tuple) {
+      goto fail;
+    }
+
+    PyObject *uniform_dict = PyTuple_GetItem(tuple, 0);
+    if (!uniform_dict || !PyDict_Check(uniform_dict)) {
+      PyErr_Format(PyExc_RuntimeError,
+                   "[HyperGL] uniforms helper returned invalid layout");
+      goto fail;
+    }
+
+    uniforms_proxy = PyDictProxy_New(uniform_dict);
+    if (!uniforms_proxy) {
+      goto fail;
+    }
+
+    uniform_layout = PyTuple_GetItem(tuple, 1);
+    Py_XINCREF(uniform_layout);
+
+    uniform_data_blob = PyTuple_GetItem(tuple, 2);
+    Py_XINCREF(uniform_data_blob);
+
+    Py_CLEAR(tuple);
+  }
+
+  // --- Resource Processing ---
+  resource_bindings = PyObject_CallMethod(
+      self->module_state->helper, "resource_bindings", "(O)", resources);
+  if (!resource_bindings) {
+    goto fail;
+  }
+
+  descriptor_set = build_descriptor_set(self, resource_bindings);
+  Py_CLEAR(resource_bindings);
+  if (!descriptor_set) {
+    goto fail;
+  }
+
+  // --- Object Creation ---
+  res = PyObject_New(Compute, self->module_state->Compute_type);
+  if (!res) {
+    goto fail;
+  }
+
+  res->ctx = self;
+  Py_INCREF(self);
+  res->program = program; program = NULL;
+  res->descriptor_set = descriptor_set; descriptor_set = NULL;
+  res->uniforms = uniforms_proxy; uniforms_proxy = NULL;
+  res->uniform_layout = uniform_layout; uniform_layout = NULL;
+  res->uniform_data = uniform_data_blob; uniform_data_blob = NULL;
+  res->workgroup_size = NULL;
+  res->create_kwargs = NULL;
+  res->global_settings = NULL;
+  res->framebuffer = NULL;
+  res->vertex_array = NULL;
+  res->viewport_data = NULL;
+  res->render_data = NULL;
+  res->topology = 0;
+  res->index_type = 0;
+  res->index_size = 0;
+
+  zeromem(&res->uniform_layout_buffer, sizeof(Py_buffer));
+  zeromem(&res->uniform_data_buffer, sizeof(Py_buffer));
+  zeromem(&res->viewport_data_buffer, sizeof(Py_buffer));
+  zeromem(&res->render_data_buffer, sizeof(Py_buffer));
+  zeromem(&res->params, sizeof(RenderParameters));
+  zeromem(&res->viewport, sizeof(Viewport));
+
+  // --- Buffer Acquisition ---
+  if (res->uniforms) {
+    if (PyObject_GetBuffer(res->uniform_layout, &res->uniform_layout_buffer,
+                           PyBUF_SIMPLE)) {
+      goto fail;
+    }
+    if (PyObject_GetBuffer(res->uniform_data, &res->uniform_data_buffer,
+                           PyBUF_SIMPLE)) {
+      goto fail;
+    }
+  }
+
+  return res;
+
+fail:
+  Py_XDECREF(shader_bytes);
+  Py_XDECREF(uniforms_proxy);
+  Py_XDECREF(uniform_layout);
+  Py_XDECREF(uniform_data_blob);
+  Py_XDECREF(tuple);
+  Py_XDECREF(resource_bindings);
+  Py_XDECREF(descriptor_set);
+  if (res) {
+    Py_DECREF(res);
+  }
+
+  return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Other Methods: Context Pack/NewFrame, Inspection, Helpers
+// -----------------------------------------------------------------------------
+
+static PyObject *Context_meth_pack_indirect(Context *self, PyObject *args,
+                                            PyObject *kwargs) {
+  static char *keywords[] = {"commands", "indexed", NULL};
+  PyObject *commands;
+  int indexed = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", keywords, &commands,
+                                   &indexed)) {
+    return NULL;
+  }
+
+  // OPTIMIZATION: Convert outer sequence to a fast array
+  PyObject *fast_commands =
+      PySequence_Fast(commands, "[HyperGL] commands must be a sequence");
+  if (!fast_commands) {
+    return NULL;
+  }
+
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(fast_commands);
+  if (count == 0) {
+    Py_DECREF(fast_commands);
+    return PyBytes_FromStringAndSize("", 0);
+  }
+
+  // Determine sizes
+  const Py_ssize_t stride = indexed ? 20 : 16;
+  const Py_ssize_t total_size = count * stride;
+
+  PyObject *result = PyBytes_FromStringAndSize(NULL, total_size);
+  if (!result) {
+    Py_DECREF(fast_commands);
+    return NULL;
+  }
+
+  unsigned char *base_ptr = (unsigned char *)PyBytes_AsString(result);
+  // Zero out memory so padding bytes (if any) or implicit zeros are clean
+  memset(base_ptr, 0, total_size);
+
+  PyObject **items = PySequence_Fast_ITEMS(fast_commands);
+  int error_occurred = 0;
+
+  for (Py_ssize_t i = 0; i < count; i++) {
+    // OPTIMIZATION: Direct pointer access (borrowed ref)
+    PyObject *cmd = items[i];
+
+    // OPTIMIZATION: Convert inner sequence to fast array
+    PyObject *fast_cmd =
+        PySequence_Fast(cmd, "[HyperGL] Command is not a sequence");
+    if (!fast_cmd) {
+      error_occurred = 1;
+      break;
+    }
+
+    Py_ssize_t inputs = PySequence_Fast_GET_SIZE(fast_cmd);
+    PyObject **cmd_items = PySequence_Fast_ITEMS(fast_cmd);
+
+    unsigned char *current_struct_ptr = base_ptr + (i * stride);
+
+    if (indexed) {
+      // --- INDEXED PATH ---
+      if (inputs != 4 && inputs != 5) {
+        PyErr_Format(PyExc_ValueError,
+                     "[HyperGL] Indexed command %zd must have 4 or 5 values",
+                     i);
+        Py_DECREF(fast_cmd);
+        error_occurred = 1;
+        break;
+      }
+
+      struct DrawElementsIndirectCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t baseInstance;
+      } *out = (void *)current_struct_ptr;
+
+      // 1. count
+      unsigned long long val = PyLong_AsUnsignedLongLong(cmd_items[0]);
+      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+        goto index_error;
+      }
+      if (val > UINT32_MAX) {
+        goto range_error;
+      }
+      out->count = (uint32_t)val;
+
+      // 2. instanceCount
+      val = PyLong_AsUnsignedLongLong(cmd_items[1]);
+      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+        goto index_error;
+      }
+      if (val > UINT32_MAX) {
+        goto range_error;
+      }
+      out->instanceCount = (uint32_t)val;
+
+      // 3. firstIndex
+      val = PyLong_AsUnsignedLongLong(cmd_items[2]);
+      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+        goto index_error;
+      }
+      if (val > UINT32_MAX) {
+        goto range_error;
+      }
+      out->firstIndex = (uint32_t)val;
+
+      if (inputs == 5) {
+        // 4. baseVertex (Signed)
+        const long long sval = PyLong_AsLongLong(cmd_items[3]);
+        if (sval == -1 && PyErr_Occurred()) {
+          goto index_error;
+        }
+        if (sval < INT32_MIN || sval > INT32_MAX) {
+          goto range_error;
+        }
+        out->baseVertex = (int32_t)sval;
+
+        // 5. baseInstance
+        val = PyLong_AsUnsignedLongLong(cmd_items[4]);
+        if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+          goto index_error;
+        }
+        if (val > UINT32_MAX) {
+          goto range_error;
+        }
+        out->baseInstance = (uint32_t)val;
+      } else {
+        // inputs == 4
+        // baseVertex is implicitly 0
+        out->baseVertex = 0;
+
+        // 4. baseInstance (taken from item index 3)
+        val = PyLong_AsUnsignedLongLong(cmd_items[3]);
+        if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+          goto index_error;
+        }
+        if (val > UINT32_MAX) {
+          goto range_error;
+        }
+        out->baseInstance = (uint32_t)val;
+      }
+
+    } else {
+      // --- ARRAY PATH ---
+      if (inputs != 4) {
+        PyErr_Format(
+            PyExc_ValueError,
+            "[HyperGL] Non-indexed command %zd must have exactly 4 values", i);
+        Py_DECREF(fast_cmd);
+        error_occurred = 1;
+        break;
+      }
+
+      struct DrawArraysIndirectCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t first;
+        uint32_t baseInstance;
+      } *out = (void *)current_struct_ptr;
+
+      // 1. count
+      unsigned long long val = PyLong_AsUnsignedLongLong(cmd_items[0]);
+      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+        goto array_error;
+      }
+      if (val > UINT32_MAX) {
+        goto range_error;
+      }
+      out->count = (uint32_t)val;
+
+      // 2. instanceCount
+      val = PyLong_AsUnsignedLongLong(cmd_items[1]);
+      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+        goto array_error;
+      }
+      if (val > UINT32_MAX) {
+        goto range_error;
+      }
+      out->instanceCount = (uint32_t)val;
+
+      // 3. first
+      val = PyLong_AsUnsignedLongLong(cmd_items[2]);
+      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+        goto array_error;
+      }
+      if (val > UINT32_MAX) {
+        goto range_error;
+      }
+      out->first = (uint32_t)val;
+
+      // 4. baseInstance
+      val = PyLong_AsUnsignedLongLong(cmd_items[3]);
+      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
+        goto array_error;
+      }
+      if (val > UINT32_MAX) {
+        goto range_error;
+      }
+      out->baseInstance = (uint32_t)val;
+    }
+
+    Py_DECREF(fast_cmd);
+    continue;
+
+  // Error handling block
+  index_error:
+  array_error:
+    error_occurred = 1;
+    Py_DECREF(fast_cmd);
+    break;
+
+  range_error:
+    PyErr_SetString(PyExc_ValueError,
+                    "[HyperGL] Value out of range for indirect buffer");
+    error_occurred = 1;
+    Py_DECREF(fast_cmd);
+    break;
+  }
+
+  Py_DECREF(fast_commands);
+
+  if (error_occurred) {
+    Py_DECREF(result);
+    return NULL;
+  }
+
+  return result;
+}
 
+// -----------------------------------------------------------------------------
+// Type: Encoder (deferred command recording)
+// -----------------------------------------------------------------------------
+
+static Encoder *Context_meth_encoder(Context *self, PyObject *args) {
+  Encoder *res = PyObject_GC_New(Encoder, self->module_state->Encoder_type);
+  if (!res) {
+    return NULL;
+  }
+  res->ctx = (Context *)new_ref((PyObject *)self);
+  memset(&res->lock, 0, sizeof(PyMutex));
+  res->commands = NULL;
+  res->count = 0;
+  res->capacity = 0;
+  PyObject_GC_Track(res);
   return res;
+}
 
-fail:
-  if (res && res->viewport_data_buffer.obj) {
-    PyBuffer_Release(&res->viewport_data_buffer);
+// Copy client memory so the producer may reuse it right after recording.
+// Buffers and BufferViews are GPU side sources and are kept by reference.
+// The copy keeps the item format, and a float32 convert is checked here
+// rather than when the encoder is replayed.
+static PyObject *encoder_snapshot(const Encoder *self, PyObject *data,
+                                  int convert) {
+  if (data == Py_None || Py_TYPE(data) == self->ctx->module_state->Buffer_type ||
+      Py_TYPE(data) == self->ctx->module_state->BufferView_type) {
+    return new_ref(data);
   }
 
-  if (res && res->render_data_buffer.obj) {
-    PyBuffer_Release(&res->render_data_buffer);
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_FORMAT | PyBUF_STRIDES) < 0) {
+    if (convert != CONVERT_NONE) {
+      return NULL;
+    }
+    // Iterables of ints carry no format
+    PyErr_Clear();
+    return PyBytes_FromObject(data);
   }
 
-  if (res && res->uniform_layout_buffer.obj) {
-    PyBuffer_Release(&res->uniform_layout_buffer);
+  if (convert != CONVERT_NONE && convert_source_count(&view) < 0) {
+    PyBuffer_Release(&view);
+    return NULL;
   }
 
-  if (res && res->uniform_data_buffer.obj) {
-    PyBuffer_Release(&res->uniform_data_buffer);
+  PyObject *res = PyBytes_FromObject(data);
+  const char *format = view.format;
+  if (format && (format[0] == '@' || format[0] == '=' ||
+                 (format[0] == '<' && PY_LITTLE_ENDIAN))) {
+    ++format;
+  }
+  if (res && format && strcmp(format, "B")) {
+    PyObject *bytes_view = PyMemoryView_FromObject(res);
+    PyObject *typed =
+        bytes_view ? PyObject_CallMethod(bytes_view, "cast", "s", format)
+                   : NULL;
+    Py_XDECREF(bytes_view);
+    if (typed) {
+      Py_SETREF(res, typed);
+    } else if (convert == CONVERT_NONE) {
+      // Struct formats only matter to a convert
+      PyErr_Clear();
+    } else {
+      Py_CLEAR(res);
+    }
   }
+  PyBuffer_Release(&view);
+  return res;
+}
 
-  Py_XDECREF(create_kwargs);
-  Py_XDECREF(program);
-  Py_XDECREF(uniforms);
-  Py_XDECREF(uniform_layout);
-  Py_XDECREF(uniform_data);
-  Py_XDECREF(template_obj);
-  if (framebuffer) {
-    Py_DECREF(framebuffer);
+// The convert argument of Buffer.write() or Image.write(), CONVERT_NONE when
+// absent and -1 with an error set when invalid
+static int encoder_convert(const Encoder *self, int op, PyObject *call_args,
+                           PyObject *call_kwargs) {
+  const Py_ssize_t index = op == ENCODER_WRITE ? 3 : 5;
+  PyObject *convert = NULL;
+  if (PyTuple_GET_SIZE(call_args) > index) {
+    convert = Py_NewRef(PyTuple_GET_ITEM(call_args, index));
+  } else if (call_kwargs &&
+             PyDict_GetItemStringRef(call_kwargs, "convert", &convert) < 0) {
+    return -1;
   }
-  if (vertex_array) {
-    Py_DECREF(vertex_array);
+  if (!convert || convert == Py_None) {
+    Py_XDECREF(convert);
+    return CONVERT_NONE;
   }
-  if (descriptor_set) {
-    Py_DECREF(descriptor_set);
+  const char *name = PyUnicode_AsUTF8(convert);
+  const int res = name ? to_upload_convert(name) : -1;
+  Py_DECREF(convert);
+  return res;
+}
+
+// Records `target.method(*args[1:], **kwargs)`. Nothing touches GL here.
+static PyObject *encoder_record(Encoder *self, int op, PyTypeObject *type,
+                                int has_data, PyObject *args,
+                                PyObject *kwargs) {
+  Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+  if (nargs < 1 || Py_TYPE(PyTuple_GET_ITEM(args, 0)) != type) {
+    PyErr_Format(PyExc_TypeError, "[HyperGL] the first argument must be a %s",
+                 type->tp_name);
+    return NULL;
   }
-  if (global_settings) {
-    Py_DECREF(global_settings);
+
+  PyObject *target = PyTuple_GET_ITEM(args, 0);
+  PyObject *call_args = PyTuple_GetSlice(args, 1, nargs);
+  PyObject *call_kwargs = kwargs ? PyDict_Copy(kwargs) : NULL;
+  if (!call_args || (kwargs && !call_kwargs)) {
+    goto fail;
   }
 
-  Py_XDECREF(validate);
-  Py_XDECREF(layout_bindings);
-  Py_XDECREF(framebuffer_attachments);
-  Py_XDECREF(vertex_array_bindings);
-  Py_XDECREF(resource_bindings);
-  Py_XDECREF(settings);
+  if (has_data) {
+    const int convert = encoder_convert(self, op, call_args, call_kwargs);
+    if (convert < 0) {
+      goto fail;
+    }
+    if (PyTuple_GET_SIZE(call_args) > 0) {
+      PyObject *data =
+          encoder_snapshot(self, PyTuple_GET_ITEM(call_args, 0), convert);
+      if (!data) {
+        goto fail;
+      }
+      // call_args is a fresh tuple owned by us, safe to patch in place
+      Py_SETREF(PyTuple_GET_ITEM(call_args, 0), data);
+    } else if (call_kwargs) {
+      PyObject *data = NULL;
+      if (PyDict_GetItemRef(call_kwargs, self->ctx->module_state->str_data,
+                            &data) < 0) {
+        goto fail;
+      }
+      if (data) {
+        PyObject *copy = encoder_snapshot(self, data, convert);
+        Py_DECREF(data);
+        if (!copy || PyDict_SetItem(call_kwargs,
+                                    self->ctx->module_state->str_data,
+                                    copy) < 0) {
+          Py_XDECREF(copy);
+          goto fail;
+        }
+        Py_DECREF(copy);
+      }
+    }
+  }
 
-  if (res) {
-    Py_DECREF(res);
+  PyMutex_Lock(&self->lock);
+  if (self->count == self->capacity) {
+    int new_capacity = self->capacity ? self->capacity * 2 : 64;
+    EncoderCommand *commands = PyMem_Realloc(
+        self->commands, new_capacity * sizeof(EncoderCommand));
+    if (!commands) {
+      PyMutex_Unlock(&self->lock);
+      PyErr_NoMemory();
+      goto fail;
+    }
+    self->commands = commands;
+    self->capacity = new_capacity;
   }
+  self->commands[self->count++] =
+      (EncoderCommand){op, new_ref(target), call_args, call_kwargs};
+  PyMutex_Unlock(&self->lock);
+
+  Py_RETURN_NONE;
+
+fail:
+  Py_XDECREF(call_args);
+  Py_XDECREF(call_kwargs);
   return NULL;
 }
 
-static int Pipeline_traverse(const Pipeline *self, visitproc visit, void *arg) {
-  Py_VISIT(self->ctx);
-  Py_VISIT(self->create_kwargs);
-  Py_VISIT(self->descriptor_set);
-  Py_VISIT(self->global_settings);
-  Py_VISIT(self->framebuffer);
-  Py_VISIT(self->vertex_array);
-  Py_VISIT(self->program);
-  Py_VISIT(self->uniforms);
-  Py_VISIT(self->uniform_layout);
-  Py_VISIT(self->uniform_data);
-  Py_VISIT(self->viewport_data);
-  Py_VISIT(self->render_data);
-  return 0;
+static PyObject *Encoder_meth_write(Encoder *self, PyObject *args,
+                                    PyObject *kwargs) {
+  return encoder_record(self, ENCODER_WRITE,
+                        self->ctx->module_state->Buffer_type, 1, args, kwargs);
 }
 
-static int Pipeline_clear(Pipeline *self) {
-  Py_CLEAR(self->ctx);
-  Py_CLEAR(self->create_kwargs);
-  Py_CLEAR(self->descriptor_set);
-  Py_CLEAR(self->global_settings);
-  Py_CLEAR(self->framebuffer);
-  Py_CLEAR(self->vertex_array);
-  Py_CLEAR(self->program);
-  Py_CLEAR(self->uniforms);
-  Py_CLEAR(self->uniform_layout);
-  Py_CLEAR(self->uniform_data);
-  Py_CLEAR(self->viewport_data);
-  Py_CLEAR(self->render_data);
-  return 0;
+static PyObject *Encoder_meth_write_image(Encoder *self, PyObject *args,
+                                          PyObject *kwargs) {
+  return encoder_record(self, ENCODER_WRITE_IMAGE,
+                        self->ctx->module_state->Image_type, 1, args, kwargs);
 }
 
-static PyObject *
-Pipeline_meth_render(const Pipeline *self,
-                     PyObject *args) // LGTM. Don’t overthink this path.
-                                     // Indirect handles the scaling problem.
-{
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
-    return NULL;
-  }
-
-  PyMutex_Lock(&self->ctx->state_lock);
-
-  Viewport *viewport = (Viewport *)self->viewport_data_buffer.buf;
-
-  bind_viewport_internal(self->ctx, viewport);
-  bind_global_settings_internal(self->ctx, self->global_settings);
-  bind_draw_framebuffer_internal(self->ctx, self->framebuffer->obj);
-  bind_program_internal(self->ctx, self->program->obj);
-  bind_vertex_array_internal(self->ctx, self->vertex_array->obj);
-  bind_descriptor_set_internal(self->ctx, self->descriptor_set);
+static PyObject *Encoder_meth_blit(Encoder *self, PyObject *args,
+                                   PyObject *kwargs) {
+  return encoder_record(self, ENCODER_BLIT,
+                        self->ctx->module_state->Image_type, 0, args, kwargs);
+}
 
-  if (self->uniforms) {
-    bind_uniforms(self);
+// Pipeline.render() takes no arguments, anything extra would be dropped on
+// replay. Uniforms and counts are read when the command runs.
+static PyObject *Encoder_meth_render(Encoder *self, PyObject *args,
+                                     PyObject *kwargs) {
+  if (PyTuple_GET_SIZE(args) != 1 || (kwargs && PyDict_GET_SIZE(kwargs))) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] render() takes only the pipeline");
+    return NULL;
   }
+  return encoder_record(self, ENCODER_RENDER,
+                        self->ctx->module_state->Pipeline_type, 0, args,
+                        kwargs);
+}
 
-  RenderParameters *params = (RenderParameters *)self->render_data_buffer.buf;
-  if (self->index_type) {
-    intptr offset = (intptr)params->first_vertex * (intptr)self->index_size;
-    glDrawElementsInstanced(self->topology, params->vertex_count,
-                            self->index_type, offset, params->instance_count);
-  } else {
-    glDrawArraysInstanced(self->topology, params->first_vertex,
-                          params->vertex_count, params->instance_count);
+static PyObject *Encoder_meth_render_indirect(Encoder *self, PyObject *args,
+                                              PyObject *kwargs) {
+  // Same check as Pipeline.render_indirect(), raised when recording
+  PyObject *pipeline =
+      PyTuple_GET_SIZE(args) ? PyTuple_GET_ITEM(args, 0) : NULL;
+  if (pipeline &&
+      Py_TYPE(pipeline) == self->ctx->module_state->Pipeline_type &&
+      ((Pipeline *)pipeline)->index_offset) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] render_indirect() needs an index buffer view at "
+                 "offset 0, add the view offset to firstIndex instead");
+    return NULL;
   }
-
-  PyMutex_Unlock(&self->ctx->state_lock);
-
-  Py_RETURN_NONE;
+  return encoder_record(self, ENCODER_RENDER_INDIRECT,
+                        self->ctx->module_state->Pipeline_type, 0, args,
+                        kwargs);
 }
 
-static PyObject *Pipeline_meth_render_indirect(const Pipeline *self,
-                                               PyObject *args,
-                                               PyObject *kwargs) {
-  static char *keywords[] = {"buffer", "count", "offset", "stride", NULL};
-  PyObject *buffer_obj;
-  int draw_count;
-  int offset = 0;
-  int stride = self->index_type ? sizeof(DrawElementsIndirectCommand)
-                                : sizeof(DrawArraysIndirectCommand);
-
-  int user_stride = -1;
+// Compute.run() is positional only, so the group counts are resolved here
+static PyObject *Encoder_meth_run(Encoder *self, PyObject *args,
+                                  PyObject *kwargs) {
+  static char *keywords[] = {"compute", "x", "y", "z", NULL};
+  PyObject *compute;
+  int x = 1;
+  int y = 1;
+  int z = 1;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Oi|ii", keywords, &buffer_obj,
-                                   &draw_count, &offset, &user_stride)) {
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|iii", keywords,
+                                   self->ctx->module_state->Compute_type,
+                                   &compute, &x, &y, &z)) {
     return NULL;
   }
 
-  if (draw_count < 0) {
-    PyErr_SetString(PyExc_ValueError, "[HyperGL] count must be >= 0");
+  PyObject *call_args = Py_BuildValue("(Oiii)", compute, x, y, z);
+  if (!call_args) {
     return NULL;
   }
+  PyObject *res = encoder_record(self, ENCODER_RUN,
+                                 self->ctx->module_state->Compute_type, 0,
+                                 call_args, NULL);
+  Py_DECREF(call_args);
+  return res;
+}
 
-  if (offset < 0) {
-    PyErr_SetString(PyExc_ValueError, "[HyperGL] offset must be >= 0");
+// Reads only make sense deferred when they land in caller-owned memory,
+// pair them with ctx.fence() to know when the data is there.
+static PyObject *Encoder_meth_read(Encoder *self, PyObject *args,
+                                   PyObject *kwargs) {
+  ModuleState *state = self->ctx->module_state;
+  Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+  PyObject *target = nargs > 0 ? PyTuple_GET_ITEM(args, 0) : NULL;
+  PyTypeObject *type = target && Py_TYPE(target) == state->Image_type
+                           ? state->Image_type
+                           : state->Buffer_type;
+
+  PyObject *into = nargs > 3 ? PyTuple_GET_ITEM(args, 3) : NULL;
+  if (!into && kwargs) {
+    into = PyDict_GetItemString(kwargs, "into");
+  }
+  if (!into || into == Py_None) {
+    PyErr_Format(PyExc_ValueError,
+                 "[HyperGL] deferred reads require the into parameter");
     return NULL;
   }
 
-  if (user_stride > 0) {
-    stride = user_stride;
+  return encoder_record(self, ENCODER_READ, type, 0, args, kwargs);
+}
+
+// Hand the recorded commands to the context. Batches run in submission order
+// at the next new_frame / end_frame, the encoder is empty again afterwards.
+static PyObject *Encoder_meth_submit(Encoder *self, PyObject *args) {
+  EncoderBatch *batch = PyMem_Malloc(sizeof(EncoderBatch));
+  if (!batch) {
+    return PyErr_NoMemory();
   }
 
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] context lost");
-    return NULL;
+  PyMutex_Lock(&self->lock);
+  batch->next = NULL;
+  batch->commands = self->commands;
+  batch->count = self->count;
+  self->commands = NULL;
+  self->count = 0;
+  self->capacity = 0;
+  PyMutex_Unlock(&self->lock);
+
+  if (!batch->count) {
+    PyMem_Free(batch->commands);
+    PyMem_Free(batch);
+    Py_RETURN_NONE;
   }
 
-  // --- AZDO Check ---
-  if (self->index_type) {
-    if (!glMultiDrawElementsIndirect) {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "[HyperGL] glMultiDrawElementsIndirect not "
-                      "supported/loaded on this hardware.");
-      return NULL;
-    }
+  Context *ctx = self->ctx;
+  PyMutex_Lock(&ctx->encoder_lock);
+  if (ctx->encoder_tail) {
+    ctx->encoder_tail->next = batch;
   } else {
-    if (!glMultiDrawArraysIndirect) {
-      PyErr_SetString(PyExc_RuntimeError,
-                      "[HyperGL] glMultiDrawArraysIndirect not "
-                      "supported/loaded on this hardware.");
-      return NULL;
-    }
+    ctx->encoder_head = batch;
   }
-  // ------------------
+  ctx->encoder_tail = batch;
+  PyMutex_Unlock(&ctx->encoder_lock);
 
-  if (!PyObject_TypeCheck(buffer_obj, self->ctx->module_state->Buffer_type)) {
-    PyErr_SetString(PyExc_TypeError,
-                    "[HyperGL] buffer must be a Buffer object");
-    return NULL;
+  Py_RETURN_NONE;
+}
+
+static PyObject *Encoder_get_count(Encoder *self, void *closure) {
+  PyMutex_Lock(&self->lock);
+  int count = self->count;
+  PyMutex_Unlock(&self->lock);
+  return PyLong_FromLong(count);
+}
+
+// Replay every submitted batch on the context thread. On the first failing
+// command the rest of the queue is discarded and the error is raised.
+static int run_encoders(Context *self) {
+  PyMutex_Lock(&self->encoder_lock);
+  EncoderBatch *batch = self->encoder_head;
+  self->encoder_head = NULL;
+  self->encoder_tail = NULL;
+  PyMutex_Unlock(&self->encoder_lock);
+
+  int status = 0;
+  for (EncoderBatch *it = batch; it && !status; it = it->next) {
+    for (int i = 0; i < it->count; ++i) {
+      EncoderCommand *cmd = &it->commands[i];
+      PyObject *res = NULL;
+      switch (cmd->op) {
+      case ENCODER_WRITE:
+        res = Buffer_meth_write((Buffer *)cmd->target, cmd->args, cmd->kwargs);
+        break;
+      case ENCODER_WRITE_IMAGE:
+        res = Image_meth_write((Image *)cmd->target, cmd->args, cmd->kwargs);
+        break;
+      case ENCODER_BLIT:
+        res = Image_meth_blit((Image *)cmd->target, cmd->args, cmd->kwargs);
+        break;
+      case ENCODER_RENDER:
+        res = Pipeline_meth_render((Pipeline *)cmd->target, cmd->args);
+        break;
+      case ENCODER_RENDER_INDIRECT:
+        res = Pipeline_meth_render_indirect((Pipeline *)cmd->target, cmd->args,
+                                            cmd->kwargs);
+        break;
+      case ENCODER_RUN:
+        res = Compute_meth_run((Compute *)cmd->target, cmd->args);
+        break;
+      case ENCODER_READ:
+        if (Py_TYPE(cmd->target) == self->module_state->Image_type) {
+          res = Image_meth_read((Image *)cmd->target, cmd->args, cmd->kwargs);
+        } else {
+          res = Buffer_meth_read((Buffer *)cmd->target, cmd->args,
+                                 cmd->kwargs);
+        }
+        break;
+      default:
+        PyErr_Format(PyExc_RuntimeError, "[HyperGL] invalid encoder command");
+        break;
+      }
+      if (!res) {
+        status = -1;
+        break;
+      }
+      Py_DECREF(res);
+    }
   }
-  Buffer *indirect_buffer = (Buffer *)buffer_obj;
 
-  PyMutex_Lock(&self->ctx->state_lock);
+  release_encoder_batches(batch);
+  return status;
+}
 
-  Viewport *viewport = (Viewport *)self->viewport_data_buffer.buf;
-  Viewport v1 = self->ctx->current_viewport;
-  Viewport v2 = self->viewport;
+// -----------------------------------------------------------------------------
+// Render Thread
+// -----------------------------------------------------------------------------
 
-  // 1. Bind State
-  if (v1.x != v2.x || v1.y != v2.y || v1.width != v2.width ||
-      v1.height != v2.height) {
-    bind_viewport_internal(self->ctx, viewport);
-  }
-  if (self->ctx->current_global_settings != self->global_settings) {
-    bind_global_settings_internal(self->ctx, self->global_settings);
-  }
-  if (self->ctx->current_draw_framebuffer != self->framebuffer->obj) {
-    bind_draw_framebuffer_internal(self->ctx, self->framebuffer->obj);
-  }
-  if (self->ctx->current_program != self->program->obj) {
-    bind_program_internal(self->ctx, self->program->obj);
-  }
-  if (self->ctx->current_vertex_array != self->vertex_array->obj) {
-    bind_vertex_array_internal(self->ctx, self->vertex_array->obj);
-  }
-  if (self->ctx->current_descriptor_set != self->descriptor_set) {
-    bind_descriptor_set_internal(self->ctx, self->descriptor_set);
+static PyObject *Context_meth_new_frame(Context *self, PyObject *args,
+                                        PyObject *kwargs);
+static PyObject *Context_meth_end_frame(Context *self, PyObject *args,
+                                        PyObject *kwargs);
+
+static void wait_event_init(WaitEvent *event) {
+#ifdef _WIN32
+  InitializeSRWLock(&event->lock);
+  InitializeConditionVariable(&event->cond);
+#else
+  pthread_mutex_init(&event->lock, NULL);
+  pthread_cond_init(&event->cond, NULL);
+#endif
+}
+
+static void wait_event_destroy(WaitEvent *event) {
+#ifndef _WIN32
+  pthread_cond_destroy(&event->cond);
+  pthread_mutex_destroy(&event->lock);
+#endif
+}
+
+// Stores a new value and wakes the threads waiting on it. Waiters check the
+// value under the lock, so a store just before they park is never missed.
+static void wait_event_store(WaitEvent *event, volatile long long *value,
+                             long long new_value) {
+#ifdef _WIN32
+  AcquireSRWLockExclusive(&event->lock);
+  Atomic_Store64(value, new_value);
+  WakeAllConditionVariable(&event->cond);
+  ReleaseSRWLockExclusive(&event->lock);
+#else
+  pthread_mutex_lock(&event->lock);
+  Atomic_Store64(value, new_value);
+  pthread_cond_broadcast(&event->cond);
+  pthread_mutex_unlock(&event->lock);
+#endif
+}
+
+// Blocks, detached from the interpreter, until *value differs from `old`. A
+// negative timeout waits forever. Returns 0 on timeout.
+static int wait_event_wait(WaitEvent *event, volatile long long *value,
+                           long long old, double timeout) {
+  if (Atomic_Load64(value) != old) {
+    return 1;
   }
 
-  if (self->uniforms) {
-    bind_uniforms(self);
+  int changed;
+  Py_BEGIN_ALLOW_THREADS
+#ifdef _WIN32
+  const ULONGLONG start = GetTickCount64();
+  AcquireSRWLockExclusive(&event->lock);
+  while (!(changed = Atomic_Load64(value) != old)) {
+    DWORD ms = INFINITE;
+    if (timeout >= 0.0) {
+      const double left = timeout * 1000.0 - (double)(GetTickCount64() - start);
+      if (left <= 0.0) {
+        break;
+      }
+      ms = (DWORD)left + 1;
+    }
+    SleepConditionVariableSRW(&event->cond, &event->lock, ms, 0);
   }
-
-  // 2. Bind Indirect Buffer
-  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer->buffer);
-
-  intptr_t command_size = self->index_type ? sizeof(DrawElementsIndirectCommand)
-                                           : sizeof(DrawArraysIndirectCommand);
-
-  if (stride < command_size || (stride % 4) != 0) {
-    PyErr_SetString(PyExc_ValueError, "[HyperGL] invalid indirect stride");
-    PyMutex_Unlock(&self->ctx->state_lock);
-    return NULL;
+  ReleaseSRWLockExclusive(&event->lock);
+#else
+  struct timespec deadline;
+  if (timeout >= 0.0) {
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    const double seconds = (double)deadline.tv_nsec * 1e-9 + timeout;
+    deadline.tv_sec += (time_t)seconds;
+    deadline.tv_nsec = (long)((seconds - (double)(time_t)seconds) * 1e9);
+  }
+  pthread_mutex_lock(&event->lock);
+  while (!(changed = Atomic_Load64(value) != old)) {
+    if (timeout < 0.0) {
+      pthread_cond_wait(&event->cond, &event->lock);
+    } else if (pthread_cond_timedwait(&event->cond, &event->lock,
+                                      &deadline) == ETIMEDOUT) {
+      changed = Atomic_Load64(value) != old;
+      break;
+    }
   }
+  pthread_mutex_unlock(&event->lock);
+#endif
+  Py_END_ALLOW_THREADS
+  return changed;
+}
 
-  intptr_t byte_offset = (intptr_t)offset * command_size;
-  size_t required = byte_offset + ((size_t)draw_count * stride);
-  if (required > indirect_buffer->size) {
-    PyErr_SetString(PyExc_ValueError, "[HyperGL] indirect buffer too small");
-    PyMutex_Unlock(&self->ctx->state_lock);
-    return NULL;
+// Once the render thread stored its exit state under the lock, taking the
+// lock once more guarantees it let go of the ring before the ring is freed
+static void render_ring_free(RenderRing *ring) {
+#ifdef _WIN32
+  AcquireSRWLockExclusive(&ring->event.lock);
+  ReleaseSRWLockExclusive(&ring->event.lock);
+#else
+  pthread_mutex_lock(&ring->event.lock);
+  pthread_mutex_unlock(&ring->event.lock);
+#endif
+  wait_event_destroy(&ring->event);
+  PyMem_RawFree(ring);
+}
+
+// Blocks the render thread, not the producer, until the GPU caught up
+static void render_thread_finish(void) {
+  if (!glFenceSync) {
+    glFinish();
+    return;
   }
-  // 3. Issue Draw Call (TODO: should use the commented one when ready)
-  // if (indirect_buffer->gpu_dirty) {
-  //     glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
-  //     indirect_buffer->gpu_dirty = 0;
-  // }
-  glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
-  const void *indirect_offset =
-      (const void *)((unsigned char *)NULL + byte_offset);
-  if (self->index_type) {
-    // Indexed Draw
-    glMultiDrawElementsIndirect(self->topology, self->index_type,
-                                indirect_offset, draw_count, stride);
-  } else {
-    // Array Draw
-    glMultiDrawArraysIndirect(self->topology, indirect_offset, draw_count,
-                              stride);
+  void *sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  if (!sync) {
+    glFinish();
+    return;
   }
+  int status;
+  do {
+    Py_BEGIN_ALLOW_THREADS
+    status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    Py_END_ALLOW_THREADS
+  } while (status == GL_TIMEOUT_EXPIRED);
+  glDeleteSync(sync);
+}
 
-  PyMutex_Unlock(&self->ctx->state_lock);
-  Py_RETURN_NONE;
+static void render_op_release(RenderOp *op) {
+  Py_XDECREF(op->args);
+  Py_XDECREF(op->kwargs);
+  op->args = NULL;
+  op->kwargs = NULL;
 }
 
-static PyObject *Pipeline_get_viewport(const Pipeline *self, void *closure) {
-  return Py_BuildValue("(iiii)", self->viewport.x, self->viewport.y,
-                       self->viewport.width, self->viewport.height);
+// Keep the first error, the producer raises it on its next call
+static void render_thread_store_error(RenderRing *ring) {
+  PyObject *exc = PyErr_GetRaisedException();
+  if (Atomic_CompareExchangePtr(&ring->error, NULL, exc) != NULL) {
+    Py_XDECREF(exc);
+  }
 }
 
-static int Pipeline_set_viewport(Pipeline *self, PyObject *viewport,
-                                 void *closure) {
-  if (!to_viewport(&self->viewport, viewport, 0, 0, 0, 0)) {
-    PyErr_Format(PyExc_TypeError,
-                 "[HyperGL] the viewport must be a tuple of 4 ints");
+static int render_thread_raise(RenderRing *ring) {
+  PyObject *exc = Atomic_ExchangePtr(&ring->error, NULL);
+  if (exc) {
+    PyErr_SetRaisedException(exc);
     return -1;
   }
   return 0;
 }
 
-// -----------------------------------------------------------------------------
-// Type: Compute
-// -----------------------------------------------------------------------------
+// Producer side, steals the references. Blocks while the ring is full.
+static void render_ring_push(RenderRing *ring, int op, PyObject *args,
+                             PyObject *kwargs) {
+  long long head = ring->head;
+  while (head - Atomic_Load64(&ring->tail) >= RENDER_RING_CAPACITY) {
+    wait_event_wait(&ring->event, &ring->tail, head - RENDER_RING_CAPACITY,
+                    -1.0);
+  }
+  ring->ops[head & (RENDER_RING_CAPACITY - 1)] = (RenderOp){op, args, kwargs};
+  wait_event_store(&ring->event, &ring->head, head + 1);
+}
 
-static PyObject *Compute_meth_run(Compute *self, PyObject *args) {
-  int x = 1;
-  int y = 1;
-  int z = 1;
-  if (!PyArg_ParseTuple(args, "|iii", &x, &y, &z)) {
+static PyObject *render_thread_forward(Context *self, int op, PyObject *args,
+                                       PyObject *kwargs) {
+  RenderRing *ring = self->render_ring;
+  if (ring->producer_id != PyThread_get_thread_ident()) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] only the thread that started the render thread "
+                 "can submit to it");
     return NULL;
   }
-
-  VALIDATE(x > 0 && y > 0 && z > 0, PyExc_ValueError,
-           "[HyperGL] Dispatch dimensions must be positive");
-
-  if (self->ctx->is_lost) {
-    PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
+  if (render_thread_raise(ring) < 0) {
     return NULL;
   }
-
-  PyMutex_Lock(&self->ctx->state_lock);
-
-  bind_program_internal(self->ctx, self->program->obj);
-
-  bind_descriptor_set(self->ctx, self->descriptor_set);
-
-  if (self->uniforms) {
-    bind_uniforms((Pipeline *)self);
+  PyObject *call_kwargs = kwargs ? PyDict_Copy(kwargs) : NULL;
+  if (kwargs && !call_kwargs) {
+    return NULL;
   }
-  glDispatchCompute(x, y, z);
-  glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT |
-                  GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
-  // glMemoryBarrier(GL_ALL_BARRIER_BITS); // sanity check
-  PyMutex_Unlock(&self->ctx->state_lock);
-
+  render_ring_push(ring, op, new_ref(args), call_kwargs);
   Py_RETURN_NONE;
 }
 
-static Compute *Context_meth_compute(Context *self, PyObject *args,
-                                     PyObject *kwargs) {
-  static char *keywords[] = {"compute_shader", "resources", "uniforms",
-                             "uniform_data", NULL};
-
-  PyObject *compute_shader = NULL;
-  PyObject *resources = self->module_state->empty_tuple;
-  PyObject *uniforms_arg = Py_None;
-  PyObject *uniform_data = Py_None;
-  PyObject *shader_bytes = NULL;
-  GLObject *program = NULL;
-  PyObject *uniforms_proxy = NULL;
-  PyObject *uniform_layout = NULL;
-  PyObject *uniform_data_blob = NULL;
-  PyObject *resource_bindings = NULL;
-  DescriptorSet *descriptor_set = NULL;
-  Compute *res = NULL;
-  PyObject *tuple = NULL;
-
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OOO", keywords,
-                                   &compute_shader, &resources, &uniforms_arg,
-                                   &uniform_data)) {
+// Runs `self.name(*args, **kwargs)` on the render thread. With `wait` the
+// caller blocks until it has run and gets its result or exception back,
+// without it the call is queued like a frame op and errors surface later.
+static PyObject *render_thread_call(Context *ctx, PyObject *self,
+                                    const char *name, PyObject *args,
+                                    PyObject *kwargs, int wait) {
+  PyObject *method = PyObject_GetAttrString(self, name);
+  PyObject *call_args = args ? new_ref(args) : PyTuple_New(0);
+  if (!method || !call_args) {
+    Py_XDECREF(method);
+    Py_XDECREF(call_args);
     return NULL;
   }
 
-  // --- Shader Processing ---
-  if (PyUnicode_Check(compute_shader)) {
-    shader_bytes = PyUnicode_AsUTF8String(compute_shader);
-    if (!shader_bytes) {
-      goto fail;
+  if (!wait) {
+    PyObject *call =
+        Py_BuildValue("(NNOO)", method, call_args, Py_None, Py_None);
+    if (!call) {
+      return NULL;
     }
-  } else if (PyBytes_Check(compute_shader)) {
-    shader_bytes = compute_shader;
-    Py_INCREF(shader_bytes);
-  } else {
-    PyErr_Format(PyExc_TypeError,
-                 "[HyperGL] compute_shader must be str or bytes");
-    goto fail;
+    PyObject *status = render_thread_forward(ctx, RENDER_OP_CALL, call, kwargs);
+    Py_DECREF(call);
+    return status;
   }
 
-  program = compile_compute_program(self, NULL, shader_bytes);
-  Py_CLEAR(shader_bytes);
-  if (!program) {
-    goto fail;
+  Fence *done = PyObject_New(Fence, ctx->module_state->Fence_type);
+  if (!done) {
+    Py_DECREF(method);
+    Py_DECREF(call_args);
+    return NULL;
   }
+  done->signaled = 0;
+  done->sync = NULL;
+  done->trash = NULL;
+  wait_event_init(&done->event);
 
-  // --- Uniforms Processing ---
-  if (uniforms_arg != Py_None) {
-    tuple = PyObject_CallMethod(self->module_state->helper, "uniforms", "(OOO)",
-                                program->extra, uniforms_arg, uniform_data);
+  PyObject *slot = Py_BuildValue("[OO]", Py_None, Py_None); // [result, exc]
+  PyObject *call =
+      slot ? Py_BuildValue("(NNOO)", method, call_args, done, slot) : NULL;
+  if (!slot) {
+    Py_DECREF(method);
+    Py_DECREF(call_args);
+  }
+  PyObject *status =
+      call ? render_thread_forward(ctx, RENDER_OP_CALL, call, kwargs) : NULL;
+  Py_XDECREF(call);
+  if (!status) {
+    Py_DECREF(done);
+    Py_XDECREF(slot);
+    return NULL;
+  }
+  Py_DECREF(status);
 
-    if (!tuple) {
-      goto fail;
-    }
+  wait_event_wait(&done->event, &done->signaled, 0, -1.0);
+  Py_DECREF(done);
 
-    PyObject *uniform_dict = PyTuple_GetItem(tuple, 0);
-    if (!uniform_dict || !PyDict_Check(uniform_dict)) {
-      PyErr_Format(PyExc_RuntimeError,
-                   "[HyperGL] uniforms helper returned invalid layout");
-      goto fail;
-    }
+  PyObject *exc = PyList_GetItemRef(slot, 1);
+  PyObject *res = NULL;
+  if (exc != Py_None) {
+    PyErr_SetRaisedException(exc);
+  } else {
+    Py_DECREF(exc);
+    res = PyList_GetItemRef(slot, 0);
+  }
+  Py_DECREF(slot);
+  return res;
+}
 
-    uniforms_proxy = PyDictProxy_New(uniform_dict);
-    if (!uniforms_proxy) {
-      goto fail;
+// Render thread side of render_thread_call(). A waited call hands its result
+// or exception back through the slot, others store errors like frame ops.
+static int render_thread_run_call(PyObject *call, PyObject *kwargs) {
+  PyObject *res = PyObject_Call(PyTuple_GET_ITEM(call, 0),
+                                PyTuple_GET_ITEM(call, 1), kwargs);
+  PyObject *done = PyTuple_GET_ITEM(call, 2);
+  if (done == Py_None) {
+    if (!res) {
+      return -1;
     }
-
-    uniform_layout = PyTuple_GetItem(tuple, 1);
-    Py_XINCREF(uniform_layout);
-
-    uniform_data_blob = PyTuple_GetItem(tuple, 2);
-    Py_XINCREF(uniform_data_blob);
-
-    Py_CLEAR(tuple);
+    Py_DECREF(res);
+    return 0;
   }
 
-  // --- Resource Processing ---
-  resource_bindings = PyObject_CallMethod(
-      self->module_state->helper, "resource_bindings", "(O)", resources);
-  if (!resource_bindings) {
-    goto fail;
+  PyObject *slot = PyTuple_GET_ITEM(call, 3);
+  if (res) {
+    PyList_SetItem(slot, 0, res);
+  } else {
+    PyList_SetItem(slot, 1, PyErr_GetRaisedException());
   }
+  // The op still holds the fence, so the waiter cannot free it meanwhile
+  wait_event_store(&((Fence *)done)->event, &((Fence *)done)->signaled, 1);
+  return 0;
+}
 
-  descriptor_set = build_descriptor_set(self, resource_bindings);
-  Py_CLEAR(resource_bindings);
-  if (!descriptor_set) {
-    goto fail;
-  }
+static void render_thread_main(void *arg) {
+  Context *self = (Context *)arg; // strong reference owned by this thread
+  RenderRing *ring = self->render_ring;
 
-  // --- Object Creation ---
-  res = PyObject_New(Compute, self->module_state->Compute_type);
-  if (!res) {
-    goto fail;
+  PyGILState_STATE gstate = PyGILState_Ensure();
+  ring->thread_id = PyThread_get_thread_ident();
+
+  if (ring->make_current != Py_None) {
+    PyObject *res = PyObject_CallNoArgs(ring->make_current);
+    if (!res) {
+      render_thread_store_error(ring);
+      Py_DECREF(self);
+      wait_event_store(&ring->event, &ring->state, -1);
+      PyGILState_Release(gstate);
+      return;
+    }
+    Py_DECREF(res);
   }
+  self->thread_id = ring->thread_id;
+  wait_event_store(&ring->event, &ring->state, 1);
 
-  res->ctx = self;
-  Py_INCREF(self);
-  res->program = program; program = NULL;
-  res->descriptor_set = descriptor_set; descriptor_set = NULL;
-  res->uniforms = uniforms_proxy; uniforms_proxy = NULL;
-  res->uniform_layout = uniform_layout; uniform_layout = NULL;
-  res->uniform_data = uniform_data_blob; uniform_data_blob = NULL;
-  res->workgroup_size = NULL;
-  res->create_kwargs = NULL;
-  res->global_settings = NULL;
-  res->framebuffer = NULL;
-  res->vertex_array = NULL;
-  res->viewport_data = NULL;
-  res->render_data = NULL;
-  res->topology = 0;
-  res->index_type = 0;
-  res->index_size = 0;
+  int running = 1;
+  while (running) {
+    long long tail = ring->tail;
+    if (tail == Atomic_Load64(&ring->head)) {
+      wait_event_wait(&ring->event, &ring->head, tail, -1.0);
+      continue;
+    }
 
-  zeromem(&res->uniform_layout_buffer, sizeof(Py_buffer));
-  zeromem(&res->uniform_data_buffer, sizeof(Py_buffer));
-  zeromem(&res->viewport_data_buffer, sizeof(Py_buffer));
-  zeromem(&res->render_data_buffer, sizeof(Py_buffer));
-  zeromem(&res->params, sizeof(RenderParameters));
-  zeromem(&res->viewport, sizeof(Viewport));
+    RenderOp op = ring->ops[tail & (RENDER_RING_CAPACITY - 1)];
+    wait_event_store(&ring->event, &ring->tail, tail + 1);
 
-  // --- Buffer Acquisition ---
-  if (res->uniforms) {
-    if (PyObject_GetBuffer(res->uniform_layout, &res->uniform_layout_buffer,
-                           PyBUF_SIMPLE)) {
-      goto fail;
+    PyObject *res = Py_None;
+    switch (op.op) {
+    case RENDER_OP_NEW_FRAME:
+      res = Context_meth_new_frame(self, op.args, op.kwargs);
+      Py_XDECREF(res);
+      break;
+    case RENDER_OP_END_FRAME:
+      res = Context_meth_end_frame(self, op.args, op.kwargs);
+      Py_XDECREF(res);
+      break;
+    case RENDER_OP_FENCE:
+      render_thread_finish();
+      wait_event_store(&((Fence *)op.args)->event,
+                       &((Fence *)op.args)->signaled, 1);
+      break;
+    case RENDER_OP_CALL:
+      res = render_thread_run_call(op.args, op.kwargs) < 0 ? NULL : Py_None;
+      break;
+    case RENDER_OP_STOP:
+      running = 0;
+      break;
     }
-    if (PyObject_GetBuffer(res->uniform_data, &res->uniform_data_buffer,
-                           PyBUF_SIMPLE)) {
-      goto fail;
+    if (!res) {
+      render_thread_store_error(ring);
     }
+    render_op_release(&op);
   }
 
-  return res;
-
-fail:
-  Py_XDECREF(shader_bytes);
-  Py_XDECREF(uniforms_proxy);
-  Py_XDECREF(uniform_layout);
-  Py_XDECREF(uniform_data_blob);
-  Py_XDECREF(tuple);
-  Py_XDECREF(resource_bindings);
-  Py_XDECREF(descriptor_set);
-  if (res) {
-    Py_DECREF(res);
+  if (ring->release_current != Py_None) {
+    PyObject *res = PyObject_CallNoArgs(ring->release_current);
+    if (!res) {
+      render_thread_store_error(ring);
+    }
+    Py_XDECREF(res);
   }
 
-  return NULL;
+  Py_DECREF(self);
+  // Last access to the ring, the producer frees it after seeing -1
+  wait_event_store(&ring->event, &ring->state, -1);
+  PyGILState_Release(gstate);
 }
 
-// -----------------------------------------------------------------------------
-// Other Methods: Context Pack/NewFrame, Inspection, Helpers
-// -----------------------------------------------------------------------------
+static PyObject *Context_meth_start_render_thread(Context *self,
+                                                  PyObject *args,
+                                                  PyObject *kwargs) {
+  static char *keywords[] = {"make_current", "release_current", NULL};
+  PyObject *make_current = Py_None;
+  PyObject *release_current = Py_None;
 
-static PyObject *Context_meth_pack_indirect(Context *self, PyObject *args,
-                                            PyObject *kwargs) {
-  static char *keywords[] = {"commands", "indexed", NULL};
-  PyObject *commands;
-  int indexed = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO", keywords,
+                                   &make_current, &release_current)) {
+    return NULL;
+  }
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|p", keywords, &commands,
-                                   &indexed)) {
+  if (self->render_ring) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] the render thread is already running");
     return NULL;
   }
 
-  // OPTIMIZATION: Convert outer sequence to a fast array
-  PyObject *fast_commands =
-      PySequence_Fast(commands, "[HyperGL] commands must be a sequence");
-  if (!fast_commands) {
+  if ((make_current != Py_None && !PyCallable_Check(make_current)) ||
+      (release_current != Py_None && !PyCallable_Check(release_current))) {
+    PyErr_Format(PyExc_TypeError,
+                 "[HyperGL] make_current and release_current must be callable");
     return NULL;
   }
 
-  Py_ssize_t count = PySequence_Fast_GET_SIZE(fast_commands);
-  if (count == 0) {
-    Py_DECREF(fast_commands);
-    return PyBytes_FromStringAndSize("", 0);
+  RenderRing *ring = PyMem_RawCalloc(1, sizeof(RenderRing));
+  if (!ring) {
+    return PyErr_NoMemory();
   }
+  wait_event_init(&ring->event);
+  ring->producer_id = PyThread_get_thread_ident();
+  ring->make_current = make_current;
+  ring->release_current = new_ref(release_current);
 
-  // Determine sizes
-  const Py_ssize_t stride = indexed ? 20 : 16;
-  const Py_ssize_t total_size = count * stride;
+  // Drain our own work first, the render thread owns GL from now on
+  if (run_encoders(self) < 0) {
+    Py_DECREF(ring->release_current);
+    render_ring_free(ring);
+    return NULL;
+  }
 
-  PyObject *result = PyBytes_FromStringAndSize(NULL, total_size);
-  if (!result) {
-    Py_DECREF(fast_commands);
+  self->render_ring = ring;
+  Py_INCREF(self);
+  if (PyThread_start_new_thread(render_thread_main, self) ==
+      PYTHREAD_INVALID_THREAD_ID) {
+    self->render_ring = NULL;
+    Py_DECREF(self);
+    Py_DECREF(ring->release_current);
+    render_ring_free(ring);
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] cannot start the render thread");
     return NULL;
   }
 
-  unsigned char *base_ptr = (unsigned char *)PyBytes_AsString(result);
-  // Zero out memory so padding bytes (if any) or implicit zeros are clean
-  memset(base_ptr, 0, total_size);
+  wait_event_wait(&ring->event, &ring->state, 0, -1.0);
 
-  PyObject **items = PySequence_Fast_ITEMS(fast_commands);
-  int error_occurred = 0;
+  ring->make_current = NULL;
+  if (Atomic_Load64(&ring->state) < 0) {
+    self->render_ring = NULL;
+    self->thread_id = ring->producer_id;
+    render_thread_raise(ring);
+    Py_DECREF(ring->release_current);
+    render_ring_free(ring);
+    return NULL;
+  }
 
-  for (Py_ssize_t i = 0; i < count; i++) {
-    // OPTIMIZATION: Direct pointer access (borrowed ref)
-    PyObject *cmd = items[i];
+  Py_RETURN_NONE;
+}
 
-    // OPTIMIZATION: Convert inner sequence to fast array
-    PyObject *fast_cmd =
-        PySequence_Fast(cmd, "[HyperGL] Command is not a sequence");
-    if (!fast_cmd) {
-      error_occurred = 1;
-      break;
-    }
+// Drains the ring, joins the render thread and hands GL back to the caller.
+// The caller has to make the GL context current again (see release_current).
+static PyObject *Context_meth_stop_render_thread(Context *self,
+                                                 PyObject *args) {
+  RenderRing *ring = self->render_ring;
+  if (!ring) {
+    Py_RETURN_NONE;
+  }
+  if (ring->producer_id != PyThread_get_thread_ident()) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "[HyperGL] only the thread that started the render thread "
+                 "can stop it");
+    return NULL;
+  }
 
-    Py_ssize_t inputs = PySequence_Fast_GET_SIZE(fast_cmd);
-    PyObject **cmd_items = PySequence_Fast_ITEMS(fast_cmd);
+  render_ring_push(ring, RENDER_OP_STOP, NULL, NULL);
+  long long state;
+  while ((state = Atomic_Load64(&ring->state)) != -1) {
+    wait_event_wait(&ring->event, &ring->state, state, -1.0);
+  }
 
-    unsigned char *current_struct_ptr = base_ptr + (i * stride);
+  self->render_ring = NULL;
+  self->thread_id = PyThread_get_thread_ident();
+  int status = render_thread_raise(ring);
+  Py_DECREF(ring->release_current);
+  render_ring_free(ring);
 
-    if (indexed) {
-      // --- INDEXED PATH ---
-      if (inputs != 4 && inputs != 5) {
-        PyErr_Format(PyExc_ValueError,
-                     "[HyperGL] Indexed command %zd must have 4 or 5 values",
-                     i);
-        Py_DECREF(fast_cmd);
-        error_occurred = 1;
-        break;
-      }
+  if (status < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
 
-      struct DrawElementsIndirectCommand {
-        uint32_t count;
-        uint32_t instanceCount;
-        uint32_t firstIndex;
-        int32_t baseVertex;
-        uint32_t baseInstance;
-      } *out = (void *)current_struct_ptr;
+// Called on a background loader thread once a context sharing objects with
+// this one is current there. Buffers and images created on that thread are
+// uploaded through it, ctx.fence() then tells the render thread when.
+static PyObject *Context_meth_attach_upload_thread(Context *self,
+                                                   PyObject *args) {
+  unsigned long ident = PyThread_get_thread_ident();
 
-      // 1. count
-      unsigned long long val = PyLong_AsUnsignedLongLong(cmd_items[0]);
-      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-        goto index_error;
-      }
-      if (val > UINT32_MAX) {
-        goto range_error;
-      }
-      out->count = (uint32_t)val;
+  if (!glFenceSync || !glClientWaitSync || !glDeleteSync) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] sync objects are not supported");
+    return NULL;
+  }
+  if (ident == self->thread_id ||
+      (self->render_ring && ident == self->render_ring->thread_id)) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] the upload thread cannot be the render thread");
+    return NULL;
+  }
+  long long prev = Atomic_CompareExchange64(&self->upload_thread_id, 0LL,
+                                            (long long)ident);
+  if (prev && prev != (long long)ident) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] another upload thread is already attached");
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
 
-      // 2. instanceCount
-      val = PyLong_AsUnsignedLongLong(cmd_items[1]);
-      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-        goto index_error;
-      }
-      if (val > UINT32_MAX) {
-        goto range_error;
-      }
-      out->instanceCount = (uint32_t)val;
+static PyObject *Context_meth_detach_upload_thread(Context *self,
+                                                   PyObject *args) {
+  if (Atomic_Load64(&self->upload_thread_id) !=
+      (long long)PyThread_get_thread_ident()) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] detach_upload_thread() must be called from "
+                    "the upload thread");
+    return NULL;
+  }
 
-      // 3. firstIndex
-      val = PyLong_AsUnsignedLongLong(cmd_items[2]);
-      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-        goto index_error;
-      }
-      if (val > UINT32_MAX) {
-        goto range_error;
-      }
-      out->firstIndex = (uint32_t)val;
+  // Submit what is left before the context goes away
+  glFlush();
+  Atomic_Store64(&self->upload_thread_id, 0LL);
+  Py_RETURN_NONE;
+}
 
-      if (inputs == 5) {
-        // 4. baseVertex (Signed)
-        const long long sval = PyLong_AsLongLong(cmd_items[3]);
-        if (sval == -1 && PyErr_Occurred()) {
-          goto index_error;
-        }
-        if (sval < INT32_MIN || sval > INT32_MAX) {
-          goto range_error;
-        }
-        out->baseVertex = (int32_t)sval;
+// A marker in the submission stream. Signaled once everything submitted
+// before it (including deferred reads) has been executed by the GPU. On the
+// upload thread and in synchronous mode it is a GL sync object, with the render
+// thread running that thread waits for the GPU before signaling it.
+static Fence *Context_meth_fence(Context *self, PyObject *args) {
+  Fence *res = PyObject_New(Fence, self->module_state->Fence_type);
+  if (!res) {
+    return NULL;
+  }
+  res->signaled = 0;
+  res->sync = NULL;
+  res->trash = NULL;
+  wait_event_init(&res->event);
 
-        // 5. baseInstance
-        val = PyLong_AsUnsignedLongLong(cmd_items[4]);
-        if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-          goto index_error;
-        }
-        if (val > UINT32_MAX) {
-          goto range_error;
-        }
-        out->baseInstance = (uint32_t)val;
-      } else {
-        // inputs == 4
-        // baseVertex is implicitly 0
-        out->baseVertex = 0;
+  const int synchronous =
+      !self->render_ring ||
+      self->render_ring->thread_id == PyThread_get_thread_ident();
 
-        // 4. baseInstance (taken from item index 3)
-        val = PyLong_AsUnsignedLongLong(cmd_items[3]);
-        if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-          goto index_error;
-        }
-        if (val > UINT32_MAX) {
-          goto range_error;
-        }
-        out->baseInstance = (uint32_t)val;
-      }
+  if (on_upload_thread(self) || (synchronous && glFenceSync)) {
+    res->sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!res->sync) {
+      Py_DECREF(res);
+      PyErr_SetString(PyExc_RuntimeError, "[HyperGL] cannot create a fence");
+      return NULL;
+    }
+    // The waiting context only sees the sync once it has been submitted
+    glFlush();
+    res->trash = self->trash_shared;
+    if (res->trash) {
+      Atomic_Increment(&res->trash->ref_count);
+    }
+    return res;
+  }
 
-    } else {
-      // --- ARRAY PATH ---
-      if (inputs != 4) {
-        PyErr_Format(
-            PyExc_ValueError,
-            "[HyperGL] Non-indexed command %zd must have exactly 4 values", i);
-        Py_DECREF(fast_cmd);
-        error_occurred = 1;
-        break;
-      }
+  if (synchronous) {
+    // No sync objects, glFinish() is the only way to wait for the GPU
+    glFinish();
+    res->signaled = 1;
+    return res;
+  }
 
-      struct DrawArraysIndirectCommand {
-        uint32_t count;
-        uint32_t instanceCount;
-        uint32_t first;
-        uint32_t baseInstance;
-      } *out = (void *)current_struct_ptr;
+  PyObject *status = render_thread_forward(self, RENDER_OP_FENCE,
+                                           (PyObject *)res, NULL);
+  if (!status) {
+    Py_DECREF(res);
+    return NULL;
+  }
+  Py_DECREF(status);
+  return res;
+}
 
-      // 1. count
-      unsigned long long val = PyLong_AsUnsignedLongLong(cmd_items[0]);
-      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-        goto array_error;
-      }
-      if (val > UINT32_MAX) {
-        goto range_error;
-      }
-      out->count = (uint32_t)val;
+// Needs a context of the share group current on the calling thread. A negative
+// timeout waits forever. Returns 1 once signaled, 0 on timeout, -1 on error.
+static int fence_wait_sync(Fence *self, double timeout) {
+  void *sync = Atomic_LoadPtr(&self->sync);
+  if (!sync) {
+    return Atomic_Load64(&self->signaled) != 0;
+  }
 
-      // 2. instanceCount
-      val = PyLong_AsUnsignedLongLong(cmd_items[1]);
-      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-        goto array_error;
-      }
-      if (val > UINT32_MAX) {
-        goto range_error;
-      }
-      out->instanceCount = (uint32_t)val;
+  GLuint64 wait_ns = timeout >= 0.0 ? (GLuint64)(timeout * 1e9) : 1000000000;
+  int status;
+  do {
+    Py_BEGIN_ALLOW_THREADS
+    status = glClientWaitSync(sync, 0, wait_ns);
+    Py_END_ALLOW_THREADS
+  } while (status == GL_TIMEOUT_EXPIRED && timeout < 0.0);
 
-      // 3. first
-      val = PyLong_AsUnsignedLongLong(cmd_items[2]);
-      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-        goto array_error;
-      }
-      if (val > UINT32_MAX) {
-        goto range_error;
-      }
-      out->first = (uint32_t)val;
+  if (status == GL_WAIT_FAILED) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "[HyperGL] waiting on the fence failed, is a context of "
+                    "the share group current on this thread?");
+    return -1;
+  }
+  if (status == GL_TIMEOUT_EXPIRED) {
+    return 0;
+  }
 
-      // 4. baseInstance
-      val = PyLong_AsUnsignedLongLong(cmd_items[3]);
-      if (val == (unsigned long long)-1 && PyErr_Occurred()) {
-        goto array_error;
-      }
-      if (val > UINT32_MAX) {
-        goto range_error;
-      }
-      out->baseInstance = (uint32_t)val;
-    }
+  // Whoever clears the pointer deletes the sync
+  if (Atomic_CompareExchangePtr(&self->sync, sync, NULL) == sync) {
+    glDeleteSync(sync);
+  }
+  wait_event_store(&self->event, &self->signaled, 1);
+  return 1;
+}
 
-    Py_DECREF(fast_cmd);
-    continue;
+static PyObject *Fence_meth_wait(Fence *self, PyObject *args,
+                                 PyObject *kwargs) {
+  static char *keywords[] = {"timeout", NULL};
+  double timeout = -1.0;
 
-  // Error handling block
-  index_error:
-  array_error:
-    error_occurred = 1;
-    Py_DECREF(fast_cmd);
-    break;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|d", keywords, &timeout)) {
+    return NULL;
+  }
 
-  range_error:
-    PyErr_SetString(PyExc_ValueError,
-                    "[HyperGL] Value out of range for indirect buffer");
-    error_occurred = 1;
-    Py_DECREF(fast_cmd);
-    break;
+  if (Atomic_LoadPtr(&self->sync)) {
+    int status = fence_wait_sync(self, timeout);
+    if (status < 0) {
+      return NULL;
+    }
+    return PyBool_FromLong(status);
   }
 
-  Py_DECREF(fast_commands);
+  return PyBool_FromLong(
+      wait_event_wait(&self->event, &self->signaled, 0, timeout));
+}
 
-  if (error_occurred) {
-    Py_DECREF(result);
-    return NULL;
+static PyObject *Fence_get_signaled(Fence *self, void *closure) {
+  if (!Atomic_Load64(&self->signaled) && Atomic_LoadPtr(&self->sync)) {
+    int status = fence_wait_sync(self, 0.0);
+    if (status < 0) {
+      return NULL;
+    }
+    return PyBool_FromLong(status);
   }
-
-  return result;
+  return PyBool_FromLong(Atomic_Load64(&self->signaled) != 0);
 }
 
 static PyObject *Context_meth_new_frame(Context *self, PyObject *args,
@@ -5897,6 +11234,11 @@ static PyObject *Context_meth_new_frame(Context *self, PyObject *args,
   int reset = 1;
   int clear = 1;
 
+  if (self->render_ring &&
+      self->render_ring->thread_id != PyThread_get_thread_ident()) {
+    return render_thread_forward(self, RENDER_OP_NEW_FRAME, args, kwargs);
+  }
+
   // Fast path: if no arguments are provided, skip expensive parsing
   if (PyTuple_GET_SIZE(args) > 0 || (kwargs && PyDict_Size(kwargs) > 0)) {
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|pp", keywords, &reset,
@@ -5911,7 +11253,7 @@ static PyObject *Context_meth_new_frame(Context *self, PyObject *args,
   }
 
   // Process deletion queue
-  flush_trash(self);
+  flush_trash(self, TRASH_FLUSH_BUDGET);
 
   // Holders for objects to be decremented OUTSIDE the lock
   PyObject *trash_desc = NULL;
@@ -5985,6 +11327,11 @@ static PyObject *Context_meth_new_frame(Context *self, PyObject *args,
   Py_XDECREF(trash_desc);
   // Py_XDECREF((PyObject *)trash_settings);
 
+  // Work recorded by other threads lands on top of the cleared frame
+  if (run_encoders(self) < 0) {
+    return NULL;
+  }
+
   Py_RETURN_NONE;
 }
 
@@ -5994,6 +11341,11 @@ static PyObject *Context_meth_end_frame(Context *self, PyObject *args,
   int clean = 1;
   int flush = 1;
 
+  if (self->render_ring &&
+      self->render_ring->thread_id != PyThread_get_thread_ident()) {
+    return render_thread_forward(self, RENDER_OP_END_FRAME, args, kwargs);
+  }
+
   if (PyTuple_GET_SIZE(args) > 0 || (kwargs && PyDict_Size(kwargs) > 0)) {
     if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|pp", keywords, &clean,
                                      &flush)) {
@@ -6006,7 +11358,12 @@ static PyObject *Context_meth_end_frame(Context *self, PyObject *args,
     return NULL;
   }
 
-  flush_trash(self);
+  // Submitted encoders run before the frame is cleaned up and flushed
+  if (run_encoders(self) < 0) {
+    return NULL;
+  }
+
+  flush_trash(self, TRASH_FLUSH_BUDGET);
 
   PyObject *trash_desc = NULL;
   GlobalSettings *trash_settings = NULL;
@@ -6080,6 +11437,23 @@ static PyObject *Context_meth_end_frame(Context *self, PyObject *args,
 }
 
 static PyObject *Context_meth_release(Context *self, PyObject *arg) {
+  if (off_render_thread(self)) {
+    PyObject *call_args = PyTuple_Pack(1, arg);
+    PyObject *res =
+        call_args ? render_thread_call(self, (PyObject *)self, "release",
+                                       call_args, NULL, 1)
+                  : NULL;
+    Py_XDECREF(call_args);
+    // Releasing everything also joins the render thread, it holds a reference
+    // to the context and would keep it alive otherwise
+    if (res && PyUnicode_CheckExact(arg) &&
+        !PyUnicode_CompareWithASCIIString(arg, "all")) {
+      Py_DECREF(res);
+      return Context_meth_stop_render_thread(self, NULL);
+    }
+    return res;
+  }
+
   if (self->thread_id != PyThread_get_thread_ident()) {
       PyErr_SetString(PyExc_RuntimeError, 
           "[HyperGL] Context.release() must be called from the same thread that created the Context.");
@@ -6091,6 +11465,13 @@ static PyObject *Context_meth_release(Context *self, PyObject *arg) {
 
   if (Py_TYPE(arg) == self->module_state->Buffer_type) {
     Buffer *buffer = (Buffer *)arg;
+    // Arrays and DLPack tensors made from the mapping hold the memoryview
+    if (buffer->memoryview && Py_REFCNT(buffer->memoryview) > 1) {
+      PyErr_SetString(PyExc_BufferError,
+                      "[HyperGL] Cannot release; an array or tensor still "
+                      "holds the mapping");
+      return NULL;
+    }
     Py_XDECREF(buffer->memoryview);
     buffer->memoryview = NULL;
 
@@ -6104,6 +11485,9 @@ static PyObject *Context_meth_release(Context *self, PyObject *arg) {
     if (image->faces) {
       PyDict_Clear(image->faces);
     }
+    if (image->transforms) {
+      PyDict_Clear(image->transforms);
+    }
 
     if (!self->is_lost && image->image) {
       int type = image->renderbuffer ? TRASH_RENDERBUFFER : TRASH_TEXTURE;
@@ -6148,8 +11532,12 @@ static PyObject *Context_meth_release(Context *self, PyObject *arg) {
       }
     }
     PyDict_Clear(self->shader_cache);
+  } else if (PyUnicode_CheckExact(arg) &&
+             !PyUnicode_CompareWithASCIIString(arg, "resolve_pool")) {
+    PyDict_Clear(self->resolve_pool);
   } else if (PyUnicode_CheckExact(arg) &&
              !PyUnicode_CompareWithASCIIString(arg, "all")) {
+    PyDict_Clear(self->resolve_pool);
     PyGC_Collect();
   }
   Py_RETURN_NONE;
@@ -6169,7 +11557,24 @@ static int Context_set_screen(const Context *self, PyObject *value,
   return 0;
 }
 
+// The driver values are fixed, leaked_objects is refreshed on every read
+static PyObject *Context_get_info(const Context *self, void *closure) {
+  const long leaked =
+      self->trash_shared ? Atomic_Load(&self->trash_shared->leaked) : 0;
+  PyObject *value = PyLong_FromLong(leaked);
+  if (!value ||
+      PyDict_SetItemString(self->info_dict, "leaked_objects", value) < 0) {
+    Py_XDECREF(value);
+    return NULL;
+  }
+  Py_DECREF(value);
+  return new_ref(self->info_dict);
+}
+
 static PyObject *Context_get_loader(const Context *self, void *closure) {
+  if (self->loader) {
+    return new_ref(self->loader);
+  }
   return new_ref(self->module_state->default_loader);
 }
 
@@ -6181,7 +11586,7 @@ static PyObject *inspect_descriptor_set(const DescriptorSet *set) {
     const Buffer *buf = set->uniform_buffers.binding[i].buffer;
     if (buf) {
       PyObject *obj = Py_BuildValue(
-          "{sssisisisi}", "type", "uniform_buffer", "binding", i, "buffer_id",
+          "{sssisisnsn}", "type", "uniform_buffer", "binding", i, "buffer_id",
           buf->buffer, "offset", set->uniform_buffers.binding[i].offset, "size",
           set->uniform_buffers.binding[i].size);
       if (PyList_Append(res, obj) < 0) {
@@ -6198,7 +11603,7 @@ static PyObject *inspect_descriptor_set(const DescriptorSet *set) {
     Buffer *buf = set->storage_buffers.binding[i].buffer;
     if (buf) {
       PyObject *obj = Py_BuildValue(
-          "{sssisisisi}", "type", "storage_buffer", "binding", i, "buffer_id",
+          "{sssisisnsn}", "type", "storage_buffer", "binding", i, "buffer_id",
           buf->buffer, "offset", set->storage_buffers.binding[i].offset, "size",
           set->storage_buffers.binding[i].size);
       if (PyList_Append(res, obj) < 0) {
@@ -6317,6 +11722,11 @@ static PyObject *meth_inspect(PyObject *self, PyObject *arg) {
 }
 
 static PyObject *ImageFace_meth_clear(const ImageFace *self, PyObject *args) {
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "clear",
+                              args, NULL, 0);
+  }
+
   if (self->ctx->is_lost) {
     PyErr_Format(PyExc_RuntimeError, "[HyperGL] the context is lost");
     return NULL;
@@ -6349,6 +11759,11 @@ static PyObject *ImageFace_meth_read(ImageFace *self, PyObject *args,
   PyObject *offset_arg = Py_None;
   PyObject *into = Py_None;
 
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "read",
+                              args, kwargs, 1);
+  }
+
   if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OOO", keywords, &size_arg,
                                    &offset_arg, &into)) {
     return NULL;
@@ -6378,6 +11793,11 @@ static PyObject *ImageFace_meth_blit(const ImageFace *self, PyObject *args,
   PyObject *crop = Py_None;
   int filter = 0;
 
+  if (off_render_thread(self->ctx)) {
+    return render_thread_call(self->ctx, (PyObject *)self, "blit",
+                              args, kwargs, 0);
+  }
+
   if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOOp", keywords, &target,
                                    &offset, &size, &crop, &filter)) {
     return NULL;
@@ -6494,6 +11914,36 @@ static PyObject *meth_camera(PyObject *self, PyObject *args, PyObject *kwargs) {
 // Deallocators
 // -----------------------------------------------------------------------------
 
+// Deleting GL names needs this context current on the thread that owns it.
+// The loader is made current when it has make_current(), which leaves that
+// context current afterwards. A loader without it (DefaultLoader) can only
+// be trusted for the default context while no independent context exists.
+static int context_teardown_current(Context *self) {
+  if (self->thread_id != PyThread_get_thread_ident() || Py_IsFinalizing()) {
+    return 0;
+  }
+
+  PyObject *loader =
+      self->loader ? self->loader : self->module_state->default_loader;
+  PyObject *exc = PyErr_GetRaisedException();
+  PyObject *make_current = NULL;
+  int res = 0;
+  if (loader != Py_None &&
+      PyObject_GetOptionalAttrString(loader, "make_current", &make_current) >
+          0) {
+    PyObject *ret = PyObject_CallNoArgs(make_current);
+    res = ret != NULL;
+    Py_XDECREF(ret);
+    Py_DECREF(make_current);
+  } else {
+    res = !self->loader &&
+          Atomic_Load(&self->module_state->independent_contexts) == 0;
+  }
+  PyErr_Clear();
+  PyErr_SetRaisedException(exc);
+  return res;
+}
+
 static void Context_dealloc(Context *self) {
   // 1. Untrack
   if (PyObject_GC_IsTracked((PyObject *)self)) {
@@ -6507,19 +11957,26 @@ static void Context_dealloc(Context *self) {
   // The context holds one reference to the shared trash struct.
   if (self->trash_shared) {
     SharedTrash *shared = self->trash_shared;
-    // Clean up remaining GL resources if any
-    flush_trash(self);
+    // Clean up remaining GL resources if any, no budget at teardown. When
+    // this context cannot be made current the names are left to the GL
+    // context itself, deleting them elsewhere would hit another namespace.
+    if (self->is_lost || context_teardown_current(self)) {
+      flush_trash(self, 0.0);
+    }
 
     // Decrement ref count; if 0, free the C memory
     if (Atomic_Decrement(&shared->ref_count) == 0) {
-      if (shared->bin) {
-        PyMem_Free(shared->bin);
-      }
-      PyMem_Free(shared);
+      free_shared_trash(shared);
     }
     self->trash_shared = NULL;
   }
 
+  // Last, an independent context's loader may own the GL context itself
+  if (self->loader) {
+    Atomic_Decrement(&self->module_state->independent_contexts);
+  }
+  Py_CLEAR(self->loader);
+
   Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
@@ -6647,6 +12104,51 @@ static void ImageFace_dealloc(ImageFace *self) {
 
 static void BufferView_dealloc(BufferView *self) {
   Py_DECREF(self->buffer);
+  Py_XDECREF(self->heap);
+  PyObject_Del(self);
+}
+
+static void MeshPool_dealloc(MeshPool *self) {
+  PyMem_Free(self->vertices.ranges);
+  PyMem_Free(self->indices.ranges);
+  Py_XDECREF(self->vertex_buffer);
+  Py_XDECREF(self->index_buffer);
+  Py_DECREF(self->ctx);
+  PyObject_Del(self);
+}
+
+static void ImageStream_dealloc(ImageStream *self) {
+  image_stream_release(self);
+  Py_DECREF(self->image);
+  PyObject_Del(self);
+}
+
+static void MappedArray_dealloc(MappedArray *self) {
+  Py_DECREF(self->memoryview);
+  Py_DECREF(self->buffer);
+  PyObject_Del(self);
+}
+
+static void FrameStack_dealloc(FrameStack *self) {
+  Py_DECREF(self->image);
+  Py_DECREF(self->source);
+  Py_DECREF(self->ctx);
+  PyObject_Del(self);
+}
+
+static void Mesh_dealloc(Mesh *self) {
+  Py_XDECREF(self->pool);
+  PyObject_Del(self);
+}
+
+static void Heap_dealloc(Heap *self) {
+  for (int i = 0; i < self->chunk_count; ++i) {
+    Py_DECREF(self->chunks[i].buffer);
+    PyMem_Free(self->chunks[i].longest);
+  }
+  PyMem_Free(self->chunks);
+  Py_XDECREF(self->kind);
+  Py_DECREF(self->ctx);
   PyObject_Del(self);
 }
 
@@ -6680,10 +12182,7 @@ static void GLObject_dealloc(GLObject *self) {
   // Release hold on trash mechanism
   if (self->trash) {
     if (Atomic_Decrement(&self->trash->ref_count) == 0) {
-      if (self->trash->bin) {
-        PyMem_Free(self->trash->bin);
-      }
-      PyMem_Free(self->trash);
+      free_shared_trash(self->trash);
     }
   }
 
@@ -6691,6 +12190,80 @@ static void GLObject_dealloc(GLObject *self) {
   Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
+#ifdef HYPERGL_NATIVE_EGL
+static void HeadlessEGL_dealloc(HeadlessEGL *self) {
+  // At shutdown other objects may still release GL names after the loader is
+  // collected, the driver reclaims the context with the process instead
+  if (self->context && !Py_IsFinalizing()) {
+    if (egl.GetCurrentContext() == self->context) {
+      egl.MakeCurrent(self->display, NULL, NULL, NULL);
+    }
+    // The display is shared by every headless context and stays initialized
+    egl.DestroyContext(self->display, self->context);
+  }
+  PyTypeObject *type = Py_TYPE(self);
+  PyObject_Del(self);
+  Py_DECREF(type);
+}
+#endif
+
+#ifdef HYPERGL_NATIVE_OSMESA
+static void OSMesa_dealloc(OSMesa *self) {
+  if (self->context && !Py_IsFinalizing()) {
+    if (osmesa.GetCurrentContext() == self->context) {
+      osmesa.MakeCurrent(NULL, NULL, GL_UNSIGNED_BYTE, 0, 0);
+    }
+    osmesa.DestroyContext(self->context);
+  }
+  PyBuffer_Release(&self->target);
+  PyTypeObject *type = Py_TYPE(self);
+  PyObject_Del(self);
+  Py_DECREF(type);
+}
+#endif
+
+static void Fence_dealloc(Fence *self) {
+  // Never waited on: the sync is deleted with the next flush of the trash
+  if (self->sync) {
+    enqueue_trash_sync(self->trash, self->sync);
+  }
+  if (self->trash && Atomic_Decrement(&self->trash->ref_count) == 0) {
+    free_shared_trash(self->trash);
+  }
+  wait_event_destroy(&self->event);
+  PyObject_Del(self);
+}
+
+static int Encoder_traverse(Encoder *self, visitproc visit, void *arg) {
+  Py_VISIT(Py_TYPE(self));
+  Py_VISIT(self->ctx);
+  for (int i = 0; i < self->count; ++i) {
+    Py_VISIT(self->commands[i].target);
+    Py_VISIT(self->commands[i].args);
+    Py_VISIT(self->commands[i].kwargs);
+  }
+  return 0;
+}
+
+static int Encoder_clear(Encoder *self) {
+  EncoderCommand *commands = self->commands;
+  int count = self->count;
+  self->commands = NULL;
+  self->count = 0;
+  self->capacity = 0;
+  release_encoder_commands(commands, count);
+  PyMem_Free(commands);
+  Py_CLEAR(self->ctx);
+  return 0;
+}
+
+static void Encoder_dealloc(Encoder *self) {
+  PyObject_GC_UnTrack(self);
+  // Commands that were never submitted are simply dropped
+  Encoder_clear(self);
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
 // -----------------------------------------------------------------------------
 // Python Module Definitions
 // -----------------------------------------------------------------------------
@@ -6698,6 +12271,14 @@ static void GLObject_dealloc(GLObject *self) {
 static PyMethodDef Context_methods[] = {
     {"buffer", (PyCFunction)Context_meth_buffer, METH_VARARGS | METH_KEYWORDS,
      NULL},
+    {"heap", (PyCFunction)Context_meth_heap, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"mesh_pool", (PyCFunction)Context_meth_mesh_pool,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"load_texture", (PyCFunction)Context_meth_load_texture,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"frame_stack", (PyCFunction)Context_meth_frame_stack,
+     METH_VARARGS | METH_KEYWORDS, NULL},
     {"pack_indirect", (PyCFunction)Context_meth_pack_indirect,
      METH_VARARGS | METH_KEYWORDS, NULL},
     {"image", (PyCFunction)Context_meth_image, METH_VARARGS | METH_KEYWORDS,
@@ -6712,6 +12293,16 @@ static PyMethodDef Context_methods[] = {
      METH_VARARGS | METH_KEYWORDS, NULL},
     {"release", (PyCFunction)Context_meth_release, METH_O, NULL},
     {"migrate", (PyCFunction)Context_meth_migrate, METH_NOARGS, NULL},
+    {"encoder", (PyCFunction)Context_meth_encoder, METH_NOARGS, NULL},
+    {"fence", (PyCFunction)Context_meth_fence, METH_NOARGS, NULL},
+    {"start_render_thread", (PyCFunction)Context_meth_start_render_thread,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"stop_render_thread", (PyCFunction)Context_meth_stop_render_thread,
+     METH_NOARGS, NULL},
+    {"attach_upload_thread", (PyCFunction)Context_meth_attach_upload_thread,
+     METH_NOARGS, NULL},
+    {"detach_upload_thread", (PyCFunction)Context_meth_detach_upload_thread,
+     METH_NOARGS, NULL},
     {NULL, NULL, 0, NULL},
 };
 
@@ -6719,13 +12310,13 @@ static PyGetSetDef Context_getset[] = {
     {"screen", (getter)Context_get_screen, (setter)Context_set_screen, NULL,
      NULL},
     {"loader", (getter)Context_get_loader, NULL, NULL, NULL},
+    {"info", (getter)Context_get_info, NULL, NULL, NULL},
     {0},
 };
 
 static PyMemberDef Context_members[] = {
     {"includes", Py_T_OBJECT_EX, offsetof(Context, includes), Py_READONLY,
      NULL},
-    {"info", Py_T_OBJECT_EX, offsetof(Context, info_dict), Py_READONLY, NULL},
     {"lost", Py_T_BOOL, offsetof(Context, is_lost), 0, NULL},
     {0},
 };
@@ -6734,9 +12325,16 @@ static PyMethodDef Buffer_methods[] = {
     {"write", (PyCFunction)Buffer_meth_write, METH_VARARGS | METH_KEYWORDS,
      NULL},
     {"read", (PyCFunction)Buffer_meth_read, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"write_strided", (PyCFunction)Buffer_meth_write_strided,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"write_many", (PyCFunction)Buffer_meth_write_many, METH_VARARGS, NULL},
     {"view", (PyCFunction)Buffer_meth_view, METH_VARARGS | METH_KEYWORDS, NULL},
     {"map", (PyCFunction)Buffer_meth_map, METH_NOARGS, NULL},
+    {"as_array", (PyCFunction)Buffer_meth_as_array,
+     METH_VARARGS | METH_KEYWORDS, NULL},
     {"unmap", (PyCFunction)Buffer_meth_unmap, METH_NOARGS, NULL},
+    {"flush", (PyCFunction)Buffer_meth_flush, METH_VARARGS | METH_KEYWORDS,
+     NULL},
     {"bind", (PyCFunction)Buffer_meth_bind, METH_VARARGS, NULL},
     {"write_texture_handle", (PyCFunction)Buffer_meth_write_texture_handle,
      METH_VARARGS | METH_KEYWORDS, NULL},
@@ -6744,7 +12342,7 @@ static PyMethodDef Buffer_methods[] = {
 };
 
 static PyMemberDef Buffer_members[] = {
-    {"size", Py_T_INT, offsetof(Buffer, size), Py_READONLY, NULL},
+    {"size", Py_T_PYSSIZET, offsetof(Buffer, size), Py_READONLY, NULL},
     {0},
 };
 
@@ -6755,7 +12353,11 @@ static PyMethodDef Image_methods[] = {
     {"read", (PyCFunction)Image_meth_read, METH_VARARGS | METH_KEYWORDS, NULL},
     {"mipmaps", (PyCFunction)Image_meth_mipmaps, METH_NOARGS, NULL},
     {"blit", (PyCFunction)Image_meth_blit, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"copy_to", (PyCFunction)Image_meth_copy_to, METH_VARARGS | METH_KEYWORDS,
+     NULL},
     {"face", (PyCFunction)Image_meth_face, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"stream_from", (PyCFunction)Image_meth_stream_from,
+     METH_VARARGS | METH_KEYWORDS, NULL},
     {"get_handle", (PyCFunction)Image_meth_get_handle, METH_NOARGS, NULL},
     {"make_resident", (PyCFunction)Image_meth_make_resident, METH_VARARGS,
      NULL},
@@ -6831,11 +12433,235 @@ static PyMemberDef ImageFace_members[] = {
     {0},
 };
 
+static PyMethodDef BufferView_methods[] = {
+    {"write", (PyCFunction)BufferView_meth_write, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"read", (PyCFunction)BufferView_meth_read, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"as_array", (PyCFunction)BufferView_meth_as_array,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {0},
+};
+
+static PyMethodDef MappedArray_methods[] = {
+    {"__dlpack__", (PyCFunction)MappedArray_meth_dlpack,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"__dlpack_device__", (PyCFunction)MappedArray_meth_dlpack_device,
+     METH_NOARGS, NULL},
+    {0},
+};
+
+static PyMemberDef MappedArray_members[] = {
+    {"buffer", Py_T_OBJECT_EX, offsetof(MappedArray, buffer), Py_READONLY,
+     NULL},
+    {"nbytes", Py_T_PYSSIZET, offsetof(MappedArray, nbytes), Py_READONLY,
+     NULL},
+    {"itemsize", Py_T_PYSSIZET, offsetof(MappedArray, itemsize), Py_READONLY,
+     NULL},
+    {0},
+};
+
+static PyGetSetDef MappedArray_getset[] = {
+    {"shape", (getter)MappedArray_get_shape, NULL, NULL, NULL},
+    {"__array_interface__", (getter)MappedArray_get_array_interface, NULL,
+     NULL, NULL},
+    {0},
+};
+
+static PyMemberDef BufferView_members[] = {
+    {"buffer", Py_T_OBJECT_EX, offsetof(BufferView, buffer), Py_READONLY,
+     NULL},
+    {"offset", Py_T_PYSSIZET, offsetof(BufferView, offset), Py_READONLY, NULL},
+    {"size", Py_T_PYSSIZET, offsetof(BufferView, size), Py_READONLY, NULL},
+    {0},
+};
+
+static PyMethodDef Heap_methods[] = {
+    {"alloc", (PyCFunction)Heap_meth_alloc, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"free", (PyCFunction)Heap_meth_free, METH_O, NULL},
+    {0},
+};
+
+static PyMemberDef Heap_members[] = {
+    {"kind", Py_T_OBJECT_EX, offsetof(Heap, kind), Py_READONLY, NULL},
+    {"block", Py_T_PYSSIZET, offsetof(Heap, block), Py_READONLY, NULL},
+    {0},
+};
+
+static PyGetSetDef Heap_getset[] = {
+    {"size", (getter)Heap_get_size, NULL, NULL, NULL},
+    {"buffers", (getter)Heap_get_buffers, NULL, NULL, NULL},
+    {"used", (getter)Heap_get_used, NULL, NULL, NULL},
+    {0},
+};
+
+static PyMethodDef ImageStream_methods[] = {
+    {"step", (PyCFunction)ImageStream_meth_step, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {0},
+};
+
+static PyMethodDef FrameStack_methods[] = {
+    {"push", (PyCFunction)FrameStack_meth_push, METH_NOARGS, NULL},
+    {"reset", (PyCFunction)FrameStack_meth_reset, METH_NOARGS, NULL},
+    {"read", (PyCFunction)FrameStack_meth_read, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {0},
+};
+
+static PyMemberDef FrameStack_members[] = {
+    {"source", Py_T_OBJECT_EX, offsetof(FrameStack, source), Py_READONLY,
+     NULL},
+    {"image", Py_T_OBJECT_EX, offsetof(FrameStack, image), Py_READONLY, NULL},
+    {"size", Py_T_INT, offsetof(FrameStack, size), Py_READONLY, NULL},
+    {"index", Py_T_INT, offsetof(FrameStack, index), Py_READONLY, NULL},
+    {0},
+};
+
+static PyMemberDef ImageStream_members[] = {
+    {"image", Py_T_OBJECT_EX, offsetof(ImageStream, image), Py_READONLY, NULL},
+    {0},
+};
+
+static PyGetSetDef ImageStream_getset[] = {
+    {"done", (getter)ImageStream_get_done, NULL, NULL, NULL},
+    {"progress", (getter)ImageStream_get_progress, NULL, NULL, NULL},
+    {"budget", (getter)ImageStream_get_budget,
+     (setter)ImageStream_set_budget, NULL, NULL},
+    {0},
+};
+
+static PyMethodDef MeshPool_methods[] = {
+    {"add", (PyCFunction)MeshPool_meth_add, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"free", (PyCFunction)MeshPool_meth_free, METH_O, NULL},
+    {"build_commands", (PyCFunction)MeshPool_meth_build_commands,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {0},
+};
+
+static PyMemberDef MeshPool_members[] = {
+    {"vertex_buffer", Py_T_OBJECT_EX, offsetof(MeshPool, vertex_buffer),
+     Py_READONLY, NULL},
+    {"index_buffer", Py_T_OBJECT_EX, offsetof(MeshPool, index_buffer),
+     Py_READONLY, NULL},
+    {"stride", Py_T_INT, offsetof(MeshPool, stride), Py_READONLY, NULL},
+    {"vertices", Py_T_PYSSIZET, offsetof(MeshPool, vertex_capacity),
+     Py_READONLY, NULL},
+    {"indices", Py_T_PYSSIZET, offsetof(MeshPool, index_capacity), Py_READONLY,
+     NULL},
+    {"vertices_used", Py_T_PYSSIZET, offsetof(MeshPool, vertices_used),
+     Py_READONLY, NULL},
+    {"indices_used", Py_T_PYSSIZET, offsetof(MeshPool, indices_used),
+     Py_READONLY, NULL},
+    {0},
+};
+
+static PyObject *MeshPool_get_short_index(MeshPool *self, void *closure) {
+  return PyBool_FromLong(self->index_size == 2);
+}
+
+static PyGetSetDef MeshPool_getset[] = {
+    {"short_index", (getter)MeshPool_get_short_index, NULL, NULL, NULL},
+    {0},
+};
+
+static PyMemberDef Mesh_members[] = {
+    {"first_index", Py_T_PYSSIZET, offsetof(Mesh, first_index), Py_READONLY,
+     NULL},
+    {"index_count", Py_T_PYSSIZET, offsetof(Mesh, index_count), Py_READONLY,
+     NULL},
+    {"base_vertex", Py_T_PYSSIZET, offsetof(Mesh, base_vertex), Py_READONLY,
+     NULL},
+    {"vertex_count", Py_T_PYSSIZET, offsetof(Mesh, vertex_count), Py_READONLY,
+     NULL},
+    {0},
+};
+
 static PyMethodDef Compute_methods[] = {
     {"run", (PyCFunction)Compute_meth_run, METH_VARARGS, NULL},
     {0},
 };
 
+static PyMethodDef Encoder_methods[] = {
+    {"write", (PyCFunction)Encoder_meth_write, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"write_image", (PyCFunction)Encoder_meth_write_image,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"blit", (PyCFunction)Encoder_meth_blit, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"render", (PyCFunction)Encoder_meth_render, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"render_indirect", (PyCFunction)Encoder_meth_render_indirect,
+     METH_VARARGS | METH_KEYWORDS, NULL},
+    {"run", (PyCFunction)Encoder_meth_run, METH_VARARGS | METH_KEYWORDS, NULL},
+    {"read", (PyCFunction)Encoder_meth_read, METH_VARARGS | METH_KEYWORDS,
+     NULL},
+    {"submit", (PyCFunction)Encoder_meth_submit, METH_NOARGS, NULL},
+    {0},
+};
+
+static PyMethodDef Fence_methods[] = {
+    {"wait", (PyCFunction)Fence_meth_wait, METH_VARARGS | METH_KEYWORDS, NULL},
+    {0},
+};
+
+static PyGetSetDef Fence_getset[] = {
+    {"signaled", (getter)Fence_get_signaled, NULL, NULL, NULL},
+    {0},
+};
+
+#ifdef HYPERGL_NATIVE_EGL
+static PyObject *HeadlessEGL_get_version(HeadlessEGL *self, void *closure) {
+  return Py_BuildValue("(ii)", self->major, self->minor);
+}
+
+static PyMethodDef HeadlessEGL_methods[] = {
+    {"load_opengl_function",
+     (PyCFunction)HeadlessEGL_meth_load_opengl_function, METH_O, NULL},
+    {"make_current", (PyCFunction)HeadlessEGL_meth_make_current, METH_NOARGS,
+     NULL},
+    {"release", (PyCFunction)HeadlessEGL_meth_release, METH_NOARGS, NULL},
+    {0},
+};
+
+static PyGetSetDef HeadlessEGL_getset[] = {
+    {"version", (getter)HeadlessEGL_get_version, NULL, NULL, NULL},
+    {0},
+};
+#endif
+
+#ifdef HYPERGL_NATIVE_OSMESA
+static PyObject *OSMesa_get_size(OSMesa *self, void *closure) {
+  return Py_BuildValue("(ii)", self->width, self->height);
+}
+
+static PyObject *OSMesa_get_target(OSMesa *self, void *closure) {
+  return Py_NewRef(self->target.obj);
+}
+
+static PyMethodDef OSMesa_methods[] = {
+    {"load_opengl_function", (PyCFunction)OSMesa_meth_load_opengl_function,
+     METH_O, NULL},
+    {"make_current", (PyCFunction)OSMesa_meth_make_current, METH_NOARGS, NULL},
+    {"release", (PyCFunction)OSMesa_meth_release, METH_NOARGS, NULL},
+    {"retarget", (PyCFunction)OSMesa_meth_retarget, METH_O, NULL},
+    {"finish", (PyCFunction)OSMesa_meth_finish, METH_NOARGS, NULL},
+    {0},
+};
+
+static PyGetSetDef OSMesa_getset[] = {
+    {"size", (getter)OSMesa_get_size, NULL, NULL, NULL},
+    {"target", (getter)OSMesa_get_target, NULL, NULL, NULL},
+    {0},
+};
+#endif
+
+static PyGetSetDef Encoder_getset[] = {
+    {"count", (getter)Encoder_get_count, NULL, NULL, NULL},
+    {0},
+};
+
 // -----------------------------------------------------------------------------
 // Type Slots & Specs
 // -----------------------------------------------------------------------------
@@ -6896,10 +12722,58 @@ static PyType_Slot ImageFace_slots[] = {
 };
 
 static PyType_Slot BufferView_slots[] = {
+    {Py_tp_methods, BufferView_methods},
+    {Py_tp_members, BufferView_members},
     {Py_tp_dealloc, (void *)BufferView_dealloc},
     {0},
 };
 
+static PyType_Slot MappedArray_slots[] = {
+    {Py_tp_methods, MappedArray_methods},
+    {Py_tp_members, MappedArray_members},
+    {Py_tp_getset, MappedArray_getset},
+    {Py_bf_getbuffer, (void *)MappedArray_getbuffer},
+    {Py_tp_dealloc, (void *)MappedArray_dealloc},
+    {0},
+};
+
+static PyType_Slot FrameStack_slots[] = {
+    {Py_tp_methods, FrameStack_methods},
+    {Py_tp_members, FrameStack_members},
+    {Py_tp_dealloc, (void *)FrameStack_dealloc},
+    {0},
+};
+
+static PyType_Slot ImageStream_slots[] = {
+    {Py_tp_methods, ImageStream_methods},
+    {Py_tp_members, ImageStream_members},
+    {Py_tp_getset, ImageStream_getset},
+    {Py_tp_dealloc, (void *)ImageStream_dealloc},
+    {0},
+};
+
+static PyType_Slot MeshPool_slots[] = {
+    {Py_tp_methods, MeshPool_methods},
+    {Py_tp_members, MeshPool_members},
+    {Py_tp_getset, MeshPool_getset},
+    {Py_tp_dealloc, (void *)MeshPool_dealloc},
+    {0},
+};
+
+static PyType_Slot Mesh_slots[] = {
+    {Py_tp_members, Mesh_members},
+    {Py_tp_dealloc, (void *)Mesh_dealloc},
+    {0},
+};
+
+static PyType_Slot Heap_slots[] = {
+    {Py_tp_methods, Heap_methods},
+    {Py_tp_members, Heap_members},
+    {Py_tp_getset, Heap_getset},
+    {Py_tp_dealloc, (void *)Heap_dealloc},
+    {0},
+};
+
 static PyType_Slot DescriptorSet_slots[] = {
     {Py_tp_dealloc, (void *)DescriptorSet_dealloc},
     {0},
@@ -6910,6 +12784,22 @@ static PyType_Slot GlobalSettings_slots[] = {
     {0},
 };
 
+static PyType_Slot Encoder_slots[] = {
+    {Py_tp_methods, Encoder_methods},
+    {Py_tp_getset, Encoder_getset},
+    {Py_tp_dealloc, (void *)Encoder_dealloc},
+    {Py_tp_traverse, (void *)Encoder_traverse},
+    {Py_tp_clear, (void *)Encoder_clear},
+    {0},
+};
+
+static PyType_Slot Fence_slots[] = {
+    {Py_tp_methods, Fence_methods},
+    {Py_tp_getset, Fence_getset},
+    {Py_tp_dealloc, (void *)Fence_dealloc},
+    {0},
+};
+
 static PyType_Slot GLObject_slots[] = {
     {Py_tp_dealloc, (void *)GLObject_dealloc},
     {Py_tp_traverse, (void *)GLObject_traverse},
@@ -6936,6 +12826,22 @@ static PyType_Spec ImageFace_spec = {"hypergl.ImageFace", sizeof(ImageFace), 0,
                                      ImageFace_slots};
 static PyType_Spec BufferView_spec = {"hypergl.BufferView", sizeof(BufferView),
                                       0, Py_TPFLAGS_DEFAULT, BufferView_slots};
+static PyType_Spec Heap_spec = {"hypergl.Heap", sizeof(Heap), 0,
+                                Py_TPFLAGS_DEFAULT, Heap_slots};
+static PyType_Spec MeshPool_spec = {"hypergl.MeshPool", sizeof(MeshPool), 0,
+                                    Py_TPFLAGS_DEFAULT, MeshPool_slots};
+static PyType_Spec Mesh_spec = {"hypergl.Mesh", sizeof(Mesh), 0,
+                                Py_TPFLAGS_DEFAULT, Mesh_slots};
+static PyType_Spec ImageStream_spec = {"hypergl.ImageStream",
+                                       sizeof(ImageStream), 0,
+                                       Py_TPFLAGS_DEFAULT, ImageStream_slots};
+
+static PyType_Spec FrameStack_spec = {"hypergl.FrameStack", sizeof(FrameStack),
+                                      0, Py_TPFLAGS_DEFAULT, FrameStack_slots};
+
+static PyType_Spec MappedArray_spec = {"hypergl.MappedArray",
+                                       sizeof(MappedArray), 0,
+                                       Py_TPFLAGS_DEFAULT, MappedArray_slots};
 static PyType_Spec DescriptorSet_spec = {
     "hypergl.DescriptorSet", sizeof(DescriptorSet), 0, Py_TPFLAGS_DEFAULT,
     DescriptorSet_slots};
@@ -6945,6 +12851,36 @@ static PyType_Spec GlobalSettings_spec = {
 static PyType_Spec GLObject_spec = {"hypergl.GLObject", sizeof(GLObject), 0,
                                     Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
                                     GLObject_slots};
+static PyType_Spec Encoder_spec = {"hypergl.Encoder", sizeof(Encoder), 0,
+                                   Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+                                   Encoder_slots};
+static PyType_Spec Fence_spec = {"hypergl.Fence", sizeof(Fence), 0,
+                                 Py_TPFLAGS_DEFAULT, Fence_slots};
+
+#ifdef HYPERGL_NATIVE_EGL
+static PyType_Slot HeadlessEGL_slots[] = {
+    {Py_tp_methods, HeadlessEGL_methods},
+    {Py_tp_getset, HeadlessEGL_getset},
+    {Py_tp_dealloc, (void *)HeadlessEGL_dealloc},
+    {0},
+};
+
+static PyType_Spec HeadlessEGL_spec = {"hypergl.HeadlessEGL",
+                                       sizeof(HeadlessEGL), 0,
+                                       Py_TPFLAGS_DEFAULT, HeadlessEGL_slots};
+#endif
+
+#ifdef HYPERGL_NATIVE_OSMESA
+static PyType_Slot OSMesa_slots[] = {
+    {Py_tp_methods, OSMesa_methods},
+    {Py_tp_getset, OSMesa_getset},
+    {Py_tp_dealloc, (void *)OSMesa_dealloc},
+    {0},
+};
+
+static PyType_Spec OSMesa_spec = {"hypergl.OSMesa", sizeof(OSMesa), 0,
+                                  Py_TPFLAGS_DEFAULT, OSMesa_slots};
+#endif
 
 // -----------------------------------------------------------------------------
 // Module Execution & Registration
@@ -6978,6 +12914,7 @@ static int module_exec(PyObject *self) {
   state->str_BUFFER_ACCESS = PyUnicode_InternFromString("BUFFER_ACCESS");
   state->str_IMAGE_FORMAT = PyUnicode_InternFromString("IMAGE_FORMAT");
   state->str_VERTEX_FORMAT = PyUnicode_InternFromString("VERTEX_FORMAT");
+  state->str_data = PyUnicode_InternFromString("data");
 
   state->default_loader = new_ref(Py_None);
   state->default_context = new_ref(Py_None);
@@ -7000,6 +12937,20 @@ static int module_exec(PyObject *self) {
   CREATE_TYPE(DescriptorSet_type, DescriptorSet_spec);
   CREATE_TYPE(GlobalSettings_type, GlobalSettings_spec);
   CREATE_TYPE(GLObject_type, GLObject_spec);
+  CREATE_TYPE(Encoder_type, Encoder_spec);
+  CREATE_TYPE(Fence_type, Fence_spec);
+  CREATE_TYPE(Heap_type, Heap_spec);
+  CREATE_TYPE(MeshPool_type, MeshPool_spec);
+  CREATE_TYPE(Mesh_type, Mesh_spec);
+  CREATE_TYPE(ImageStream_type, ImageStream_spec);
+  CREATE_TYPE(FrameStack_type, FrameStack_spec);
+  CREATE_TYPE(MappedArray_type, MappedArray_spec);
+#ifdef HYPERGL_NATIVE_EGL
+  CREATE_TYPE(HeadlessEGL_type, HeadlessEGL_spec);
+#endif
+#ifdef HYPERGL_NATIVE_OSMESA
+  CREATE_TYPE(OSMesa_type, OSMesa_spec);
+#endif
 
 #undef CREATE_TYPE
 
@@ -7010,6 +12961,20 @@ static int module_exec(PyObject *self) {
   PyModule_AddObject(self, "BufferView", new_ref(state->BufferView_type));
   PyModule_AddObject(self, "Pipeline", new_ref(state->Pipeline_type));
   PyModule_AddObject(self, "Compute", new_ref(state->Compute_type));
+  PyModule_AddObject(self, "Encoder", new_ref(state->Encoder_type));
+  PyModule_AddObject(self, "Fence", new_ref(state->Fence_type));
+  PyModule_AddObject(self, "Heap", new_ref(state->Heap_type));
+  PyModule_AddObject(self, "MeshPool", new_ref(state->MeshPool_type));
+  PyModule_AddObject(self, "Mesh", new_ref(state->Mesh_type));
+  PyModule_AddObject(self, "ImageStream", new_ref(state->ImageStream_type));
+  PyModule_AddObject(self, "FrameStack", new_ref(state->FrameStack_type));
+  PyModule_AddObject(self, "MappedArray", new_ref(state->MappedArray_type));
+#ifdef HYPERGL_NATIVE_EGL
+  PyModule_AddObject(self, "HeadlessEGL", new_ref(state->HeadlessEGL_type));
+#endif
+#ifdef HYPERGL_NATIVE_OSMESA
+  PyModule_AddObject(self, "OSMesa", new_ref(state->OSMesa_type));
+#endif
 
   PyObject *loader = PyObject_GetAttrString(state->helper, "loader");
   if (loader) {
@@ -7026,6 +12991,12 @@ static int module_exec(PyObject *self) {
     PyModule_AddObject(self, "bind", bind);
   }
 
+  PyObject *upload_context =
+      PyObject_GetAttrString(state->helper, "upload_context");
+  if (upload_context) {
+    PyModule_AddObject(self, "upload_context", upload_context);
+  }
+
 #ifdef EXTERN_GL
   PyModule_AddObject(self, "_extern_gl", PyUnicode_FromString(EXTERN_GL));
 #else
@@ -7103,6 +13074,7 @@ static int module_traverse(PyObject *m, visitproc visit, void *arg) {
   Py_VISIT(state->str_BUFFER_ACCESS);
   Py_VISIT(state->str_IMAGE_FORMAT);
   Py_VISIT(state->str_VERTEX_FORMAT);
+  Py_VISIT(state->str_data);
   Py_VISIT(state->default_loader);
   Py_VISIT(state->default_context);
   Py_VISIT(state->HyperGLError);
@@ -7117,6 +13089,16 @@ static int module_traverse(PyObject *m, visitproc visit, void *arg) {
   Py_VISIT(state->DescriptorSet_type);
   Py_VISIT(state->GlobalSettings_type);
   Py_VISIT(state->GLObject_type);
+  Py_VISIT(state->Encoder_type);
+  Py_VISIT(state->Fence_type);
+  Py_VISIT(state->Heap_type);
+  Py_VISIT(state->MeshPool_type);
+  Py_VISIT(state->Mesh_type);
+  Py_VISIT(state->ImageStream_type);
+  Py_VISIT(state->FrameStack_type);
+  Py_VISIT(state->MappedArray_type);
+  Py_VISIT(state->HeadlessEGL_type);
+  Py_VISIT(state->OSMesa_type);
 
   return 0;
 }
@@ -7135,6 +13117,7 @@ static int module_clear(PyObject *self) {
     Py_CLEAR(state->str_BUFFER_ACCESS);
     Py_CLEAR(state->str_IMAGE_FORMAT);
     Py_CLEAR(state->str_VERTEX_FORMAT);
+    Py_CLEAR(state->str_data);
     Py_CLEAR(state->default_loader);
     Py_CLEAR(state->default_context);
     Py_CLEAR(state->HyperGLError);
@@ -7148,6 +13131,16 @@ static int module_clear(PyObject *self) {
     Py_CLEAR(state->DescriptorSet_type);
     Py_CLEAR(state->GlobalSettings_type);
     Py_CLEAR(state->GLObject_type);
+    Py_CLEAR(state->Encoder_type);
+    Py_CLEAR(state->Fence_type);
+    Py_CLEAR(state->Heap_type);
+    Py_CLEAR(state->MeshPool_type);
+    Py_CLEAR(state->Mesh_type);
+    Py_CLEAR(state->ImageStream_type);
+    Py_CLEAR(state->FrameStack_type);
+    Py_CLEAR(state->MappedArray_type);
+    Py_CLEAR(state->HeadlessEGL_type);
+    Py_CLEAR(state->OSMesa_type);
   }
   return 0;
 }
@@ -10,15 +10,28 @@ calcsize = getattr(_hypergl_c, 'calcsize', None)
 loader = getattr(_hypergl_c, 'loader', None)
 cleanup = getattr(_hypergl_c, 'cleanup', None)
 inspect = getattr(_hypergl_c, 'inspect', None)
+upload_context = getattr(_hypergl_c, 'upload_context', None)
 
 Context = getattr(_hypergl_c, 'Context', None)
 Buffer = getattr(_hypergl_c, 'Buffer', None)
 Image = getattr(_hypergl_c, 'Image', None)
 Pipeline = getattr(_hypergl_c, 'Pipeline', None)
 Compute = getattr(_hypergl_c, 'Compute', None)
+Encoder = getattr(_hypergl_c, 'Encoder', None)
+Fence = getattr(_hypergl_c, 'Fence', None)
+Heap = getattr(_hypergl_c, 'Heap', None)
+MeshPool = getattr(_hypergl_c, 'MeshPool', None)
+Mesh = getattr(_hypergl_c, 'Mesh', None)
+ImageStream = getattr(_hypergl_c, 'ImageStream', None)
+FrameStack = getattr(_hypergl_c, 'FrameStack', None)
+MappedArray = getattr(_hypergl_c, 'MappedArray', None)
+HeadlessEGL = getattr(_hypergl_c, 'HeadlessEGL', None)
+OSMesa = getattr(_hypergl_c, 'OSMesa', None)
 
 __all__ = [
-    'init', 'cleanup', 'context', 'loader', 'inspect',
-    'Context', 'Buffer', 'Image', 'Pipeline', 'Compute',
+    'init', 'cleanup', 'context', 'loader', 'inspect', 'upload_context',
+    'Context', 'Buffer', 'Image', 'Pipeline', 'Compute', 'Encoder', 'Fence',
+    'Heap', 'MeshPool', 'Mesh', 'ImageStream', 'FrameStack', 'MappedArray',
+    'HeadlessEGL', 'OSMesa',
     'bind', 'camera', 'calcsize'
 ]
\ No newline at end of file
@@ -54,9 +54,13 @@ IMAGE_FORMAT = {
     'r8unorm': (0x8229, 0x1903, 0x1401, 0x1800, 1, 1, 1, 1, 'f'),
     'rg8unorm': (0x822B, 0x8227, 0x1401, 0x1800, 2, 2, 1, 1, 'f'),
     'rgba8unorm': (0x8058, 0x1908, 0x1401, 0x1800, 4, 4, 1, 1, 'f'),
+    'rgba8unorm-srgb': (0x8C43, 0x1908, 0x1401, 0x1800, 4, 4, 1, 1, 'f'),
     'r8snorm': (0x8F94, 0x1903, 0x1401, 0x1800, 1, 1, 1, 1, 'f'),
     'rg8snorm': (0x8F95, 0x8227, 0x1401, 0x1800, 2, 2, 1, 1, 'f'),
     'rgba8snorm': (0x8F97, 0x1908, 0x1401, 0x1800, 4, 4, 1, 1, 'f'),
+    'r16snorm': (0x8F98, 0x1903, 0x1402, 0x1800, 1, 2, 1, 1, 'f'),
+    'rg16snorm': (0x8F99, 0x8227, 0x1402, 0x1800, 2, 4, 1, 1, 'f'),
+    'rgba16snorm': (0x8F9B, 0x1908, 0x1402, 0x1800, 4, 8, 1, 1, 'f'),
     'r8uint': (0x8232, 0x8D94, 0x1401, 0x1800, 1, 1, 1, 1, 'u'),
     'rg8uint': (0x8238, 0x8228, 0x1401, 0x1800, 2, 2, 1, 1, 'u'),
     'rgba8uint': (0x8D7C, 0x8D99, 0x1401, 0x1800, 4, 4, 1, 1, 'u'),
@@ -75,9 +79,9 @@ IMAGE_FORMAT = {
     'r32sint': (0x8235, 0x8D94, 0x1404, 0x1800, 1, 4, 1, 1, 'i'),
     'rg32sint': (0x823B, 0x8228, 0x1404, 0x1800, 2, 8, 1, 1, 'i'),
     'rgba32sint': (0x8D82, 0x8D99, 0x1404, 0x1800, 4, 16, 1, 1, 'i'),
-    'r16float': (0x822D, 0x1903, 0x1406, 0x1800, 1, 2, 1, 1, 'f'),
-    'rg16float': (0x822F, 0x8227, 0x1406, 0x1800, 2, 4, 1, 1, 'f'),
-    'rgba16float': (0x881A, 0x1908, 0x1406, 0x1800, 4, 8, 1, 1, 'f'),
+    'r16float': (0x822D, 0x1903, 0x140B, 0x1800, 1, 2, 1, 1, 'f'),
+    'rg16float': (0x822F, 0x8227, 0x140B, 0x1800, 2, 4, 1, 1, 'f'),
+    'rgba16float': (0x881A, 0x1908, 0x140B, 0x1800, 4, 8, 1, 1, 'f'),
     'r32float': (0x822E, 0x1903, 0x1406, 0x1800, 1, 4, 1, 1, 'f'),
     'rg32float': (0x8230, 0x8227, 0x1406, 0x1800, 2, 8, 1, 1, 'f'),
     'rgba32float': (0x8814, 0x1908, 0x1406, 0x1800, 4, 16, 1, 1, 'f'),
@@ -86,7 +90,37 @@ IMAGE_FORMAT = {
     'depth24plus': (0x81A6, 0x1902, 0x1405, 0x1801, 1, 4, 0, 2, 'f'),
     'depth24plus-stencil8': (0x88F0, 0x84F9, 0x84FA, 0x84F9, 2, 4, 0, 6, 'x'),
     'depth32float': (0x8CAC, 0x1902, 0x1406, 0x1801, 1, 4, 0, 2, 'f'),
+    'rg11b10ufloat': (0x8C3A, 0x1907, 0x8C3B, 0x1800, 3, 4, 1, 1, 'f'),
+    # Shared exponent, sampled only so it has no attachment flags
+    'rgb9e5ufloat': (0x8C3D, 0x1907, 0x8C3E, 0x1800, 3, 4, 1, 0, 'f'),
+    # Block compressed, pixel_size is the size of a 4x4 block
+    'bc1-rgba-unorm': (0x83F1, 0x1908, 0x1401, 0x1800, 4, 8, 1, 1, 'f', 4),
+    'bc1-rgba-unorm-srgb': (0x8C4D, 0x1908, 0x1401, 0x1800, 4, 8, 1, 1, 'f', 4),
+    'bc2-rgba-unorm': (0x83F2, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'bc2-rgba-unorm-srgb': (0x8C4E, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'bc3-rgba-unorm': (0x83F3, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'bc3-rgba-unorm-srgb': (0x8C4F, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'bc4-r-unorm': (0x8DBB, 0x1903, 0x1401, 0x1800, 1, 8, 1, 1, 'f', 4),
+    'bc4-r-snorm': (0x8DBC, 0x1903, 0x1401, 0x1800, 1, 8, 1, 1, 'f', 4),
+    'bc5-rg-unorm': (0x8DBD, 0x8227, 0x1401, 0x1800, 2, 16, 1, 1, 'f', 4),
+    'bc5-rg-snorm': (0x8DBE, 0x8227, 0x1401, 0x1800, 2, 16, 1, 1, 'f', 4),
+    'bc6h-rgb-ufloat': (0x8E8F, 0x1907, 0x1401, 0x1800, 3, 16, 1, 1, 'f', 4),
+    'bc6h-rgb-float': (0x8E8E, 0x1907, 0x1401, 0x1800, 3, 16, 1, 1, 'f', 4),
+    'bc7-rgba-unorm': (0x8E8C, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'bc7-rgba-unorm-srgb': (0x8E8D, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'etc2-rgb8unorm': (0x9274, 0x1907, 0x1401, 0x1800, 3, 8, 1, 1, 'f', 4),
+    'etc2-rgb8unorm-srgb': (0x9275, 0x1907, 0x1401, 0x1800, 3, 8, 1, 1, 'f', 4),
+    'etc2-rgb8a1unorm': (0x9276, 0x1908, 0x1401, 0x1800, 4, 8, 1, 1, 'f', 4),
+    'etc2-rgb8a1unorm-srgb': (0x9277, 0x1908, 0x1401, 0x1800, 4, 8, 1, 1, 'f', 4),
+    'etc2-rgba8unorm': (0x9278, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'etc2-rgba8unorm-srgb': (0x9279, 0x1908, 0x1401, 0x1800, 4, 16, 1, 1, 'f', 4),
+    'eac-r11unorm': (0x9270, 0x1903, 0x1401, 0x1800, 1, 8, 1, 1, 'f', 4),
+    'eac-r11snorm': (0x9271, 0x1903, 0x1401, 0x1800, 1, 8, 1, 1, 'f', 4),
+    'eac-rg11unorm': (0x9272, 0x8227, 0x1401, 0x1800, 2, 16, 1, 1, 'f', 4),
+    'eac-rg11snorm': (0x9273, 0x8227, 0x1401, 0x1800, 2, 16, 1, 1, 'f', 4),
 }
+IMAGE_FORMAT['r11g11b10f'] = IMAGE_FORMAT['rg11b10ufloat']
+IMAGE_FORMAT['rgb9e5'] = IMAGE_FORMAT['rgb9e5ufloat']
 TOPOLOGY = {
     'points': 0,
     'lines': 1,
@@ -574,6 +608,230 @@ def loader(headless=False):
     loader.extra = extra
     return loader
 
+class UploadContext:
+    def __init__(self):
+        import ctypes
+        self.release_context = None
+        self.make_current_context = None
+
+        # The new context must match the version and profile of the one it shares with
+        get_integer = None
+
+        if sys.platform.startswith('win'):
+            opengl32 = ctypes.windll.opengl32
+            opengl32.wglGetCurrentDC.restype = ctypes.c_void_p
+            opengl32.wglGetCurrentContext.restype = ctypes.c_void_p
+            opengl32.wglGetProcAddress.restype = ctypes.c_void_p
+            opengl32.wglCreateContext.restype = ctypes.c_void_p
+            opengl32.wglCreateContext.argtypes = [ctypes.c_void_p]
+            opengl32.wglShareLists.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+            opengl32.wglMakeCurrent.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+            opengl32.wglDeleteContext.argtypes = [ctypes.c_void_p]
+
+            hdc = opengl32.wglGetCurrentDC()
+            share = opengl32.wglGetCurrentContext()
+            if not share:
+                raise RuntimeError('Cannot detect window with OpenGL support')
+
+            get_integer = ctypes.WINFUNCTYPE(None, ctypes.c_int, ctypes.POINTER(ctypes.c_int))(
+                ctypes.cast(opengl32.glGetIntegerv, ctypes.c_void_p).value
+            )
+            attribs = self.context_attribs(get_integer, (0x2091, 0x2092, 0x9126))
+            create_addr = opengl32.wglGetProcAddress(b'wglCreateContextAttribsARB')
+            if create_addr:
+                create = ctypes.WINFUNCTYPE(ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.POINTER(ctypes.c_int))(create_addr)
+                rc = create(hdc, share, attribs)
+            else:
+                rc = opengl32.wglCreateContext(hdc)
+                if rc and not opengl32.wglShareLists(share, rc):
+                    opengl32.wglDeleteContext(rc)
+                    rc = None
+            if not rc:
+                raise RuntimeError('Cannot create a shared OpenGL context')
+
+            self.make_current_context = lambda: opengl32.wglMakeCurrent(hdc, rc)
+            self.release_context = lambda: opengl32.wglMakeCurrent(None, None)
+            self.destroy_context = lambda: opengl32.wglDeleteContext(rc)
+            return
+
+        try:
+            try:
+                egl = ctypes.CDLL('libEGL.so')
+            except OSError:
+                egl = ctypes.CDLL('libEGL.so.1')
+        except OSError:
+            egl = None
+
+        if egl is None:
+            if self.glx_context():
+                return
+            raise RuntimeError('Upload contexts require EGL, GLX or WGL')
+
+        void_p, int_p = ctypes.c_void_p, ctypes.POINTER(ctypes.c_int)
+        for name, restype, argtypes in (
+            ('eglGetCurrentDisplay', void_p, []),
+            ('eglGetCurrentContext', void_p, []),
+            ('eglGetProcAddress', void_p, [ctypes.c_char_p]),
+            ('eglQueryContext', ctypes.c_int, [void_p, void_p, ctypes.c_int, int_p]),
+            ('eglChooseConfig', ctypes.c_int, [void_p, int_p, ctypes.POINTER(void_p), ctypes.c_int, int_p]),
+            ('eglQueryAPI', ctypes.c_int, []),
+            ('eglBindAPI', ctypes.c_int, [ctypes.c_int]),
+            ('eglCreateContext', void_p, [void_p, void_p, void_p, int_p]),
+            ('eglCreatePbufferSurface', void_p, [void_p, void_p, int_p]),
+            ('eglMakeCurrent', ctypes.c_int, [void_p, void_p, void_p, void_p]),
+            ('eglDestroySurface', ctypes.c_int, [void_p, void_p]),
+            ('eglDestroyContext', ctypes.c_int, [void_p, void_p]),
+        ):
+            func = getattr(egl, name)
+            func.restype = restype
+            func.argtypes = argtypes
+
+        dpy = egl.eglGetCurrentDisplay()
+        share = egl.eglGetCurrentContext()
+        if not share:
+            # The window may have been created through GLX instead
+            if self.glx_context():
+                return
+            raise RuntimeError('Upload contexts require EGL, GLX or WGL')
+        api = egl.eglQueryAPI()
+
+        config_id = ctypes.c_int()
+        egl.eglQueryContext(dpy, share, 0x3028, ctypes.byref(config_id))  # EGL_CONFIG_ID
+        config = ctypes.c_void_p()
+        count = ctypes.c_int()
+        egl.eglChooseConfig(dpy, (ctypes.c_int * 3)(0x3028, config_id.value, 0x3038), ctypes.byref(config), 1, ctypes.byref(count))
+
+        get_integer = ctypes.CFUNCTYPE(None, ctypes.c_int, ctypes.POINTER(ctypes.c_int))(
+            egl.eglGetProcAddress(b'glGetIntegerv')
+        )
+        # EGL_CONTEXT_MAJOR_VERSION, EGL_CONTEXT_MINOR_VERSION, EGL_CONTEXT_OPENGL_PROFILE_MASK
+        keys = (0x3098, 0x30FB, 0x30FD) if api == 0x30A2 else (0x3098, 0x30FB, None)
+        attribs = self.context_attribs(get_integer, keys, terminator=0x3038)
+
+        # The calling thread keeps its context, the new one is only bound in make_current
+        egl.eglBindAPI(api)
+        rc = egl.eglCreateContext(dpy, config, share, attribs)
+        if not rc:
+            raise RuntimeError('Cannot create a shared OpenGL context')
+
+        surface = []
+
+        def make_current():
+            egl.eglBindAPI(api)
+            if surface:
+                return egl.eglMakeCurrent(dpy, surface[0], surface[0], rc)
+            # Prefer EGL_KHR_surfaceless_context, fall back to a tiny pbuffer
+            if egl.eglMakeCurrent(dpy, None, None, rc):
+                return True
+            surface.append(egl.eglCreatePbufferSurface(dpy, config, (ctypes.c_int * 5)(0x3057, 1, 0x3056, 1, 0x3038)))
+            return egl.eglMakeCurrent(dpy, surface[0], surface[0], rc)
+
+        def destroy():
+            if surface and surface[0]:
+                egl.eglDestroySurface(dpy, surface[0])
+            egl.eglDestroyContext(dpy, rc)
+
+        self.make_current_context = make_current
+        self.release_context = lambda: egl.eglMakeCurrent(dpy, None, None, None)
+        self.destroy_context = destroy
+
+    def glx_context(self):
+        # Xlib must have been set up with XInitThreads() by whoever opened the display
+        import ctypes
+        try:
+            glx = ctypes.CDLL('libGL.so.1')
+        except OSError:
+            return False
+
+        void_p, int_p = ctypes.c_void_p, ctypes.POINTER(ctypes.c_int)
+        for name, restype, argtypes in (
+            ('glXGetCurrentDisplay', void_p, []),
+            ('glXGetCurrentContext', void_p, []),
+            ('glXGetProcAddressARB', void_p, [ctypes.c_char_p]),
+            ('glXQueryContext', ctypes.c_int, [void_p, void_p, ctypes.c_int, int_p]),
+            ('glXChooseFBConfig', ctypes.POINTER(void_p), [void_p, ctypes.c_int, int_p, int_p]),
+            ('glXCreatePbuffer', ctypes.c_ulong, [void_p, void_p, int_p]),
+            ('glXMakeContextCurrent', ctypes.c_int, [void_p, ctypes.c_ulong, ctypes.c_ulong, void_p]),
+            ('glXDestroyPbuffer', None, [void_p, ctypes.c_ulong]),
+            ('glXDestroyContext', None, [void_p, void_p]),
+        ):
+            func = getattr(glx, name)
+            func.restype = restype
+            func.argtypes = argtypes
+
+        share = glx.glXGetCurrentContext()
+        if not share:
+            return False
+        dpy = glx.glXGetCurrentDisplay()
+
+        # The shared context uses the framebuffer config of the current one
+        config_id, screen, count = ctypes.c_int(), ctypes.c_int(), ctypes.c_int()
+        glx.glXQueryContext(dpy, share, 0x8013, ctypes.byref(config_id))  # GLX_FBCONFIG_ID
+        glx.glXQueryContext(dpy, share, 0x800C, ctypes.byref(screen))  # GLX_SCREEN
+        configs = glx.glXChooseFBConfig(dpy, screen.value, (ctypes.c_int * 3)(0x8013, config_id.value, 0), ctypes.byref(count))
+        create_addr = glx.glXGetProcAddressARB(b'glXCreateContextAttribsARB')
+        if not configs or not count.value or not create_addr:
+            raise RuntimeError('Cannot create a shared OpenGL context')
+        config = configs[0]
+
+        get_integer = ctypes.CFUNCTYPE(None, ctypes.c_int, ctypes.POINTER(ctypes.c_int))(
+            glx.glXGetProcAddressARB(b'glGetIntegerv')
+        )
+        # GLX_CONTEXT_MAJOR_VERSION_ARB, GLX_CONTEXT_MINOR_VERSION_ARB, GLX_CONTEXT_PROFILE_MASK_ARB
+        attribs = self.context_attribs(get_integer, (0x2091, 0x2092, 0x9126))
+        create = ctypes.CFUNCTYPE(void_p, void_p, void_p, void_p, ctypes.c_int, int_p)(create_addr)
+        rc = create(dpy, config, share, 1, attribs)
+        if not rc:
+            raise RuntimeError('Cannot create a shared OpenGL context')
+
+        surface = []
+
+        def make_current():
+            if surface:
+                return glx.glXMakeContextCurrent(dpy, surface[0], surface[0], rc)
+            # GL 3.0+ contexts may be current without a drawable, fall back to a tiny pbuffer
+            if glx.glXMakeContextCurrent(dpy, 0, 0, rc):
+                return True
+            # GLX_PBUFFER_WIDTH, GLX_PBUFFER_HEIGHT
+            surface.append(glx.glXCreatePbuffer(dpy, config, (ctypes.c_int * 5)(0x8041, 1, 0x8040, 1, 0)))
+            return glx.glXMakeContextCurrent(dpy, surface[0], surface[0], rc)
+
+        def destroy():
+            if surface and surface[0]:
+                glx.glXDestroyPbuffer(dpy, surface[0])
+            glx.glXDestroyContext(dpy, rc)
+
+        self.make_current_context = make_current
+        self.release_context = lambda: glx.glXMakeContextCurrent(dpy, 0, 0, None)
+        self.destroy_context = destroy
+        return True
+
+    @staticmethod
+    def context_attribs(get_integer, keys, terminator=0):
+        import ctypes
+        major, minor, profile = ctypes.c_int(), ctypes.c_int(), ctypes.c_int()
+        get_integer(0x821B, ctypes.byref(major))  # GL_MAJOR_VERSION
+        get_integer(0x821C, ctypes.byref(minor))  # GL_MINOR_VERSION
+        attribs = [keys[0], major.value, keys[1], minor.value]
+        if keys[2] is not None and major.value * 10 + minor.value >= 32:
+            get_integer(0x9126, ctypes.byref(profile))  # GL_CONTEXT_PROFILE_MASK
+            attribs += [keys[2], profile.value or 1]
+        attribs.append(terminator)
+        return (ctypes.c_int * len(attribs))(*attribs)
+
+    def make_current(self):
+        if not self.make_current_context():
+            raise RuntimeError('Cannot make the upload context current')
+
+    def release(self):
+        if self.release_context is not None:
+            self.release_context()
+            self.destroy_context()
+            self.release_context = None
+
+def upload_context():
+    return UploadContext()
+
 def calcsize(layout):
     nodes = layout.split(' ')
     if nodes[-1] == '/i':
@@ -621,23 +879,149 @@ def bind(buffer, layout, *attributes, offset=0, instance=False):
         x['stride'] = sub_offset
     return res
 
+def buffer_range(buffer, offset, size):
+    # BufferViews (e.g. heap allocations) bind as a range of their buffer
+    parent = getattr(buffer, 'buffer', None)
+    base = buffer.offset if parent is not None else 0
+    if size is None:
+        size = buffer.size - offset
+    if offset < 0 or size <= 0 or offset + size > buffer.size:
+        raise ValueError(f"Invalid buffer range: offset={offset}, size={size}, buffer.size={buffer.size}")
+    return (parent if parent is not None else buffer), base + offset, size
+
+
 def vertex_array_bindings(vertex_buffers, index_buffer):
-    res = [index_buffer]
+    res = [getattr(index_buffer, 'buffer', index_buffer)]
     for obj in vertex_buffers:
         buffer = obj['buffer']
         if buffer is not None:
-            res.extend([buffer, obj['location'], obj['offset'], obj['stride'], STEP[obj['step']], obj['format']])
+            offset = obj['offset']
+            parent = getattr(buffer, 'buffer', None)
+            if parent is not None:
+                buffer, offset = parent, buffer.offset + offset
+            res.extend([buffer, obj['location'], offset, obj['stride'], STEP[obj['step']], obj['format']])
     return tuple(res)
 
+def stream_source(source):
+    # Paths are mapped read-only, the pages are faulted in tile by tile
+    if isinstance(source, (str, os.PathLike)):
+        import mmap
+        with open(source, 'rb') as f:
+            return mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    return source
+
+
+READ_TRANSFORM_DTYPES = {'uint8': '8unorm', 'float16': '16float', 'float32': '32float'}
+READ_TRANSFORM_FORMATS = {1: 'r', 2: 'rg', 3: 'rgba', 4: 'rgba'}
+
+
+def read_transform(ctx, image, cache, transform):
+    # One fullscreen draw does the crop, bilinear resize, channel select, flip
+    # and scale/bias. Crop, flip and scale/bias are uniforms, so pipelines and
+    # targets are only cached per output size, channels and dtype. Returns the
+    # target and the number of channels to read back from it
+    unknown = set(transform) - {'crop', 'size', 'channels', 'flip', 'dtype', 'scale', 'bias'}
+    if unknown:
+        raise ValueError(f'[HyperGL] unknown transform keys {sorted(unknown)}')
+
+    width, height = image.size
+    crop = tuple(transform.get('crop') or (0, 0, width, height))
+    if len(crop) != 4 or crop[2] <= 0 or crop[3] <= 0:
+        raise ValueError('[HyperGL] the transform crop must be (x, y, width, height)')
+    size = tuple(transform.get('size') or crop[2:])
+    channels = transform.get('channels', 'rgba')
+    dtype = transform.get('dtype', 'uint8')
+    flip = bool(transform.get('flip', False))
+
+    if channels in ('gray', 'grayscale'):
+        color, count = 'vec4(dot(color.rgb, vec3(0.299, 0.587, 0.114)))', 1
+    elif channels and set(channels) <= set('rgba') and len(channels) in READ_TRANSFORM_FORMATS:
+        color, count = f'vec4(color.{channels}{", 0.0" * (4 - len(channels))})', len(channels)
+    else:
+        raise ValueError(f'[HyperGL] invalid transform channels "{channels}"')
+    if dtype not in READ_TRANSFORM_DTYPES:
+        raise ValueError(f'[HyperGL] invalid transform dtype "{dtype}"')
+
+    # Renderbuffers and multisampled images are resolved into a texture first
+    source = image
+    if image.renderbuffer or image.samples > 1:
+        source = cache.get('source')
+        if source is None:
+            source = cache.setdefault('source', ctx.image(image.size, image.format, texture=True))
+
+    key = (size, channels, dtype)
+    entry = cache.get(key)
+    if entry is None:
+        # Three channels render to rgba, the read back drops the alpha
+        target = ctx.image(size, READ_TRANSFORM_FORMATS[count] + READ_TRANSFORM_DTYPES[dtype])
+        pipeline = ctx.pipeline(
+            vertex_shader=textwrap.dedent('''
+                #version 330 core
+                vec2 positions[3] = vec2[](vec2(-1.0, -1.0), vec2(3.0, -1.0), vec2(-1.0, 3.0));
+                void main() {
+                    gl_Position = vec4(positions[gl_VertexID], 0.0, 1.0);
+                }
+            '''),
+            fragment_shader=textwrap.dedent(f'''
+                #version 330 core
+                uniform sampler2D Source;
+                uniform vec4 Crop;
+                uniform vec2 Normalize;
+                layout (location = 0) out vec4 out_color;
+                void main() {{
+                    vec2 uv = gl_FragCoord.xy / vec2({size[0]}.0, {size[1]}.0);
+                    vec4 color = texture(Source, Crop.xy + uv * Crop.zw);
+                    out_color = {color} * Normalize.x + Normalize.y;
+                }}
+            '''),
+            layout=[{'name': 'Source', 'binding': 0}],
+            resources=[{
+                'type': 'sampler',
+                'binding': 0,
+                'image': source,
+                'min_filter': 'linear',
+                'mag_filter': 'linear',
+                'wrap_x': 'clamp_to_edge',
+                'wrap_y': 'clamp_to_edge',
+            }],
+            uniforms={'Crop': [0.0, 0.0, 1.0, 1.0], 'Normalize': [1.0, 0.0]},
+            framebuffer=[target],
+            vertex_count=3,
+        )
+        entry = cache.setdefault(key, (pipeline, target))
+
+    pipeline, target = entry
+    if source is not image:
+        image.blit(source)
+    # Normalized crop origin and extent, a flip starts at the top and walks down
+    x, y, w, h = crop
+    if flip:
+        y, h = y + h, -h
+    pipeline.uniforms['Crop'][:] = struct.pack('4f', x / width, y / height, w / width, h / height)
+    pipeline.uniforms['Normalize'][:] = struct.pack('2f', transform.get('scale', 1.0), transform.get('bias', 0.0))
+    pipeline.render()
+    return target, count
+
+
+def vertex_streams(streams, resources):
+    # Vertex pulling: the streams are storage buffers the vertex shader indexes
+    # with gl_VertexID / gl_InstanceID, the pipeline gets no vertex attributes
+    items = streams.items() if isinstance(streams, dict) else enumerate(streams)
+    taken = {obj['binding'] for obj in resources if obj['type'] == 'storage_buffer'}
+    res = list(resources)
+    for binding, buffer in items:
+        if binding in taken:
+            raise ValueError(f'Vertex stream binding {binding} is already used by a storage buffer')
+        taken.add(binding)
+        res.append({'type': 'storage_buffer', 'binding': binding, 'buffer': buffer})
+    return res
+
+
 def resource_bindings(resources):
     uniform_buffers = []
     for obj in sorted((x for x in resources if x['type'] == 'uniform_buffer'), key=lambda x: x['binding']):
         binding = obj['binding']
-        buffer = obj['buffer']
-        offset = obj.get('offset', 0)
-        size = obj.get('size', buffer.size - offset)
-        if offset < 0 or size <= 0 or offset + size > buffer.size:
-            raise ValueError(f"Invalid buffer range: offset={offset}, size={size}, buffer.size={buffer.size}")
+        buffer, offset, size = buffer_range(obj['buffer'], obj.get('offset', 0), obj.get('size'))
         uniform_buffers.extend([binding, buffer, offset, size])
     samplers = []
     for obj in sorted((x for x in resources if x['type'] == 'sampler'), key=lambda x: x['binding']):
@@ -658,11 +1042,7 @@ def resource_bindings(resources):
     storage_buffers = []
     for obj in sorted((x for x in resources if x['type'] == 'storage_buffer'), key=lambda x: x['binding']):
         binding = obj['binding']
-        buffer = obj['buffer']
-        offset = obj.get('offset', 0)
-        size = obj.get('size', buffer.size - offset)
-        if offset < 0 or size <= 0 or offset + size > buffer.size:
-            raise ValueError(f"Invalid buffer range: offset={offset}, size={size}, buffer.size={buffer.size}")
+        buffer, offset, size = buffer_range(obj['buffer'], obj.get('offset', 0), obj.get('size'))
         storage_buffers.extend([binding, buffer, offset, size])
     return tuple(uniform_buffers), tuple(samplers), tuple(storage_buffers)
 
@@ -673,6 +1053,8 @@ def framebuffer_attachments(attachments):
     size = attachments[0].size
     samples = attachments[0].samples
     for attachment in attachments:
+        if not attachment.flags:
+            raise ValueError('The image format is not renderable')
         if attachment.size != size:
             raise ValueError('Attachments must be images with the same size')
         if attachment.samples != samples:
@@ -968,7 +1350,7 @@ def validate(interface, layout, resources, vertex_buffers, info):
 __all__ = [
     'loader', 'calcsize', 'bind', 'vertex_array_bindings', 'resource_bindings', 
     'framebuffer_attachments', 'settings', 'program', 'compile_error', 'linker_error', 
-    'uniforms', 'layout_bindings', 'validate'
+    'uniforms', 'layout_bindings', 'validate', 'upload_context'
 ]
 
 def _clean_exit():
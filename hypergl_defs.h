@@ -25,6 +25,16 @@
     #define UNUSED
 #endif
 
+// --- SIMD (float conversion on upload) ---
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define HYPERGL_F16C 1 // compiled per function, picked at runtime
+#elif defined(__aarch64__)
+    #include <arm_neon.h>
+    #define HYPERGL_NEON 1
+#endif
+
 // --- Integer Limits ---
 #ifdef UINT32_MAX
     #undef UINT32_MAX
@@ -107,6 +117,15 @@
 #define MIN_BUFFER_BINDINGS 8
 #define MAX_BUFFER_BINDINGS 8
 #define MAX_SAMPLER_BINDINGS 16
+#define MAX_ARRAY_DIMS 8
+
+// --- Deferred Deletion ---
+#define SHARED_TRASH_RESERVE 256        // ids parked inline when a node cannot be allocated
+#define TRASH_FLUSH_BATCH 256           // ids per glDelete* call
+#define TRASH_FLUSH_BUDGET 0.002        // seconds spent deleting per new_frame / end_frame
+
+// --- Render Thread ---
+#define RENDER_RING_CAPACITY 1024       // power of two
 
 // --- Platform Specifics & Atomic Macros ---
 #ifdef _WIN32
@@ -115,11 +134,39 @@
     #define Atomic_Decrement(ptr) InterlockedDecrement((volatile LONG*)(ptr))
     #define Atomic_Increment(ptr) InterlockedIncrement((volatile LONG*)(ptr))
     #define Atomic_Load(ptr) InterlockedCompareExchange((volatile LONG*)(ptr), 0, 0)
+    #define Atomic_LoadPtr(ptr) InterlockedCompareExchangePointer((PVOID volatile*)(ptr), NULL, NULL)
+    #define Atomic_ExchangePtr(ptr, val) InterlockedExchangePointer((PVOID volatile*)(ptr), (PVOID)(val))
+    // Returns the previous value, the swap happened if it equals `expected`
+    #define Atomic_CompareExchangePtr(ptr, expected, desired) \
+        InterlockedCompareExchangePointer((PVOID volatile*)(ptr), (PVOID)(desired), (PVOID)(expected))
+    #define Atomic_Load64(ptr) InterlockedCompareExchange64((volatile LONG64*)(ptr), 0, 0)
+    #define Atomic_Store64(ptr, val) InterlockedExchange64((volatile LONG64*)(ptr), (LONG64)(val))
+    #define Atomic_CompareExchange64(ptr, expected, desired) \
+        InterlockedCompareExchange64((volatile LONG64*)(ptr), (LONG64)(desired), (LONG64)(expected))
 #else
+    #include <errno.h>
+    #include <pthread.h>
+    #include <time.h>
     #define GL_API
     #define Atomic_Decrement(ptr) __atomic_sub_fetch(ptr, 1, __ATOMIC_SEQ_CST)
     #define Atomic_Increment(ptr) __atomic_add_fetch(ptr, 1, __ATOMIC_SEQ_CST)
     #define Atomic_Load(ptr) __atomic_load_n(ptr, __ATOMIC_SEQ_CST)
+    #define Atomic_LoadPtr(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+    #define Atomic_ExchangePtr(ptr, val) __atomic_exchange_n(ptr, val, __ATOMIC_ACQ_REL)
+    // Returns the previous value, the swap happened if it equals `expected`
+    #define Atomic_CompareExchangePtr(ptr, expected, desired) \
+        __sync_val_compare_and_swap(ptr, expected, desired)
+    #define Atomic_Load64(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+    #define Atomic_Store64(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+    #define Atomic_CompareExchange64(ptr, expected, desired) \
+        __sync_val_compare_and_swap(ptr, expected, desired)
+#endif
+
+// Built-in headless backend, libEGL is opened at runtime
+#if defined(__linux__) && !defined(EXTERN_GL)
+    #include <dlfcn.h>
+    #define HYPERGL_NATIVE_EGL 1
+    #define HYPERGL_NATIVE_OSMESA 1
 #endif
 
 // --- Macros ---
@@ -207,6 +254,7 @@ typedef struct ImageFormat
     int color;
     int clear_type;
     int flags;
+    int block; // block width and height of compressed formats, 1 otherwise
 } ImageFormat;
 
 typedef struct UniformBinding
@@ -264,7 +312,13 @@ typedef struct Limits
     int max_vertex_attribs;
     int max_draw_buffers;
     int max_samples;
+    int max_texture_size;
+    int max_cube_map_texture_size;
+    int max_renderbuffer_size;
+    int max_array_texture_layers;
     int max_shader_storage_buffer_bindings;
+    int uniform_buffer_offset_alignment;
+    int storage_buffer_offset_alignment;
 } Limits;
 
 typedef struct ModuleState
@@ -280,6 +334,7 @@ typedef struct ModuleState
     PyObject *str_BUFFER_ACCESS;
     PyObject *str_IMAGE_FORMAT;
     PyObject *str_VERTEX_FORMAT;
+    PyObject *str_data;
     PyObject *default_loader;
     PyObject *default_context;
     PyObject *HyperGLError;
@@ -293,10 +348,20 @@ typedef struct ModuleState
     PyTypeObject *DescriptorSet_type;
     PyTypeObject *GlobalSettings_type;
     PyTypeObject *GLObject_type;
-    Limits limits;
+    PyTypeObject *Encoder_type;
+    PyTypeObject *Fence_type;
+    PyTypeObject *HeadlessEGL_type;
+    PyTypeObject *OSMesa_type;
+    PyTypeObject *Heap_type;
+    PyTypeObject *MeshPool_type;
+    PyTypeObject *Mesh_type;
+    PyTypeObject *ImageStream_type;
+    PyTypeObject *FrameStack_type;
+    PyTypeObject *MappedArray_type;
     void *opengl_handle;
     void *(*wglGetProcAddress)(const char *);
     int gl_initialized;
+    volatile long independent_contexts; // live Context(loader=...) and friends
     PyMutex global_lock;
     PyMutex setup_lock;
 } ModuleState;
@@ -310,7 +375,9 @@ typedef enum {
     TRASH_PROGRAM       = 6,
     TRASH_SHADER        = 7,
     TRASH_SAMPLER       = 8,
-    TRASH_QUERY         = 9
+    TRASH_QUERY         = 9,
+    TRASH_SYNC          = 10,
+    TRASH_TYPE_COUNT
 } TrashType;
 
 typedef struct {
@@ -318,12 +385,22 @@ typedef struct {
     int type; 
 } TrashItem;
 
+// Node of the lock-free deletion stack, producers push with a CAS
+typedef struct TrashNode {
+    struct TrashNode *next;
+    void *sync;                 // TRASH_SYNC only, sync objects are pointers
+    int id;
+    int type;
+} TrashNode;
+
 typedef struct SharedTrash {
-    PyMutex lock;
-    TrashItem *bin;
-    size_t count;
-    size_t capacity;
+    TrashNode *volatile head;   // MPSC stack, any thread pushes, flush_trash takes it whole
+    TrashNode *pending;         // backlog left behind by a time-budgeted flush
+    PyMutex lock;               // guards pending and reserve (consumer side / OOM path only)
+    TrashItem reserve[SHARED_TRASH_RESERVE];
+    size_t reserve_count;
     volatile long ref_count;
+    volatile long leaked;       // names dropped with the reserve full, ctx.info
 } SharedTrash;
 
 typedef struct GLObject
@@ -339,8 +416,8 @@ typedef struct GLObject
 typedef struct BufferBinding
 {
     struct Buffer *buffer;
-    int offset;
-    int size;
+    Py_ssize_t offset;
+    Py_ssize_t size;
 } BufferBinding;
 
 typedef struct SamplerBinding
@@ -394,6 +471,71 @@ typedef struct GlobalSettings
     BlendState blend;
 } GlobalSettings;
 
+typedef enum {
+    ENCODER_WRITE = 1,          // Buffer.write
+    ENCODER_WRITE_IMAGE,        // Image.write
+    ENCODER_BLIT,               // Image.blit
+    ENCODER_RENDER,             // Pipeline.render
+    ENCODER_RENDER_INDIRECT,    // Pipeline.render_indirect
+    ENCODER_RUN,                // Compute.run
+    ENCODER_READ,               // Buffer.read / Image.read with `into`
+} EncoderOp;
+
+// A recorded call, replayed on the context thread
+typedef struct EncoderCommand {
+    int op;
+    PyObject *target;   // Buffer / Image / Pipeline / Compute
+    PyObject *args;     // tuple, client memory already copied
+    PyObject *kwargs;   // dict or NULL
+} EncoderCommand;
+
+// Commands handed over by Encoder.submit(), queued in submission order
+typedef struct EncoderBatch {
+    struct EncoderBatch *next;
+    EncoderCommand *commands;
+    int count;
+} EncoderBatch;
+
+typedef enum {
+    RENDER_OP_NEW_FRAME = 1,
+    RENDER_OP_END_FRAME,
+    RENDER_OP_FENCE,
+    RENDER_OP_CALL,
+    RENDER_OP_STOP,
+} RenderOpType;
+
+typedef struct RenderOp {
+    int op;
+    PyObject *args;     // call arguments, the Fence to signal, or a call
+    PyObject *kwargs;
+} RenderOp;
+
+// Single producer (the thread that started it), single consumer (the native
+// render thread). Indices grow forever, slots are `index & (CAPACITY - 1)`.
+// Parks threads until a watched counter changes, instead of polling it
+typedef struct WaitEvent {
+#ifdef _WIN32
+    SRWLOCK lock;
+    CONDITION_VARIABLE cond;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+} WaitEvent;
+
+typedef struct RenderRing {
+    RenderOp ops[RENDER_RING_CAPACITY];
+    volatile long long head;    // written by the producer
+    volatile long long tail;    // written by the render thread
+    unsigned long producer_id;
+    unsigned long thread_id;
+    volatile long long state;   // 0 starting, 1 running, -1 exited
+    PyObject *make_current;     // called on the render thread at startup
+    PyObject *release_current;  // called on the render thread before it exits
+    PyObject *volatile error;   // first exception raised on the render thread
+    WaitEvent event;            // head, tail and state changes
+} RenderRing;
+
 typedef struct GLStateShadow {
     int8_t cull_face;
     int8_t depth_test;
@@ -418,11 +560,17 @@ typedef struct Context
     PyObject *program_cache;
     PyObject *shader_cache;
     PyObject *includes;
+    PyObject *resolve_pool; // (width, height, format) -> single sampled Image
     GLObject *default_framebuffer;
     DescriptorSet *current_descriptor_set;
     GlobalSettings *current_global_settings;
     PyObject *info_dict;
     SharedTrash *trash_shared;
+    PyMutex encoder_lock;
+    EncoderBatch *encoder_head;
+    EncoderBatch *encoder_tail;
+    RenderRing *render_ring;
+    volatile long long upload_thread_id; // thread holding the shared upload context
     int current_read_framebuffer;
     int current_draw_framebuffer;
     int current_program;
@@ -443,6 +591,9 @@ typedef struct Context
     unsigned int padding_bits         : 5;
 
     unsigned long thread_id; 
+
+    PyObject *loader;           // owned by independent contexts, NULL for the default one
+    Limits limits;
     
     GLStateShadow gl_state;
     Viewport current_viewport;
@@ -454,14 +605,87 @@ typedef struct Buffer
     Context *ctx;
     int buffer;
     int target;
-    int size;
+    Py_ssize_t size;
     int access;
+    int immutable; // glBufferStorage or external, cannot be orphaned
+    int map_access; // glMapBufferRange flags of mapped= buffers, 0 otherwise
     int is_persistently_mapped;
     // int gpu_dirty; // TODO: implement this across every single GPU call
     void *mapped_ptr;
     PyObject *memoryview;
 } Buffer;
 
+// DLPack (dlpack.h, ABI v0.8), the unversioned tensor every consumer accepts
+typedef struct DLDevice
+{
+    int32_t device_type;
+    int32_t device_id;
+} DLDevice;
+
+typedef struct DLDataType
+{
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+} DLDataType;
+
+typedef struct DLTensor
+{
+    void *data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t *shape;
+    int64_t *strides;
+    uint64_t byte_offset;
+} DLTensor;
+
+typedef struct DLManagedTensor
+{
+    DLTensor dl_tensor;
+    void *manager_ctx;
+    void (*deleter)(struct DLManagedTensor *self);
+} DLManagedTensor;
+
+// DLPack 1.0, handed to consumers that pass max_version >= (1, 0)
+typedef struct DLPackVersion
+{
+    uint32_t major;
+    uint32_t minor;
+} DLPackVersion;
+
+typedef struct DLManagedTensorVersioned
+{
+    DLPackVersion version;
+    void *manager_ctx;
+    void (*deleter)(struct DLManagedTensorVersioned *self);
+    uint64_t flags;
+    DLTensor dl_tensor;
+} DLManagedTensorVersioned;
+
+#define DLPACK_CPU 1
+#define DLPACK_FLAG_BITMASK_READ_ONLY (1ULL << 0)
+
+// A typed, shaped window over a mapped buffer
+typedef struct MappedArray
+{
+    PyObject_HEAD
+    PyObject *buffer;
+    PyObject *memoryview; // the map() view, unmap() refuses while it is held
+    char *data;
+    Py_ssize_t nbytes;
+    Py_ssize_t itemsize;
+    int readonly;
+    int ndim;
+    const char *format;   // struct module code
+    const char *typestr;  // __array_interface__ code
+    DLDataType dl_dtype;
+    Py_ssize_t shape[MAX_ARRAY_DIMS];
+    Py_ssize_t strides[MAX_ARRAY_DIMS];
+    int64_t dl_shape[MAX_ARRAY_DIMS];
+    int64_t dl_strides[MAX_ARRAY_DIMS];
+} MappedArray;
+
 typedef struct Image
 {
     PyObject_HEAD
@@ -470,6 +694,7 @@ typedef struct Image
     PyObject *format;
     PyObject *faces;
     PyObject *layers;
+    PyObject *transforms; // read(transform=...) passes, built on first use
     
     PyMutex state_lock;
     
@@ -496,6 +721,39 @@ typedef struct Image
     int is_resident;
 } Image;
 
+// Progressive tiled upload of one image level from a mapped source
+typedef struct ImageStream
+{
+    PyObject_HEAD
+    Image *image;
+    PyObject *source;
+    Py_buffer view; // released once every tile is uploaded
+    Py_ssize_t offset;
+    Py_ssize_t budget;
+    int target;
+    int level;
+    int layer;
+    int width;
+    int height;
+    int tile_width;
+    int tile_height;
+    int tiles_x;
+    int tile_count;
+    int next_tile;
+} ImageStream;
+
+// Ring of the last renders of an image, one array layer per frame
+typedef struct FrameStack
+{
+    PyObject_HEAD
+    Context *ctx;
+    Image *source;
+    Image *image;
+    int size;
+    int index; // layer the next push() writes, the oldest frame once full
+    int filled;
+} FrameStack;
+
 typedef struct RenderParameters
 {
     int vertex_count;
@@ -527,6 +785,7 @@ typedef struct Pipeline
     int topology;
     int index_type;
     int index_size;
+    intptr index_offset; // byte offset of an index buffer view
 } Pipeline;
 
 typedef struct Compute
@@ -574,10 +833,115 @@ typedef struct ImageFace
 typedef struct BufferView
 {
     PyObject_HEAD Buffer *buffer;
-    int offset;
-    int size;
+    Py_ssize_t offset;
+    Py_ssize_t size;
+    struct Heap *heap; // set while the range is allocated from a heap
 } BufferView;
 
+// One GL buffer of a heap and its buddy tree. longest[i] is the order + 1 of
+// the largest free block below node i, 0 when nothing is free there.
+typedef struct HeapChunk
+{
+    Buffer *buffer;
+    unsigned char *longest;
+} HeapChunk;
+
+// Sub-allocates BufferViews from a few large buffers of one kind
+typedef struct Heap
+{
+    PyObject_HEAD
+    Context *ctx;
+    PyMutex lock;
+    PyObject *kind;
+    HeapChunk *chunks;
+    int chunk_count;
+    int max_order; // chunk size is block << max_order
+    Py_ssize_t block;
+    Py_ssize_t used;
+} Heap;
+
+typedef struct PoolRange
+{
+    Py_ssize_t start;
+    Py_ssize_t count;
+} PoolRange;
+
+// Sorted, coalesced free ranges, first fit
+typedef struct RangeAllocator
+{
+    PoolRange *ranges;
+    int count;
+    int capacity;
+} RangeAllocator;
+
+// Meshes sharing one vertex and one index buffer, drawn through one VAO
+typedef struct MeshPool
+{
+    PyObject_HEAD
+    Context *ctx;
+    PyMutex lock;
+    Buffer *vertex_buffer;
+    Buffer *index_buffer;
+    RangeAllocator vertices;
+    RangeAllocator indices;
+    Py_ssize_t vertex_capacity;
+    Py_ssize_t index_capacity;
+    Py_ssize_t vertices_used;
+    Py_ssize_t indices_used;
+    int stride;
+    int index_size;
+} MeshPool;
+
+typedef struct Mesh
+{
+    PyObject_HEAD
+    MeshPool *pool; // NULL once freed
+    Py_ssize_t first_index;
+    Py_ssize_t index_count;
+    Py_ssize_t base_vertex;
+    Py_ssize_t vertex_count;
+} Mesh;
+
+// A surfaceless EGL context created in C, doubles as the loader
+typedef struct HeadlessEGL
+{
+    PyObject_HEAD
+    void *display;
+    void *context;
+    int major;
+    int minor;
+} HeadlessEGL;
+
+// Software context whose default framebuffer is caller owned memory
+typedef struct OSMesa
+{
+    PyObject_HEAD
+    void *context;
+    Py_buffer target;
+    int width;
+    int height;
+    int type;
+} OSMesa;
+
+typedef struct Fence
+{
+    PyObject_HEAD
+    volatile long long signaled;
+    void *sync;                 // GLsync issued on the upload thread
+    SharedTrash *trash;         // where an unwaited sync is deleted
+    WaitEvent event;            // notified when signaled is set
+} Fence;
+
+typedef struct Encoder
+{
+    PyObject_HEAD
+    Context *ctx;
+    PyMutex lock;
+    EncoderCommand *commands;
+    int count;
+    int capacity;
+} Encoder;
+
 #pragma pack(push, 1)
 
 typedef struct {
@@ -609,8 +973,12 @@ typedef struct {
 #define GL_STENCIL_TEST 0x0B90
 #define GL_BLEND 0x0BE2
 #define GL_TEXTURE_2D 0x0DE1
+#define GL_UNSIGNED_BYTE 0x1401
 #define GL_UNSIGNED_SHORT 0x1403
 #define GL_UNSIGNED_INT 0x1405
+#define GL_FLOAT 0x1406
+#define GL_HALF_FLOAT 0x140B
+#define GL_RGB 0x1907
 #define GL_DEPTH 0x1801
 #define GL_STENCIL 0x1802
 #define GL_VENDOR 0x1F00
@@ -657,6 +1025,10 @@ typedef struct {
 #define GL_STENCIL_ATTACHMENT 0x8D20
 #define GL_RENDERBUFFER 0x8D41
 #define GL_MAX_SAMPLES 0x8D57
+#define GL_MAX_TEXTURE_SIZE 0x0D33
+#define GL_MAX_CUBE_MAP_TEXTURE_SIZE 0x851C
+#define GL_MAX_RENDERBUFFER_SIZE 0x84E8
+#define GL_MAX_ARRAY_TEXTURE_LAYERS 0x88FF
 #define GL_COPY_READ_BUFFER 0x8F36
 #define GL_COPY_WRITE_BUFFER 0x8F37
 #define GL_UNIFORM_BUFFER 0x8A11
@@ -679,6 +1051,7 @@ typedef struct {
 #define GL_SHADER_STORAGE_BARRIER_BIT 0x2000
 #define GL_MAP_READ_BIT 0x0001
 #define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
 #define GL_MAP_PERSISTENT_BIT 0x0040
 #define GL_MAP_COHERENT_BIT 0x0080
 #define GL_DYNAMIC_STORAGE_BIT 0x0100
@@ -686,6 +1059,40 @@ typedef struct {
 #define GL_PERSISTENT_WRITE_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
 #define GL_STORAGE_FLAGS (GL_PERSISTENT_WRITE_FLAGS | GL_DYNAMIC_STORAGE_BIT | GL_CLIENT_STORAGE_BIT)
 #define GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS 0x90DE
+#define GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT 0x90DF
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+
+// --- EGL (built-in headless backend) ---
+#define EGL_EXTENSIONS 0x3055
+#define EGL_NONE 0x3038
+#define EGL_SURFACE_TYPE 0x3033
+#define EGL_PBUFFER_BIT 0x0001
+#define EGL_RENDERABLE_TYPE 0x3040
+#define EGL_OPENGL_BIT 0x0008
+#define EGL_OPENGL_API 0x30A2
+#define EGL_CONTEXT_MAJOR_VERSION 0x3098
+#define EGL_CONTEXT_MINOR_VERSION 0x30FB
+#define EGL_CONTEXT_OPENGL_PROFILE_MASK 0x30FD
+#define EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT 0x0001
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#define EGL_PLATFORM_DEVICE_EXT 0x313F
+#define EGL_MAX_DEVICES 16
+
+#define OSMESA_RGBA 0x1908
+#define OSMESA_FORMAT 0x22
+#define OSMESA_DEPTH_BITS 0x30
+#define OSMESA_STENCIL_BITS 0x31
+#define OSMESA_ACCUM_BITS 0x32
+#define OSMESA_PROFILE 0x33
+#define OSMESA_CORE_PROFILE 0x34
+#define OSMESA_CONTEXT_MAJOR_VERSION 0x36
+#define OSMESA_CONTEXT_MINOR_VERSION 0x37
 #define GL_ACTIVE_ATTRIBUTE_MAX_LENGTH  0x8B8A
 #define GL_ACTIVE_UNIFORM_MAX_LENGTH    0x8B87
 #define GL_UNIFORM_BLOCK_INDEX          0x8A3A
@@ -712,6 +1119,7 @@ typedef struct {
 #define GL_DRAW_INDIRECT_BUFFER 0x8F3F
 #define GL_PARAMETER_BUFFER_ARB 0x80EE 
 #define GL_COMMAND_BARRIER_BIT 0x00000040
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT 0x00004000
 
 #define GL_MIN_UNIFORM_BUFFER_BINDINGS 8
 #define GL_ENGINE_MAX_VERTEX_ATTRIBS 64
@@ -719,6 +1127,10 @@ typedef struct {
 #define GL_MAX_UBO_SIZE 0x40000000
 #define HGL_MIN_SAMPLES 1
 #define HGL_MAX_SAMPLES 16
+#define HGL_MIN_TEXTURE_SIZE 1024
+#define HGL_MAX_TEXTURE_SIZE 65536
+#define HGL_MIN_ARRAY_LAYERS 256
+#define HGL_MAX_ARRAY_LAYERS 65536
 
 #ifndef GLboolean
 typedef unsigned char GLboolean;
@@ -816,12 +1228,12 @@ typedef enum ImageFormatTupleIndex {
     IF_COLOR,
     IF_FLAGS,
     IF_CLEAR_TYPE,
-    IF_TUPLE_SIZE
+    IF_TUPLE_SIZE,
+    IF_BLOCK = IF_TUPLE_SIZE, // optional, compressed formats only
 } ImageFormatTupleIndex;
 
 // MISC defs
 
-#define SHARED_TRASH_INITIAL_CAPACITY 4096
 
 #define CONTEXT_INFO_FORMAT "{szszszszsisisisisisisi}"
 
@@ -76,6 +76,7 @@ if sys.platform == 'win32':
 
 elif sys.platform.startswith('linux'):
     extra_compile_args += ['-std=c11', '-O3', '-fPIC']
+    libraries += ['dl']  # libEGL is opened at runtime by the headless backend
 elif sys.platform.startswith('darwin'):
     extra_compile_args += ['-Wno-writable-strings', '-std=c11']
     extra_link_args += ['-framework', 'OpenGL', '-framework', 'CoreFoundation']